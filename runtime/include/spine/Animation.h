@@ -54,6 +54,8 @@ namespace spine {
 
 		friend class AnimationStateData;
 
+		friend class AnimationOptimizer;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
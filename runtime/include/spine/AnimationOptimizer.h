@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AnimationOptimizer_h
+#define Spine_AnimationOptimizer_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Animation;
+
+	class SkeletonData;
+
+	class CurveTimeline;
+
+	class DeformTimeline;
+
+	/// Removes redundant keys from the curve timelines of loaded animations. Works on SkeletonData read by either SkeletonJson or
+	/// SkeletonBinary.
+	///
+	/// A key is removed when it lies between two linear segments and linear interpolation between its neighbours reproduces
+	/// it within the tolerance for its property. As the original and reduced curves are both piecewise linear, the error between
+	/// them never exceeds the tolerance at any time. Timelines whose value never changes are collapsed to a single key, which the
+	/// animation still applies every frame. Each reduced timeline is then sampled against its original keys and restored if they
+	/// differ by more than the tolerance anywhere, see setValidate().
+	/// IK, deform, attachment, draw order, event and sequence timelines are left untouched, except that deform timelines can
+	/// optionally be moved to compact storage, see setCompactDeformTimelines().
+	class SP_API AnimationOptimizer : public SpineObject {
+	public:
+		AnimationOptimizer();
+
+		/// Optimizes every animation in the skeleton data. Statistics are reset first.
+		void optimize(SkeletonData &skeletonData);
+
+		/// Optimizes a single animation of the skeleton data. Statistics accumulate.
+		void optimize(SkeletonData &skeletonData, Animation &animation);
+
+		/// Tolerance in degrees for rotate timelines. Default is 0.01.
+		void setRotateTolerance(float inValue) { _rotateTolerance = inValue; }
+		float getRotateTolerance() { return _rotateTolerance; }
+
+		/// Tolerance in skeleton units for translate and path position/spacing timelines. Default is 0.01.
+		void setTranslateTolerance(float inValue) { _translateTolerance = inValue; }
+		float getTranslateTolerance() { return _translateTolerance; }
+
+		/// Tolerance for scale timelines, relative to the setup scale. Default is 0.0001.
+		void setScaleTolerance(float inValue) { _scaleTolerance = inValue; }
+		float getScaleTolerance() { return _scaleTolerance; }
+
+		/// Tolerance in degrees for shear timelines. Default is 0.01.
+		void setShearTolerance(float inValue) { _shearTolerance = inValue; }
+		float getShearTolerance() { return _shearTolerance; }
+
+		/// Tolerance per color channel, in [0, 1]. Default is half of one 8 bit step.
+		void setColorTolerance(float inValue) { _colorTolerance = inValue; }
+		float getColorTolerance() { return _colorTolerance; }
+
+		/// Tolerance for transform and path constraint mixes. Default is 0.0001.
+		void setMixTolerance(float inValue) { _mixTolerance = inValue; }
+		float getMixTolerance() { return _mixTolerance; }
+
+		/// If true, constant timelines that key the setup pose are removed instead of collapsed. This covers the bone, slot
+		/// color, transform constraint and path constraint timelines the optimizer reduces; IK and deform timelines are never
+		/// removed. The animation then no longer keys those properties, which changes the result when it is layered over
+		/// animations on lower tracks. Default is false.
+		void setRemoveSetupPoseTimelines(bool inValue) { _removeSetupPoseTimelines = inValue; }
+		bool getRemoveSetupPoseTimelines() { return _removeSetupPoseTimelines; }
+
+		/// If true, the vertices of deform timelines are moved to one contiguous buffer per timeline, quantized to 16 bits per
+		/// value when that keeps the error within the deform tolerance. Default is false.
+		void setCompactDeformTimelines(bool inValue) { _compactDeformTimelines = inValue; }
+		bool getCompactDeformTimelines() { return _compactDeformTimelines; }
+
+		/// Tolerance in skeleton units for quantized deform timelines. Default is 0.01.
+		void setDeformTolerance(float inValue) { _deformTolerance = inValue; }
+		float getDeformTolerance() { return _deformTolerance; }
+
+		/// If true, each reduced timeline is sampled at its original keys and at points between them, including along bezier
+		/// curves, and compared to the same samples taken before the reduction. A timeline differing by more than its tolerance
+		/// gets its original keys back. Default is true.
+		void setValidate(bool inValue) { _validate = inValue; }
+		bool getValidate() { return _validate; }
+
+		size_t getFramesRemoved() { return _framesRemoved; }
+
+		/// Constant timelines reduced to a single key. They stay in the animation and are still applied every frame.
+		size_t getTimelinesCollapsed() { return _timelinesCollapsed; }
+
+		/// Timelines removed from their animation because they only keyed the setup pose, see setRemoveSetupPoseTimelines().
+		size_t getTimelinesRemoved() { return _timelinesRemoved; }
+
+		size_t getTimelinesQuantized() { return _timelinesQuantized; }
+
+		/// Timelines whose reduction failed validation and which kept their original keys.
+		size_t getTimelinesRestored() { return _timelinesRestored; }
+
+		/// The largest difference validation found in a reduced timeline that was kept, as a fraction of the timeline's tolerance.
+		float getMaxError() { return _maxError; }
+
+		/// Bytes of frame and curve data released.
+		size_t getBytesSaved() { return _bytesSaved; }
+
+		void resetStatistics();
+
+	private:
+		float _rotateTolerance;
+		float _translateTolerance;
+		float _scaleTolerance;
+		float _shearTolerance;
+		float _colorTolerance;
+		float _mixTolerance;
+		bool _removeSetupPoseTimelines;
+		bool _compactDeformTimelines;
+		float _deformTolerance;
+		bool _validate;
+
+		size_t _framesRemoved;
+		size_t _timelinesCollapsed;
+		size_t _timelinesRemoved;
+		size_t _timelinesQuantized;
+		size_t _timelinesRestored;
+		size_t _bytesSaved;
+		float _maxError;
+
+		Vector<bool> _keep;
+		Vector<float> _scratch;
+		Vector<float> _originalFrames;
+		Vector<float> _originalCurves;
+		Vector<float> _sampleTimes;
+		Vector<float> _samples;
+
+		float getTolerance(CurveTimeline &timeline);
+
+		bool isConstant(CurveTimeline &timeline, float tolerance);
+
+		bool isSetupPose(SkeletonData &skeletonData, CurveTimeline &timeline, float tolerance);
+
+		void markRemovableFrames(CurveTimeline &timeline, float tolerance);
+
+		void compact(CurveTimeline &timeline);
+
+		void saveOriginal(CurveTimeline &timeline);
+
+		bool matchesOriginal(CurveTimeline &timeline, float tolerance);
+
+		void restoreOriginal(CurveTimeline &timeline);
+
+		float sample(CurveTimeline &timeline, float time, size_t value);
+
+		void compact(DeformTimeline &timeline);
+	};
+}
+
+#endif /* Spine_AnimationOptimizer_h */
@@ -290,8 +290,11 @@ namespace spine {
 		Vector<float> _timelinesRotation;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
+		AnimationState *_state;
 
 		void reset();
+
+		void changed();
 	};
 
 	class SP_API EventQueueEntry : public SpineObject {
@@ -432,6 +435,11 @@ namespace spine {
 
         bool getManualTrackEntryDisposal();
 
+		/// Incremented whenever applying this state could pose a skeleton differently than the last time: when update()
+		/// advances time, animations are set, queued or cleared and track entry properties are changed. While it and the
+		/// skeleton's Skeleton::getPoseVersion() are unchanged, apply() can be skipped.
+		unsigned int getVersion();
+
 		void disposeTrackEntry(TrackEntry *entry);
 
 	private:
@@ -463,6 +471,8 @@ namespace spine {
 
 		bool _manualTrackEntryDisposal;
 
+		unsigned int _version;
+
 		static Animation *getEmptyAnimation();
 
 		static void
@@ -495,7 +505,8 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
-		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
+		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, int attachmentNameId,
+						   bool attachments);
 	};
 }
 
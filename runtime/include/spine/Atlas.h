@@ -118,11 +118,22 @@ namespace spine {
 
 		void flipV();
 
-		/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-		/// should be cached rather than calling this method multiple times.
+		/// Returns the first region found with the specified name. Regions are looked up through a hash index built when the atlas
+		/// is loaded, which is rebuilt when the storage or size of getRegions() changes. A name the index misses is searched for
+		/// in every region, so regions replaced or renamed in place are still found and the index is rebuilt.
 		/// @return The region, or NULL.
 		AtlasRegion *findRegion(const String &name);
 
+		/// Loads the texture of a page whose texture was not created when the atlas was loaded, see createTexture. Does nothing if
+		/// the page already has a texture.
+		void loadTexture(AtlasPage &page);
+
+		/// If true, AtlasAttachmentLoader calls loadTexture() for the page of every region it resolves, so an atlas created with
+		/// createTexture = false only loads the pages referenced by attachments in the loaded skins. Default is false.
+		void setLoadTexturesOnDemand(bool loadTexturesOnDemand);
+
+		bool getLoadTexturesOnDemand();
+
 		Vector<AtlasPage *> &getPages();
 
 		Vector<AtlasRegion *> &getRegions();
@@ -131,8 +142,16 @@ namespace spine {
 		Vector<AtlasPage *> _pages;
 		Vector<AtlasRegion *> _regions;
 		TextureLoader *_textureLoader;
+		bool _loadTexturesOnDemand;
+
+		/// Open addressing table of indices into _regions, -1 for empty slots. Its size is a power of two.
+		Vector<int> _regionIndex;
+		AtlasRegion **_indexedBuffer;
+		size_t _indexedRegions;
 
 		void load(const char *begin, int length, const char *dir, bool createTexture);
+
+		void buildRegionIndex();
 	};
 }
 
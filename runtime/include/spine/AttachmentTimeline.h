@@ -41,6 +41,8 @@ namespace spine {
 
 	class Skeleton;
 
+	class SkeletonData;
+
 	class Slot;
 
 	class Event;
@@ -50,6 +52,8 @@ namespace spine {
 
 		friend class SkeletonJson;
 
+		friend class SkeletonData;
+
 	RTTI_DECL
 
 	public:
@@ -64,8 +68,14 @@ namespace spine {
 		/// Sets the time and value of the specified keyframe.
 		void setFrame(int frame, float time, const String &attachmentName);
 
+		/// SkeletonData::internAttachmentNames() must be called after the names are changed other than with setFrame(), or
+		/// the old names are used.
 		Vector<String> &getAttachmentNames();
 
+		/// Returns the id of the frame's attachment name in the skeleton data, see SkeletonData::internAttachmentNames(). -1 if
+		/// the frame has no attachment, -2 if the name has no id for the skeleton data.
+		int getAttachmentNameId(SkeletonData *skeletonData, int frame);
+
 		int getSlotIndex() { return _slotIndex; }
 
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
@@ -74,8 +84,10 @@ namespace spine {
 		int _slotIndex;
 
 		Vector<String> _attachmentNames;
+		Vector<int> _attachmentNameIds;
+		SkeletonData *_attachmentNameData;
 
-		void setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName);
+		void setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName, int attachmentNameId);
 	};
 }
 
@@ -59,6 +59,10 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class SkeletonBounds;
+
+		friend class SkeletonBroadphase;
+
 		friend class RegionAttachment;
 
 		friend class PointAttachment;
@@ -253,9 +257,16 @@ namespace spine {
 
 		void setActive(bool inValue);
 
+		/// Incremented when Skeleton::updateWorldTransform() changes the world transform, or when a world transform setter or
+		/// rotateWorld() is called. World vertices computed for this bone remain valid while the version is unchanged.
+		unsigned int getWorldVersion();
+
 	private:
 		static bool yDown;
 
+		/// Increments the world version if the world transform differs from the last one seen.
+		void updateWorldVersion();
+
 		BoneData &_data;
 		Skeleton &_skeleton;
 		Bone *_parent;
@@ -264,6 +275,9 @@ namespace spine {
 		float _ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY;
 		float _a, _b, _worldX;
 		float _c, _d, _worldY;
+		float _lastA, _lastB, _lastWorldX;
+		float _lastC, _lastD, _lastWorldY;
+		unsigned int _worldVersion;
 		bool _sorted;
 		bool _active;
 	};
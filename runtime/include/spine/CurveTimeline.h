@@ -36,6 +36,10 @@
 namespace spine {
 	/// Base class for frames that use an interpolation bezier curve.
 	class SP_API CurveTimeline : public Timeline {
+		friend class AnimationOptimizer;
+
+		friend class SkeletonBinaryWriter;
+
 	RTTI_DECL
 
 	public:
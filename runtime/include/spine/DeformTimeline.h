@@ -52,8 +52,31 @@ namespace spine {
 		/// Sets the time and value of the specified keyframe.
 		void setFrame(int frameIndex, float time, Vector<float> &vertices);
 
+		/// The vertices of each frame. Empty once the timeline has been compacted.
 		Vector <Vector<float>> &getVertices();
 
+		/// The number of deform values in each frame.
+		size_t getVertexCount();
+
+		/// Copies the vertices of a frame into the array, decoding compact storage if needed.
+		void getFrameVertices(size_t frame, Vector<float> &vertices);
+
+		/// Moves the vertices of all frames into one contiguous buffer. Only the values from the first to the last that differ
+		/// from the setup pose are stored for each frame, so applying the timeline additively skips the rest. If quantize is
+		/// true, the values are further stored as 16 bits each, quantized over the range of all stored values in the timeline,
+		/// see getQuantizationError(). The frames can no longer be changed afterwards.
+		void compact(bool quantize);
+
+		bool isCompact();
+
+		bool isQuantized();
+
+		/// The maximum absolute error introduced by quantization, 0 if the timeline is not quantized.
+		float getQuantizationError();
+
+		/// Bytes used to store the vertices of all frames.
+		size_t getVerticesMemory();
+
 		VertexAttachment *getAttachment();
 
 		void setAttachment(VertexAttachment *inValue);
@@ -73,7 +96,23 @@ namespace spine {
 
 		Vector <Vector<float>> _vertices;
 
+		// Compact storage, see compact(). Frame i stores the values from _frameStarts[i], beginning at _frameOffsets[i].
+		size_t _frameVertexCount;
+		Vector<size_t> _frameStarts;
+		Vector<size_t> _frameOffsets;
+		Vector<float> _flatVertices;
+		Vector<unsigned short> _quantizedVertices;
+		float _quantizeOffset;
+		float _quantizeScale;
+
 		VertexAttachment *_attachment;
+
+		/// Returns the vertices of a frame if all of them are stored as floats, else NULL.
+		const float *getDenseFrame(size_t frame);
+
+		/// Writes count vertices of a compact frame beginning at the specified vertex. Values that are not stored are taken
+		/// from base, or are 0 if base is NULL.
+		void decodeFrame(size_t frame, size_t start, size_t count, const float *base, float *vertices);
 	};
 }
 
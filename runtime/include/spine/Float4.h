@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_Float4_h
+#define Spine_Float4_h
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPINE_FLOAT4_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPINE_FLOAT4_NEON
+#endif
+
+namespace spine {
+	/// Four floats processed at once, used by the runtime's vectorized loops. Uses SSE2 or NEON when the target has them, else
+	/// plain floats. Each lane performs the same operations as scalar code, so results are bit identical to it. The instruction
+	/// set is chosen at compile time: there is no runtime dispatch to wider units such as AVX2, as the runtime has no CPU
+	/// feature detection.
+#if defined(SPINE_FLOAT4_SSE)
+	struct Float4 {
+		__m128 v;
+
+		explicit Float4(__m128 v) : v(v) {}
+	};
+
+	inline Float4 load4(const float *values) { return Float4(_mm_loadu_ps(values)); }
+
+	inline Float4 set4(float a, float b, float c, float d) { return Float4(_mm_setr_ps(a, b, c, d)); }
+
+	inline Float4 splat4(float value) { return Float4(_mm_set1_ps(value)); }
+
+	inline void store4(float *values, Float4 value) { _mm_storeu_ps(values, value.v); }
+
+	inline Float4 operator+(Float4 a, Float4 b) { return Float4(_mm_add_ps(a.v, b.v)); }
+
+	inline Float4 operator-(Float4 a, Float4 b) { return Float4(_mm_sub_ps(a.v, b.v)); }
+
+	inline Float4 operator*(Float4 a, Float4 b) { return Float4(_mm_mul_ps(a.v, b.v)); }
+#elif defined(SPINE_FLOAT4_NEON)
+	struct Float4 {
+		float32x4_t v;
+
+		explicit Float4(float32x4_t v) : v(v) {}
+	};
+
+	inline Float4 load4(const float *values) { return Float4(vld1q_f32(values)); }
+
+	inline Float4 set4(float a, float b, float c, float d) {
+		float values[4] = {a, b, c, d};
+		return Float4(vld1q_f32(values));
+	}
+
+	inline Float4 splat4(float value) { return Float4(vdupq_n_f32(value)); }
+
+	inline void store4(float *values, Float4 value) { vst1q_f32(values, value.v); }
+
+	inline Float4 operator+(Float4 a, Float4 b) { return Float4(vaddq_f32(a.v, b.v)); }
+
+	inline Float4 operator-(Float4 a, Float4 b) { return Float4(vsubq_f32(a.v, b.v)); }
+
+	inline Float4 operator*(Float4 a, Float4 b) { return Float4(vmulq_f32(a.v, b.v)); }
+#else
+	struct Float4 {
+		float v[4];
+	};
+
+	inline Float4 load4(const float *values) {
+		Float4 result = {{values[0], values[1], values[2], values[3]}};
+		return result;
+	}
+
+	inline Float4 set4(float a, float b, float c, float d) {
+		Float4 result = {{a, b, c, d}};
+		return result;
+	}
+
+	inline Float4 splat4(float value) { return set4(value, value, value, value); }
+
+	inline void store4(float *values, Float4 value) {
+		for (int i = 0; i < 4; i++) values[i] = value.v[i];
+	}
+
+	inline Float4 operator+(Float4 a, Float4 b) {
+		for (int i = 0; i < 4; i++) a.v[i] += b.v[i];
+		return a;
+	}
+
+	inline Float4 operator-(Float4 a, Float4 b) {
+		for (int i = 0; i < 4; i++) a.v[i] -= b.v[i];
+		return a;
+	}
+
+	inline Float4 operator*(Float4 a, Float4 b) {
+		for (int i = 0; i < 4; i++) a.v[i] *= b.v[i];
+		return a;
+	}
+#endif
+}
+
+#endif /* Spine_Float4_h */
@@ -102,6 +102,7 @@ namespace spine {
 
 	private:
 		IkConstraintData &_data;
+		Skeleton &_skeleton;
 		Vector<Bone *> _bones;
 		int _bendDirection;
 		bool _compress;
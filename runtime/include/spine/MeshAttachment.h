@@ -46,6 +46,8 @@ namespace spine {
 
 		friend class AtlasAttachmentLoader;
 
+		friend class MeshOptimizer;
+
 	RTTI_DECL
 
 	public:
@@ -58,6 +60,8 @@ namespace spine {
 		virtual void computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 		size_t stride = 2);
 
+		/// Computes the UVs from the region UVs and the region. With a sequence, the UVs are computed for every frame of the
+		/// sequence, and the setup frame is used for the region and UVs of the attachment itself.
 		void updateRegion();
 
 		int getHullLength();
@@ -69,6 +73,9 @@ namespace spine {
 		/// The UV pair for each vertex, normalized within the entire texture. See also MeshAttachment::updateRegion
 		Vector<float> &getUVs();
 
+		/// The UVs of the sequence frame the slot shows, or the attachment's UVs if it has no sequence.
+		float *getUVs(Slot &slot);
+
 		Vector<unsigned short> &getTriangles();
 
 		Color &getColor();
@@ -81,6 +88,9 @@ namespace spine {
 
 		void setRegion(TextureRegion *region);
 
+		/// The region of the sequence frame the slot shows, or the attachment's region if it has no sequence.
+		TextureRegion *getRegion(Slot &slot);
+
 		Sequence *getSequence();
 
 		void setSequence(Sequence *sequence);
@@ -104,9 +114,21 @@ namespace spine {
 
 		MeshAttachment *newLinkedMesh();
 
+		/// Versions of this mesh with fewer vertices, from the most to the least detailed, see MeshOptimizer. They are drawn in
+		/// place of this mesh and are owned by it.
+		Vector<MeshAttachment *> &getLods();
+
+		/// For a level of detail, the largest distance in the setup pose between its vertices and the full mesh, in skeleton
+		/// units. 0 for meshes that are not a level of detail.
+		float getLodError();
+
+		/// Returns the least detailed level whose error does not exceed maxError, or this mesh if there is none.
+		MeshAttachment *getLod(float maxError);
+
 	private:
 		MeshAttachment *_parentMesh;
 		Vector<float> _uvs;
+		Vector<float> _sequenceUVs;
 		Vector<float> _regionUVs;
 		Vector<unsigned short> _triangles;
 		Vector<unsigned short> _edges;
@@ -116,6 +138,14 @@ namespace spine {
 		int _width, _height;
 		TextureRegion *_region;
 		Sequence *_sequence;
+		Vector<MeshAttachment *> _lods;
+		float _lodError;
+		Vector<int> _lodDeform; // for a level of detail, the index of each deform value in the full mesh's deform
+
+		void computeUVs(TextureRegion *region, float *uvs);
+
+		/// Adds copies of the levels of detail to the copy, linked to these levels if linked is true.
+		void copyLods(MeshAttachment *copy, bool linked);
 	};
 }
 
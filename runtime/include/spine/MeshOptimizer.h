@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_MeshOptimizer_h
+#define Spine_MeshOptimizer_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class MeshAttachment;
+
+	class Slot;
+
+	/// Reduces the cost of skinning and drawing the meshes of loaded skeleton data. Works on SkeletonData read by either
+	/// SkeletonJson or SkeletonBinary and must be used before the data is used by any skeleton.
+	///
+	/// Pruning removes the weakest bone influences of each weighted mesh vertex and renormalizes the remaining weights. Deform
+	/// timelines keyed for the mesh are remapped to match. Meshes with deform timelines that were already compacted by
+	/// AnimationOptimizer are not pruned.
+	///
+	/// Levels of detail are generated by repeatedly collapsing interior vertices into a neighbour, choosing the collapse that
+	/// moves the image the least in the setup pose. Hull vertices are kept, so the outline does not change. Each level is a
+	/// MeshAttachment that keeps a subset of the vertices with their weights and reads the full mesh's deform through an index
+	/// map, so deform timelines animate every level. SkeletonRenderer draws a level instead of the full mesh when its error
+	/// is small on screen, see MeshAttachment::getLod(). Meshes with a sequence do not get levels of detail.
+	class SP_API MeshOptimizer : public SpineObject {
+	public:
+		MeshOptimizer();
+
+		/// Prunes and generates levels of detail for the meshes of all skins. Statistics are reset first.
+		void optimize(SkeletonData &skeletonData);
+
+		/// The maximum number of bones per vertex, or 0 for no limit. Default is 0.
+		void setMaxBones(int inValue) { _maxBones = inValue; }
+		int getMaxBones() { return _maxBones; }
+
+		/// Influences with a smaller weight are removed, keeping at least the strongest influence of each vertex. Default is 0.
+		void setMinWeight(float inValue) { _minWeight = inValue; }
+		float getMinWeight() { return _minWeight; }
+
+		/// The number of levels of detail to generate for each mesh. Default is 0.
+		void setLodCount(int inValue) { _lodCount = inValue; }
+		int getLodCount() { return _lodCount; }
+
+		/// The fraction of the vertices of the previous level each level keeps. Default is 0.5.
+		void setLodRatio(float inValue) { _lodRatio = inValue; }
+		float getLodRatio() { return _lodRatio; }
+
+		/// Meshes with fewer vertices do not get levels of detail. Default is 32.
+		void setLodMinVertices(int inValue) { _lodMinVertices = inValue; }
+		int getLodMinVertices() { return _lodMinVertices; }
+
+		/// The maximum error of a level in skeleton units, or 0 for no limit. Levels stop short of the ratio rather than exceed
+		/// it. Default is 0.
+		void setLodMaxError(float inValue) { _lodMaxError = inValue; }
+		float getLodMaxError() { return _lodMaxError; }
+
+		size_t getMeshesPruned() { return _meshesPruned; }
+
+		/// Meshes that were not pruned because their deform timelines are compact.
+		size_t getMeshesSkipped() { return _meshesSkipped; }
+
+		/// The number of bone influences of all weighted meshes before pruning. Skinning cost is proportional to it.
+		size_t getInfluencesBefore() { return _influencesBefore; }
+
+		size_t getInfluencesAfter() { return _influencesAfter; }
+
+		/// The largest total weight removed from a vertex.
+		float getMaxWeightRemoved() { return _maxWeightRemoved; }
+
+		/// The largest distance a vertex moved in the setup pose because of pruning, in skeleton units.
+		float getMaxPruneError() { return _maxPruneError; }
+
+		size_t getLodsCreated() { return _lodsCreated; }
+
+		/// The number of vertices of all meshes that got levels of detail.
+		size_t getLodVerticesBefore() { return _lodVerticesBefore; }
+
+		/// The number of vertices of the least detailed level of those meshes.
+		size_t getLodVerticesAfter() { return _lodVerticesAfter; }
+
+		/// The largest error of any level, in skeleton units.
+		float getMaxLodError() { return _maxLodError; }
+
+		void resetStatistics();
+
+	private:
+		int _maxBones;
+		float _minWeight;
+		int _lodCount;
+		float _lodRatio;
+		int _lodMinVertices;
+		float _lodMaxError;
+
+		size_t _meshesPruned;
+		size_t _meshesSkipped;
+		size_t _influencesBefore;
+		size_t _influencesAfter;
+		float _maxWeightRemoved;
+		float _maxPruneError;
+		size_t _lodsCreated;
+		size_t _lodVerticesBefore;
+		size_t _lodVerticesAfter;
+		float _maxLodError;
+
+		Vector<float> _worldVertices;
+		Vector<float> _prunedWorldVertices;
+
+		void prune(SkeletonData &skeletonData, MeshAttachment &mesh, Slot &slot, Vector<MeshAttachment *> &meshes);
+
+		void generateLods(MeshAttachment &mesh, Slot &slot);
+
+		void linkLods(MeshAttachment &mesh);
+	};
+}
+
+#endif /* Spine_MeshOptimizer_h */
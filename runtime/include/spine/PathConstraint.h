@@ -95,6 +95,14 @@ namespace spine {
 
 		void setActive(bool inValue);
 
+		/// Computes the world position and, if tangents is true, the rotation in radians of each entry in positions along the
+		/// target slot's path, interpreted using the data's position mode. The curve length tables are shared with update()
+		/// and are only rebuilt when the path's world vertices change, so many bones can be placed along one path cheaply.
+		/// Positions do not need to be sorted.
+		/// @param output Receives x, y and rotation for each position. Rotations are 0 when tangents is false.
+		/// @return false if the target slot has no path attachment.
+		bool computePathPositions(Vector<float> &positions, Vector<float> &output, bool tangents);
+
 	private:
 		static const float EPSILON;
 		static const int NONE;
@@ -102,6 +110,7 @@ namespace spine {
 		static const int AFTER;
 
 		PathConstraintData &_data;
+		Skeleton &_skeleton;
 		Vector<Bone *> _bones;
 		Slot *_target;
 		float _position, _spacing;
@@ -113,11 +122,18 @@ namespace spine {
 		Vector<float> _curves;
 		Vector<float> _lengths;
 		Vector<float> _segments;
+		Vector<float> _curvesWorld;
+		bool _curvesClosed;
+		float _pathLength;
 
 		bool _active;
 
 		Vector<float> &computeWorldPositions(PathAttachment &path, int spacesCount, bool tangents);
 
+		void updateCurves(PathAttachment &path);
+
+		float *getSegments(int curve);
+
 		static void addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o);
 
 		static void addAfterPosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o);
@@ -58,6 +58,8 @@ namespace spine {
 
 		virtual ~RegionAttachment();
 
+		/// Computes the vertex offsets and UVs from the region. With a sequence, they are computed for every frame of the
+		/// sequence, and the setup frame is used for the region, offsets and UVs of the attachment itself.
 		void updateRegion();
 
 		/// Transforms the attachment's four vertices to world coordinates.
@@ -115,6 +117,15 @@ namespace spine {
 
 		Vector<float> &getUVs();
 
+		/// The region of the sequence frame the slot shows, or the attachment's region if it has no sequence.
+		TextureRegion *getRegion(Slot &slot);
+
+		/// The vertex offsets of the sequence frame the slot shows, or the attachment's offsets if it has no sequence.
+		float *getOffset(Slot &slot);
+
+		/// The UVs of the sequence frame the slot shows, or the attachment's UVs if it has no sequence.
+		float *getUVs(Slot &slot);
+
 		virtual Attachment *copy();
 
 	private:
@@ -127,9 +138,13 @@ namespace spine {
 		static const int BRX;
 		static const int BRY;
 
+		void computeRegion(TextureRegion *region, float *vertexOffset, float *uvs);
+
 		float _x, _y, _rotation, _scaleX, _scaleY, _width, _height;
 		Vector<float> _vertexOffset;
 		Vector<float> _uvs;
+		Vector<float> _sequenceOffsets;
+		Vector<float> _sequenceUVs;
 		String _path;
 		Color _color;
 		TextureRegion *_region;
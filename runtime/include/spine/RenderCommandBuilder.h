@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_RenderCommandBuilder_h
+#define Spine_RenderCommandBuilder_h
+
+#include <spine/BlendMode.h>
+#include <spine/Color.h>
+#include <spine/SkeletonClipping.h>
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class Slot;
+
+	/// Consecutive triangles drawn with the same texture and blend mode.
+	struct SP_API RenderBatch {
+		/// The AtlasPage::texture of the regions.
+		void *texture;
+		BlendMode blendMode;
+		int vertexStart, vertexCount;
+		/// The indices are relative to vertexStart.
+		int indexStart, indexCount;
+	};
+
+	/// The part of a batch drawn for a slot.
+	struct SP_API RenderSlot {
+		Slot *slot;
+		int batch;
+		int vertexStart, vertexCount;
+		int indexStart, indexCount;
+	};
+
+	/// The vertices, indices and batches built by RenderCommandBuilder. The caller keeps the buffer and clears it before
+	/// building, so building only allocates when more room is needed than before.
+	class SP_API RenderBuffer : public SpineObject {
+	public:
+		/// The x and y of each vertex.
+		Vector<float> positions;
+		/// The u and v of each vertex.
+		Vector<float> uvs;
+		/// The color of each vertex, with red in the lowest byte, so the bytes are RGBA on little endian machines.
+		Vector<unsigned int> colors;
+		/// The dark color of each vertex, like colors. Empty unless RenderCommandBuilder::setDarkColors() is enabled.
+		Vector<unsigned int> darkColors;
+		Vector<unsigned short> indices;
+		Vector<RenderBatch> batches;
+		Vector<RenderSlot> slots;
+
+		void clear();
+	};
+
+	/// Turns a skeleton into batches of triangles, without depending on an engine, so rendering can be tested and measured
+	/// headless or prepared on another thread. Slots are visited in draw order, clipping is applied, vertex colors combine the
+	/// builder, skeleton, slot and attachment colors, and consecutive slots with the same texture and blend mode share a
+	/// batch. Region and mesh attachments must have AtlasRegion regions, as AtlasAttachmentLoader gives them.
+	class SP_API RenderCommandBuilder : public SpineObject {
+	public:
+		RenderCommandBuilder();
+
+		/// Appends the batches drawing the skeleton to the buffer. Batches of earlier calls are not extended.
+		/// @param lodError Meshes are drawn with MeshAttachment::getLod() of it.
+		/// @param worldVertices May be NULL to compute the world vertices. Otherwise slotOffsets has the offset in it of the
+		/// world vertices of each slot's attachment, by slot index, computed for the same lodError, or -1 if there are none.
+		void build(Skeleton &skeleton, RenderBuffer &buffer, float lodError = 0, const float *worldVertices = NULL,
+				   const int *slotOffsets = NULL);
+
+		/// Multiplies the color of every vertex. Default is white.
+		Color &getColor() { return _color; }
+
+		/// If true, vertex colors are premultiplied by their alpha and dark colors have an alpha of 1. Default is false.
+		void setPremultipliedAlpha(bool inValue) { _premultipliedAlpha = inValue; }
+		bool getPremultipliedAlpha() { return _premultipliedAlpha; }
+
+		/// If true, RenderBuffer::darkColors is filled, black for slots without a dark color. Default is false.
+		void setDarkColors(bool inValue) { _darkColors = inValue; }
+		bool getDarkColors() { return _darkColors; }
+
+		/// Only slots with an index from start to end, inclusive, are drawn. Default is all slots.
+		void setSlotsRange(int start, int end);
+
+		/// A batch is not extended past this many vertices or indices, though a slot with more gets a batch of its own.
+		/// Default is 65535, the most unsigned short indices can address.
+		void setMaxBatchSize(int vertices, int indices);
+
+	private:
+		Color _color;
+		bool _premultipliedAlpha;
+		bool _darkColors;
+		int _startSlotIndex, _endSlotIndex;
+		int _maxBatchVertices, _maxBatchIndices;
+		SkeletonClipping _clipper;
+		Vector<float> _worldVertices;
+	};
+}
+
+#endif /* Spine_RenderCommandBuilder_h */
@@ -52,8 +52,13 @@ namespace spine {
 
 		Sequence *copy();
 
+		/// Sets the attachment's region and UVs to the frame selected by the slot. Drawing does not need this, the
+		/// attachments provide each frame's region and UVs for a slot without being changed.
 		void apply(Slot *slot, Attachment *attachment);
 
+		/// Returns the index of the region to use for a slot's sequence index, where -1 selects the setup index.
+		int resolveIndex(int sequenceIndex);
+
 		String getPath(const String &basePath, int index);
 
 		int getId() { return _id; }
@@ -117,6 +117,15 @@ namespace spine {
 
 		~Skeleton();
 
+		/// Returns a new skeleton for the same data with this skeleton's skin, pose, draw order and constraint mixes. The update
+		/// cache is copied instead of sorted again, so copying a prototype is cheaper than constructing each skeleton when
+		/// spawning many.
+		Skeleton *copy();
+
+		/// Sets the skin, pose, draw order, constraint mixes and update cache of this skeleton to those of the prototype, which
+		/// must have the same skeleton data.
+		void copyFrom(Skeleton &prototype);
+
 		/// Caches information about bones and constraints. Must be called if bones, constraints or weighted path attachments are added
 		/// or removed.
 		void updateCache();
@@ -151,6 +160,9 @@ namespace spine {
 		/// See Skeleton::setSlotsToSetupPose()
 		/// Also, often AnimationState::apply(Skeleton&) is called before the next time the
 		/// skeleton is rendered to allow any attachment keys in the current animation(s) to hide or show attachments from the new skin.
+		/// The attachments to set and the update cache are computed once and kept in the skin, see Skin::markChanged(). The
+		/// skin is shared by every skeleton of the skeleton data, so call this only from the main thread (or one thread per
+		/// skeleton data).
 		/// @param newSkin May be NULL.
 		void setSkin(Skin *newSkin);
 
@@ -160,6 +172,12 @@ namespace spine {
 		/// @return May be NULL.
 		Attachment *getAttachment(int slotIndex, const String &attachmentName);
 
+		/// Finds the attachment by the id of its name, avoiding string comparisons, see
+		/// SkeletonData::findAttachmentNameId(). The name is used when the id is -2.
+		/// @param attachmentNameId -1 for no attachment.
+		/// @return May be NULL.
+		Attachment *getAttachment(int slotIndex, const String &attachmentName, int attachmentNameId);
+
 		/// @param attachmentName May be empty.
 		void setAttachment(const String &slotName, const String &attachmentName);
 
@@ -220,6 +238,15 @@ namespace spine {
 
 		void setScaleY(float inValue);
 
+		/// A generation number for the pose, incremented whenever the skeleton may look different: by updateWorldTransform(),
+		/// applying animations, setting the skin, attachments or setup pose, setting a bone's local or world transform and
+		/// setting a constraint's properties. Renderers compare it to reuse world vertices and bounds computed for an unchanged
+		/// pose. Changes made without those methods, such as changing the draw order directly, must be followed by
+		/// markPoseChanged(). Writing to Slot::getDeform() must be followed by Slot::markDeformChanged().
+		unsigned int getPoseVersion();
+
+		void markPoseChanged();
+
 	private:
 		SkeletonData *_data;
 		Vector<Bone *> _bones;
@@ -233,6 +260,18 @@ namespace spine {
 		Color _color;
 		float _scaleX, _scaleY;
 		float _x, _y;
+		unsigned int _poseVersion;
+
+		/// The bones, constraints and slots are constructed in this single allocation in data order, see construct().
+		char *_block;
+
+		Skeleton(Skeleton &prototype);
+
+		void construct();
+
+		void cacheUpdateCache(Skin &skin);
+
+		void restoreUpdateCache(Skin &skin);
 
 		void sortIkConstraint(IkConstraint *constraint);
 
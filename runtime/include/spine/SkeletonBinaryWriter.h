@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_SkeletonBinaryWriter_h
+#define Spine_SkeletonBinaryWriter_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Color.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class Skin;
+
+	class Attachment;
+
+	class VertexAttachment;
+
+	class MeshAttachment;
+
+	class Animation;
+
+	class CurveTimeline;
+
+	class Sequence;
+
+	/// Writes skeleton data in the binary format read by SkeletonBinary.
+	///
+	/// The data is written as it is held in memory, so any scale applied when loading is baked into the output. Bezier curves
+	/// are stored by the runtime as sampled segments; their control points are recovered from the samples, which reproduces the
+	/// curves up to float rounding. Deform frames are written as the smallest range of non-zero offsets.
+	///
+	/// Reading a .skel file and writing it again therefore gives an equivalent file, not a byte for byte copy: control
+	/// points, string order and deform ranges can differ. spine-converter --verify compares the poses instead.
+	class SP_API SkeletonBinaryWriter : public SpineObject {
+	public:
+		SkeletonBinaryWriter();
+
+		~SkeletonBinaryWriter();
+
+		/// Writes the skeleton data to the output, replacing its contents. Returns false and sets the error if the data can not
+		/// be written.
+		bool writeSkeletonData(SkeletonData &skeletonData, Vector<unsigned char> &output);
+
+		/// If false, data only used by the editor (bone colors, mesh edges, images and audio paths, ...) is omitted. Default is
+		/// true.
+		void setNonessential(bool nonessential) { _nonessential = nonessential; }
+
+		bool getNonessential() { return _nonessential; }
+
+		/// If greater than 0, the values of animation keys, their bezier control points and deform offsets are rounded to the
+		/// nearest multiple of the precision, in the units of each property. Deform offsets that round to 0 are then left out
+		/// of the frame's range. Times, colors and setup pose data are always written exactly. Default is 0.
+		void setPrecision(float precision) { _precision = precision; }
+
+		float getPrecision() { return _precision; }
+
+		String &getError() { return _error; }
+
+	private:
+		Vector<unsigned char> *_output;
+		Vector<String> _strings;
+		Vector<float> _deform;
+		String _error;
+		bool _nonessential;
+		float _precision;
+
+		void setError(const char *value1, const char *value2);
+
+		void writeByte(unsigned char value);
+
+		void writeBoolean(bool value);
+
+		void writeInt(int value);
+
+		void writeFloat(float value);
+
+		void writeValue(float value);
+
+		void writeVarint(int value, bool optimizePositive);
+
+		void writeString(const String &value);
+
+		void writeStringRef(const String &value);
+
+		void writeColor(const Color &color);
+
+		void writeShortArray(Vector<unsigned short> &array);
+
+		bool writeSkin(SkeletonData &skeletonData, Skin &skin, bool defaultSkin);
+
+		void writeSequence(Sequence *sequence);
+
+		bool writeAttachment(SkeletonData &skeletonData, Skin &skin, size_t slotIndex, const String &attachmentName,
+							 Attachment *attachment);
+
+		void writeVertices(VertexAttachment &attachment);
+
+		bool writeAnimation(SkeletonData &skeletonData, Animation &animation);
+
+		void writeCurve(CurveTimeline &timeline, size_t frame, size_t entries, size_t valueCount);
+
+		void writeFrames(CurveTimeline &timeline, bool colors);
+
+		Skin *findAttachmentSkin(SkeletonData &skeletonData, Attachment *attachment, size_t slotIndex, String *attachmentName);
+	};
+}
+
+#endif /* Spine_SkeletonBinaryWriter_h */
@@ -37,20 +37,28 @@
 namespace spine {
 	class Skeleton;
 
+	class Slot;
+
+	class Bone;
+
 	class BoundingBoxAttachment;
 
 	class Polygon;
 
 	/// Collects each BoundingBoxAttachment that is visible and computes the world vertices for its polygon.
 	/// The polygon vertices are provided along with convenience methods for doing hit detection.
+	///
+	/// Polygons are computed lazily, when a query first needs them, and each keeps the bone transforms and deform it was
+	/// computed from, so a polygon whose bones did not move is reused by later updates without being computed again. Each
+	/// polygon also has an axis aligned bounding box that rejects most points and segments before the polygon is tested.
 	class SP_API SkeletonBounds : public SpineObject {
 	public:
 		SkeletonBounds();
 
 		~SkeletonBounds();
 
-		/// Clears any previous polygons, finds all visible bounding box attachments,
-		/// and computes the world vertices for each bounding box's polygon.
+		/// Finds all visible bounding box attachments. The world vertices for each bounding box's polygon are computed
+		/// when a query needs them, the skeleton must not be changed before the queries are done.
 		/// @param skeleton The skeleton.
 		/// @param updateAabb
 		/// If true, the axis aligned bounding box containing all the polygons is computed.
@@ -65,7 +73,7 @@ namespace spine {
 		bool aabbintersectsSegment(float x1, float y1, float x2, float y2);
 
 		/// Returns true if the axis aligned bounding box intersects the axis aligned bounding box of the specified bounds.
-		bool aabbIntersectsSkeleton(SkeletonBounds bounds);
+		bool aabbIntersectsSkeleton(SkeletonBounds &bounds);
 
 		/// Returns true if the polygon contains the point.
 		bool containsPoint(Polygon *polygon, float x, float y);
@@ -78,6 +86,11 @@ namespace spine {
 		/// more efficient to only call this method if {@link #aabbintersectsSegment(float, float, float, float)} returns true.
 		BoundingBoxAttachment *intersectsSegment(float x1, float y1, float x2, float y2);
 
+		/// For each x, y pair in points, stores the first bounding box attachment that contains the point, or NULL, in hits.
+		/// The AABB is checked first, so this is efficient for many points that mostly miss the skeleton.
+		/// @return The number of points that hit a bounding box.
+		int containsPoints(Vector<float> &points, Vector<BoundingBoxAttachment *> &hits);
+
 		/// Returns true if the polygon contains the line segment.
 		bool intersectsSegment(Polygon *polygon, float x1, float y1, float x2, float y2);
 
@@ -102,7 +115,16 @@ namespace spine {
 		Pool <Polygon> _polygonPool;
 		Vector<BoundingBoxAttachment *> _boundingBoxes;
 		Vector<Polygon *> _polygons;
+		Vector<Slot *> _slots;
+		Skeleton *_skeleton;
 		float _minX, _minY, _maxX, _maxY;
+		bool _aabbDirty;
+
+		Polygon *computePolygon(size_t index);
+
+		void computePolygons();
+
+		static bool updatePose(Bone &bone, float *pose);
 
 		void aabbCompute();
 	};
@@ -111,10 +133,17 @@ namespace spine {
 	public:
 		Vector<float> _vertices;
 		int _count;
+		float _minX, _minY, _maxX, _maxY;
+		Vector<float> _pose; // the bone transforms and deform the vertices were computed from
+		bool _dirty;
 
-		Polygon() : _count(0) {
+		Polygon() : _count(0), _minX(0), _minY(0), _maxX(0), _maxY(0), _dirty(true) {
 			_vertices.ensureCapacity(16);
 		}
+
+		bool aabbContainsPoint(float x, float y) {
+			return x >= _minX && x <= _maxX && y >= _minY && y <= _maxY;
+		}
 	};
 }
 
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_SkeletonBroadphase_h
+#define Spine_SkeletonBroadphase_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class SkeletonData;
+
+	class SkeletonBounds;
+
+	class BoundingBoxAttachment;
+
+	/// A spatial index of many skeletons for hit detection against their bounding box attachments.
+	///
+	/// Each skeleton is a proxy with conservative bounds computed from its bones: for every bone, the farthest vertex of any
+	/// bounding box attachment in any skin that the bone moves, scaled by the bone's world transform. The bounds are kept
+	/// in a dynamic AABB tree, enlarged by a margin so a skeleton that moves a little does not change the tree. Queries walk
+	/// the tree to find candidates, and only the candidates are tested against their bounding box polygons using a
+	/// SkeletonBounds per proxy.
+	///
+	/// Skeletons may be placed in the index's coordinates with a transform, for example the node to world transform of the
+	/// node that draws them. The skeleton world transform must be updated before update() is called, and not changed again
+	/// before the queries are done.
+	class SP_API SkeletonBroadphase : public SpineObject {
+	public:
+		SkeletonBroadphase();
+
+		~SkeletonBroadphase();
+
+		/// Adds a skeleton and computes its bounds.
+		/// @return The proxy for the skeleton, used by the other methods.
+		int add(Skeleton *skeleton, void *userData = NULL);
+
+		void remove(int proxy);
+
+		/// Sets the transform from the skeleton's world coordinates to the coordinates of this index. Default is the
+		/// identity. Takes effect on the next update().
+		void setTransform(int proxy, float a, float b, float c, float d, float worldX, float worldY);
+
+		/// Recomputes the bounds of the proxy's skeleton after it was posed or moved. The tree is only changed when the bounds
+		/// are no longer inside the enlarged bounds stored in it.
+		void update(int proxy);
+
+		/// Updates every proxy.
+		void updateAll();
+
+		Skeleton *getSkeleton(int proxy);
+
+		void *getUserData(int proxy);
+
+		/// Collects the proxies whose enlarged bounds contain the point. These are candidates for containsPoint().
+		void queryPoint(float x, float y, Vector<int> &proxies);
+
+		/// Collects the proxies whose enlarged bounds overlap the rectangle.
+		void queryAabb(float minX, float minY, float maxX, float maxY, Vector<int> &proxies);
+
+		/// Collects the proxies whose enlarged bounds intersect the line segment.
+		void querySegment(float x1, float y1, float x2, float y2, Vector<int> &proxies);
+
+		/// Collects the proxies with a bounding box attachment that contains the point, in no particular order.
+		/// @return The number of proxies found.
+		int containsPoint(float x, float y, Vector<int> &proxies);
+
+		/// Collects the proxies with a bounding box attachment that intersects the line segment, in no particular order.
+		/// @return The number of proxies found.
+		int intersectsSegment(float x1, float y1, float x2, float y2, Vector<int> &proxies);
+
+		/// Returns the bounding box attachment of the proxy's skeleton that contains the point, or NULL. The point is in the
+		/// coordinates of this index.
+		BoundingBoxAttachment *containsPoint(int proxy, float x, float y);
+
+		/// Returns the bounding box attachment of the proxy's skeleton that intersects the line segment, or NULL.
+		BoundingBoxAttachment *intersectsSegment(int proxy, float x1, float y1, float x2, float y2);
+
+		/// The bounds are enlarged by this fraction of their larger side in the tree. Larger margins change the tree less
+		/// often when skeletons move, but find more candidates. Default is 0.1.
+		void setMargin(float inValue) { _margin = inValue; }
+		float getMargin() { return _margin; }
+
+		int getProxyCount() { return _proxyCount; }
+
+		/// The height of the tree, for checking its balance.
+		int getHeight();
+
+	private:
+		struct Node {
+			float minX, minY, maxX, maxY;
+			int parent; // the next free node for free nodes
+			int child1, child2;
+			int height; // -1 for free nodes
+			int proxy;
+		};
+
+		class Proxy : public SpineObject {
+		public:
+			Skeleton *_skeleton;
+			void *_userData;
+			Vector<float> *_radii;
+			float _a, _b, _c, _d, _worldX, _worldY;
+			int _node;
+			SkeletonBounds *_bounds;
+			bool _boundsDirty;
+		};
+
+		Vector<Proxy *> _proxies;
+		Vector<int> _freeProxies;
+		int _proxyCount;
+		Vector<Node> _nodes;
+		int _root;
+		int _freeNode;
+		float _margin;
+		Vector<SkeletonData *> _radiiData;
+		Vector<Vector<float> *> _radii;
+		Vector<int> _radiiReferences;
+		Vector<int> _stack;
+		Vector<int> _candidates;
+
+		Vector<float> *getRadii(SkeletonData &skeletonData);
+
+		bool computeBounds(Proxy &proxy, float &minX, float &minY, float &maxX, float &maxY);
+
+		SkeletonBounds &getBounds(Proxy &proxy);
+
+		int allocateNode();
+
+		void freeNode(int node);
+
+		void insertLeaf(int leaf);
+
+		void removeLeaf(int leaf);
+
+		int balance(int index);
+	};
+}
+
+#endif /* Spine_SkeletonBroadphase_h */
@@ -58,6 +58,10 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class Skin;
+
+		friend class SlotData;
+
 	public:
 		SkeletonData();
 
@@ -156,6 +160,14 @@ namespace spine {
 
 		void setFps(float inValue);
 
+		/// Gives each attachment name used by the skins, the slots' setup attachments and the attachment timelines an id, so
+		/// applying animations finds attachments by id instead of comparing names. The loaders call this. Names changed or
+		/// added afterward are found by name until it is called again.
+		void internAttachmentNames();
+
+		/// Returns the id of the attachment name, or -1 if the name has no id.
+		int findAttachmentNameId(const String &attachmentName);
+
 	private:
 		String _name;
 		Vector<BoneData *> _bones; // Ordered parents first
@@ -171,11 +183,19 @@ namespace spine {
 		String _version;
 		String _hash;
 		Vector<char *> _strings;
+		Vector<String> _attachmentNames; // By id.
+		Vector<int> _attachmentNameTable; // Open addressing hash table of the ids, -1 where empty.
+		unsigned int _setupAttachmentsVersion; // Changed when a slot's setup attachment name changes.
 
 		// Nonessential.
 		float _fps;
 		String _imagesPath;
 		String _audioPath;
+
+		/// Returns the id of the attachment name, giving it one if it has none.
+		int internAttachmentName(const String &attachmentName);
+
+		int findAttachmentNameIndex(const String &attachmentName);
 	};
 }
 
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonPicker_h
+#define Spine_SkeletonPicker_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Slot;
+
+	/// Finds the slot drawn at a point, using the triangles a renderer drew for each slot.
+	///
+	/// A renderer adds the triangles of each slot as it draws them, in draw order and after clipping, so picking matches
+	/// what is on screen without computing world vertices again. A bounding volume hierarchy over the triangles is built
+	/// the first time pick() is called after triangles were added, so frames without picking only pay for copying the
+	/// positions.
+	class SP_API SkeletonPicker : public SpineObject {
+	public:
+		SkeletonPicker();
+
+		/// Removes all triangles, for example before a new frame is drawn.
+		void clear();
+
+		/// Adds triangles drawn for the slot, which is on top of the slots added before it.
+		/// @param vertices The x and y of each vertex, with stride floats from one vertex to the next. Only the positions are
+		/// copied.
+		/// @param indexOffset Subtracted from each index, for indices that count from a vertex before the first one given, such
+		/// as those of a RenderBatch.
+		void addTriangles(Slot *slot, const float *vertices, size_t vertexCount, size_t stride, const unsigned short *indices,
+						  size_t indexCount, int indexOffset = 0);
+
+		/// Returns the slot drawn last of the slots with a triangle containing the point, or NULL.
+		Slot *pick(float x, float y);
+
+		size_t getTriangleCount() { return _triangleSlots.size(); }
+
+	private:
+		struct Node {
+			float minX, minY, maxX, maxY;
+			int start, count; // the triangles of leaves, count is 0 for inner nodes
+			int child2; // the first child of inner nodes follows them
+			int maxTriangle; // the last drawn triangle below the node
+		};
+
+		Vector<float> _positions;
+		Vector<int> _triangles;
+		Vector<int> _triangleSlots;
+		Vector<Slot *> _slots;
+		Vector<Node> _nodes;
+		Vector<int> _order;
+		Vector<float> _centers;
+		Vector<int> _stack;
+		bool _dirty;
+
+		void build();
+
+		int buildNode(int start, int end);
+	};
+}
+
+#endif /* Spine_SkeletonPicker_h */
@@ -42,12 +42,16 @@ namespace spine {
 
 	class ConstraintData;
 
+	class SkeletonData;
+
 /// Stores attachments by slot index and attachment name.
 /// See SkeletonData::getDefaultSkin, Skeleton::getSkin, and
 /// http://esotericsoftware.com/spine-runtime-skins in the Spine Runtimes Guide.
 	class SP_API Skin : public SpineObject {
 		friend class Skeleton;
 
+		friend class SkeletonData;
+
 	public:
 		class SP_API AttachmentMap : public SpineObject {
 			friend class Skin;
@@ -153,12 +157,54 @@ namespace spine {
 
 		Vector<ConstraintData *> &getConstraints();
 
+		/// Must be called after the bones or constraints returned by getBones() and getConstraints() are changed, so skeletons
+		/// setting this skin don't reuse results computed for the previous contents. The other methods call it.
+		void markChanged();
+
 	private:
 		const String _name;
 		AttachmentMap _attachments;
 		Vector<BoneData *> _bones;
 		Vector<ConstraintData *> _constraints;
 
+		/// Unique among all skins and changed whenever the skin changes.
+		unsigned int _version;
+
+		// What Skeleton::setSkin() computes for this skin, reused while the skeleton data, its slots' setup attachment names,
+		// this skin and the default skin are unchanged. Shared by every skeleton setting the skin, so only one thread may set
+		// skins: the attachment for each slot's setup attachment name, the update cache as offsets of the objects in a
+		// skeleton's block with the sorted and active flags of bones then constraints, and the attachments to swap when
+		// coming from other skins.
+		SkeletonData *_cacheData;
+		unsigned int _cacheVersion, _cacheDefaultVersion, _cacheSetupVersion;
+		Vector<Attachment *> _cacheSetupAttachments;
+		Vector<size_t> _cacheUpdateOffsets;
+		Vector<bool> _cacheSorted;
+		Vector<bool> _cacheActive;
+		Vector<Skin *> _cacheFromSkins;
+		Vector<unsigned int> _cacheFromVersions;
+		Vector<size_t> _cacheSwapStarts; // start of each from skin's swaps, then the end
+		Vector<int> _cacheSwapSlots;
+		Vector<Attachment *> _cacheSwapFrom;
+		Vector<Attachment *> _cacheSwapTo;
+
+		// The attachments of each slot with the ids of their names in _idTableData, see
+		// SkeletonData::internAttachmentNames(). Built by it and rebuilt when the attachments change.
+		SkeletonData *_idTableData;
+		size_t _idTableNameCount;
+		Vector<size_t> _idTableStarts; // start of each slot's attachments, then the end
+		Vector<int> _idTableIds;
+		Vector<Attachment *> _idTableAttachments;
+
+		static unsigned int nextVersion();
+
+		void attachmentsChanged();
+
+		/// Returns the attachment for the specified slot index and name id in the skeleton data, or NULL.
+		Attachment *getAttachment(SkeletonData &skeletonData, size_t slotIndex, int attachmentNameId);
+
+		void updateAttachmentIds(SkeletonData &skeletonData);
+
 		/// Attach all attachments from this skin if the corresponding attachment from the old skin is currently attached.
 		void attachAll(Skeleton &skeleton, Skin &oldSkin);
 	};
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_SkinRepacker_h
+#define Spine_SkinRepacker_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	class Attachment;
+
+	class AtlasPage;
+
+	class AtlasRegion;
+
+	class BoneData;
+
+	class ConstraintData;
+
+	class Skin;
+
+	class TextureLoader;
+
+	/// Packs the atlas regions used by a skin into new pages, so a skin composed from several skins with Skin::addSkin() or
+	/// Skin::copySkin() draws from one or a few textures and renderers break fewer batches.
+	///
+	/// The regions are copied on the CPU from the pixels returned by TextureLoader::readPixels() and the pages are created by
+	/// TextureLoader::loadPixels(), so both must be implemented by the texture loader and called where textures may be
+	/// created. Region and mesh attachments are copied to use the new regions. Other attachments, and attachments whose
+	/// regions can't be packed, are shared with the skin. Regions with repeat wrapping, regions larger than the maximum page
+	/// size and regions of pages with different settings are not packed together. As with Skin::copySkin(), copied region
+	/// attachments are not keyed by sequence timelines of the original. Copied meshes don't have the levels of detail
+	/// generated by MeshOptimizer.
+	///
+	/// Repacked skins are cached by the skin's slots, attachment names, attachments, bones and constraints, so skins composed
+	/// from the same parts share the repacked skin and its pages. The attachments stay referenced while cached. A repacked
+	/// skin is disposed, with its pages, when every repack() returning it was matched by release().
+	class SP_API SkinRepacker : public SpineObject {
+	public:
+		explicit SkinRepacker(TextureLoader *textureLoader);
+
+		~SkinRepacker();
+
+		/// Returns a skin with the attachments, bones and constraints of the skin, drawing from packed pages. Must be matched by
+		/// release() once skeletons no longer use the returned skin. Statistics are reset unless a cached skin is returned.
+		Skin *repack(Skin &skin);
+
+		void release(Skin *repackedSkin);
+
+		/// The maximum width and height of a created page, in pixels. Default is 2048.
+		void setMaxPageSize(int inValue) { _maxPageSize = inValue; }
+		int getMaxPageSize() { return _maxPageSize; }
+
+		/// The pixels around each packed region, filled with its edge pixels so filtering doesn't bleed. Default is 2.
+		void setPadding(int inValue) { _padding = inValue; }
+		int getPadding() { return _padding; }
+
+		/// The number of repacked skins that are cached.
+		size_t getSkinCount() { return _skins.size(); }
+
+		size_t getRegionsPacked() { return _regionsPacked; }
+
+		/// Regions that were not packed, so their attachments still draw from the original pages.
+		size_t getRegionsSkipped() { return _regionsSkipped; }
+
+		/// The number of pages the packed regions came from.
+		size_t getSourcePages() { return _sourcePages; }
+
+		size_t getPagesCreated() { return _pagesCreated; }
+
+	private:
+		class Repacked : public SpineObject {
+		public:
+			Skin *skin;
+			int references;
+			unsigned int hash;
+			Vector<size_t> slots;
+			Vector<String> names;
+			Vector<Attachment *> attachments;
+			Vector<BoneData *> bones;
+			Vector<ConstraintData *> constraints;
+			Vector<AtlasPage *> pages;
+			Vector<AtlasRegion *> regions;
+		};
+
+		TextureLoader *_textureLoader;
+		int _maxPageSize;
+		int _padding;
+		Vector<Repacked *> _skins;
+
+		size_t _regionsPacked;
+		size_t _regionsSkipped;
+		size_t _sourcePages;
+		size_t _pagesCreated;
+
+		Vector<AtlasRegion *> _sourceRegions;
+		Vector<AtlasRegion *> _packedRegions;
+
+		void build(Repacked &repacked, Skin &skin);
+
+		void pack(Repacked &repacked, Vector<int> &regionIndices, Vector<AtlasPage *> &sourcePages,
+				  Vector<Vector<unsigned char> *> &sourcePixels);
+
+		void replaceRegions(Attachment *attachment);
+
+		void dispose(Repacked *repacked);
+	};
+}
+
+#endif /* Spine_SkinRepacker_h */
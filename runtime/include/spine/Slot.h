@@ -114,8 +114,15 @@ namespace spine {
 
 		void setAttachmentState(int state);
 
+		/// Values that deform the attachment's vertices. Code that changes them must call markDeformChanged().
 		Vector<float> &getDeform();
 
+		/// Incremented when the deform changes, see markDeformChanged().
+		unsigned int getDeformVersion();
+
+		/// Records that the deform was changed, so world vertices computed from it are recomputed.
+		void markDeformChanged();
+
 		int getSequenceIndex();
 
 		void setSequenceIndex(int index);
@@ -131,6 +138,7 @@ namespace spine {
 		int _attachmentState;
 		int _sequenceIndex;
 		Vector<float> _deform;
+		unsigned int _deformVersion;
 	};
 }
 
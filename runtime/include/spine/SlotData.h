@@ -38,11 +38,15 @@
 namespace spine {
 	class BoneData;
 
+	class SkeletonData;
+
 	class SP_API SlotData : public SpineObject {
 		friend class SkeletonBinary;
 
 		friend class SkeletonJson;
 
+		friend class SkeletonData;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -99,8 +103,14 @@ namespace spine {
 		/// May be empty.
 		const String &getAttachmentName();
 
+		/// Skeletons using the skeleton data must not set skins from other threads while this is called, see
+		/// Skeleton::setSkin().
 		void setAttachmentName(const String &inValue);
 
+		/// The id of the setup attachment name, see SkeletonData::internAttachmentNames(). -1 if there is no setup attachment, -2
+		/// if the name has no id yet.
+		int getAttachmentNameId();
+
 		BlendMode getBlendMode();
 
 		void setBlendMode(BlendMode inValue);
@@ -114,7 +124,9 @@ namespace spine {
 
 		bool _hasDarkColor;
 		String _attachmentName;
+		int _attachmentNameId;
 		BlendMode _blendMode;
+		SkeletonData *_skeletonData; // Set by the loaders, NULL for slot data created elsewhere.
 	};
 }
 
@@ -32,6 +32,7 @@
 
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
+#include <spine/Vector.h>
 
 namespace spine {
 	class AtlasPage;
@@ -45,6 +46,15 @@ namespace spine {
 		virtual void load(AtlasPage &page, const String &path) = 0;
 
 		virtual void unload(void *texture) = 0;
+
+		/// Reads the image of a page as RGBA8888 pixels, rows from the top, in the form the page's texture was created from.
+		/// Used by SkinRepacker. Returns false if the pixels can't be read, which the default does.
+		virtual bool readPixels(AtlasPage &page, Vector<unsigned char> &pixels);
+
+		/// Creates the texture of a page built by SkinRepacker from RGBA8888 pixels of the page's width and height, setting
+		/// AtlasPage::texture. The pixels came from readPixels() of sourcePage, whose texture settings should be matched. The
+		/// default does nothing.
+		virtual void loadPixels(AtlasPage &page, const unsigned char *pixels, AtlasPage &sourcePage);
 	};
 }
 
@@ -43,6 +43,8 @@ namespace spine {
 	class Event;
 
 	class SP_API Timeline : public SpineObject {
+		friend class AnimationOptimizer;
+
 	RTTI_DECL
 
 	public:
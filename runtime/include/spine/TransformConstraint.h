@@ -93,6 +93,7 @@ namespace spine {
 
 	private:
 		TransformConstraintData &_data;
+		Skeleton &_skeleton;
 		Vector<Bone *> _bones;
 		Bone *_target;
 		float _mixRotate, _mixX, _mixY, _mixScaleX, _mixScaleY, _mixShearY;
@@ -88,12 +88,32 @@ namespace spine {
 			}
 		}
 
+		/// Sets the size without constructing new elements, leaving their values undefined. Only for types that need no
+		/// construction, such as float.
+		inline void setSizeUninitialized(size_t newSize) {
+			if (_capacity < newSize) ensureCapacity(newSize);
+			_size = newSize;
+		}
+
 		inline void ensureCapacity(size_t newCapacity = 0) {
 			if (_capacity >= newCapacity) return;
 			_capacity = newCapacity;
 			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
 		}
 
+		/// Reduces the capacity to the current size, releasing the unused memory.
+		inline void shrink() {
+			if (_capacity == _size) return;
+			if (_size == 0) {
+				deallocate(_buffer);
+				_buffer = NULL;
+				_capacity = 0;
+				return;
+			}
+			_capacity = _size;
+			_buffer = SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+		}
+
 		inline void add(const T &inValue) {
 			if (_size == _capacity) {
 				// inValue might reference an element in this buffer
@@ -45,6 +45,8 @@ namespace spine {
 
 		friend class DeformTimeline;
 
+		friend class MeshOptimizer;
+
 	RTTI_DECL
 
 	public:
@@ -77,6 +79,10 @@ namespace spine {
 
 		size_t getWorldVerticesLength();
 
+		/// Returns the sum of Bone::getWorldVersion() of the bones that transform the vertices, which changes when any of them
+		/// moves. Together with Slot::getDeformVersion() it tells whether world vertices computed earlier are still valid.
+		unsigned int getBonesVersion(Slot &slot);
+
 		void setWorldVerticesLength(size_t inValue);
 
 		Attachment * getTimelineAttachment();
@@ -85,12 +91,32 @@ namespace spine {
 
 		void copyTo(VertexAttachment *other);
 
+		/// Rebuilds the layout used to transform weighted vertices, which groups vertices by their number of bones and stores
+		/// their values in separate arrays, so several vertices are transformed at once. The loaders call this; it must be
+		/// called again after the bones or vertices of a weighted attachment are changed.
+		void updateSkinning();
+
 	protected:
+		/// Computes world vertices using the specified deform values instead of the slot's.
+		/// @param deformMap May be NULL. Otherwise the index in deform of each of this attachment's deform values, so a
+		/// level of detail reads the full mesh's deform without copying it.
+		void transformVertices(Slot &slot, Vector<float> &deform, const int *deformMap, size_t start, size_t count,
+							   float *worldVertices, size_t offset, size_t stride);
+
 		Vector <int> _bones;
 		Vector<float> _vertices;
 		size_t _worldVerticesLength;
 		Attachment *_timelineAttachment;
 
+		// Skinning layout, see updateSkinning(). Each group of vertices with the same bone count stores, per influence, a
+		// block of x, then y, then weight values for all of its vertices.
+		Vector<int> _skinningGroups; // bone count, vertex count, ...
+		Vector<unsigned short> _skinningOrder; // index of each vertex in the world vertices
+		Vector<int> _skinningBoneMap; // skeleton bone index of each local bone
+		Vector<unsigned short> _skinningBones; // local bone index of each influence
+		Vector<int> _skinningDeform; // deform index of each influence
+		Vector<float> _skinningVertices;
+
 	private:
 		const int _id;
 
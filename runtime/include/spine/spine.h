@@ -31,6 +31,7 @@
 #define SPINE_SPINE_H_
 
 #include <spine/Animation.h>
+#include <spine/AnimationOptimizer.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
 #include <spine/Atlas.h>
@@ -64,6 +65,7 @@
 #include <spine/LinkedMesh.h>
 #include <spine/MathUtil.h>
 #include <spine/MeshAttachment.h>
+#include <spine/MeshOptimizer.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
 #include <spine/PathAttachment.h>
@@ -76,6 +78,7 @@
 #include <spine/Pool.h>
 #include <spine/PositionMode.h>
 #include <spine/RegionAttachment.h>
+#include <spine/RenderCommandBuilder.h>
 #include <spine/RotateMode.h>
 #include <spine/RotateTimeline.h>
 #include <spine/RTTI.h>
@@ -83,11 +86,15 @@
 #include <spine/ShearTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonBinary.h>
+#include <spine/SkeletonBinaryWriter.h>
 #include <spine/SkeletonBounds.h>
+#include <spine/SkeletonBroadphase.h>
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonPicker.h>
 #include <spine/Skin.h>
+#include <spine/SkinRepacker.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SpacingMode.h>
@@ -73,6 +73,7 @@ void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop,
 	for (size_t i = 0, n = _timelines.size(); i < n; ++i) {
 		_timelines[i]->apply(skeleton, lastTime, time, pEvents, alpha, blend, direction);
 	}
+	skeleton.markPoseChanged();
 }
 
 const String &Animation::getName() {
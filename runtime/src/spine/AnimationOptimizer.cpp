@@ -0,0 +1,444 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AnimationOptimizer.h>
+
+#include <spine/Animation.h>
+#include <spine/ColorTimeline.h>
+#include <spine/DeformTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/PathConstraintData.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintPositionTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
+#include <spine/RotateTimeline.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/ShearTimeline.h>
+#include <spine/SkeletonData.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraintData.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TranslateTimeline.h>
+
+using namespace spine;
+
+AnimationOptimizer::AnimationOptimizer() : _rotateTolerance(0.01f),
+										   _translateTolerance(0.01f),
+										   _scaleTolerance(0.0001f),
+										   _shearTolerance(0.01f),
+										   _colorTolerance(0.5f / 255),
+										   _mixTolerance(0.0001f),
+										   _removeSetupPoseTimelines(false),
+										   _compactDeformTimelines(false),
+										   _deformTolerance(0.01f),
+										   _validate(true),
+										   _framesRemoved(0),
+										   _timelinesCollapsed(0),
+										   _timelinesRemoved(0),
+										   _timelinesQuantized(0),
+										   _timelinesRestored(0),
+										   _bytesSaved(0),
+										   _maxError(0) {
+}
+
+void AnimationOptimizer::resetStatistics() {
+	_framesRemoved = 0;
+	_timelinesCollapsed = 0;
+	_timelinesRemoved = 0;
+	_timelinesQuantized = 0;
+	_timelinesRestored = 0;
+	_bytesSaved = 0;
+	_maxError = 0;
+}
+
+void AnimationOptimizer::optimize(SkeletonData &skeletonData) {
+	resetStatistics();
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0, n = animations.size(); i < n; ++i)
+		optimize(skeletonData, *animations[i]);
+}
+
+void AnimationOptimizer::optimize(SkeletonData &skeletonData, Animation &animation) {
+	Vector<Timeline *> &timelines = animation._timelines;
+	bool removedTimeline = false;
+	for (size_t i = 0; i < timelines.size();) {
+		if (!timelines[i]->getRTTI().instanceOf(CurveTimeline::rtti)) {
+			i++;
+			continue;
+		}
+		if (timelines[i]->getRTTI().isExactly(DeformTimeline::rtti)) {
+			if (_compactDeformTimelines) compact(*static_cast<DeformTimeline *>(timelines[i]));
+			i++;
+			continue;
+		}
+		CurveTimeline &timeline = *static_cast<CurveTimeline *>(timelines[i]);
+		float tolerance = getTolerance(timeline);
+		if (tolerance < 0) {
+			i++;
+			continue;
+		}
+
+		size_t frameCount = timeline.getFrameCount();
+		size_t bytes = (timeline._frames.getCapacity() + timeline._curves.getCapacity()) * sizeof(float);
+		bool constant = isConstant(timeline, tolerance);
+		if (constant && _removeSetupPoseTimelines && isSetupPose(skeletonData, timeline, tolerance)) {
+			_framesRemoved += frameCount;
+			_bytesSaved += bytes;
+			_timelinesRemoved++;
+			delete timelines[i];
+			timelines.removeAt(i);
+			removedTimeline = true;
+			continue;
+		}
+
+		if (_validate) saveOriginal(timeline);
+		if (constant) {
+			_keep.clear();
+			_keep.setSize(frameCount, false);
+			_keep[0] = true;
+		} else
+			markRemovableFrames(timeline, tolerance);
+		compact(timeline);
+		if (timeline.getFrameCount() < frameCount) {
+			if (_validate && !matchesOriginal(timeline, tolerance)) {
+				restoreOriginal(timeline);
+				_timelinesRestored++;
+			} else if (constant)
+				_timelinesCollapsed++;
+		}
+		_framesRemoved += frameCount - timeline.getFrameCount();
+		_bytesSaved += bytes - (timeline._frames.getCapacity() + timeline._curves.getCapacity()) * sizeof(float);
+		i++;
+	}
+
+	if (removedTimeline) {
+		animation._timelineIds.clear();
+		for (size_t i = 0; i < timelines.size(); i++) {
+			Vector<PropertyId> &propertyIds = timelines[i]->getPropertyIds();
+			for (size_t ii = 0; ii < propertyIds.size(); ii++)
+				animation._timelineIds.put(propertyIds[ii], true);
+		}
+	}
+}
+
+float AnimationOptimizer::getTolerance(CurveTimeline &timeline) {
+	const RTTI &rtti = timeline.getRTTI();
+	if (rtti.isExactly(RotateTimeline::rtti)) return _rotateTolerance;
+	if (rtti.isExactly(TranslateTimeline::rtti) || rtti.isExactly(TranslateXTimeline::rtti) ||
+		rtti.isExactly(TranslateYTimeline::rtti))
+		return _translateTolerance;
+	if (rtti.isExactly(ScaleTimeline::rtti) || rtti.isExactly(ScaleXTimeline::rtti) || rtti.isExactly(ScaleYTimeline::rtti))
+		return _scaleTolerance;
+	if (rtti.isExactly(ShearTimeline::rtti) || rtti.isExactly(ShearXTimeline::rtti) || rtti.isExactly(ShearYTimeline::rtti))
+		return _shearTolerance;
+	if (rtti.isExactly(RGBATimeline::rtti) || rtti.isExactly(RGBTimeline::rtti) || rtti.isExactly(AlphaTimeline::rtti) ||
+		rtti.isExactly(RGBA2Timeline::rtti) || rtti.isExactly(RGB2Timeline::rtti))
+		return _colorTolerance;
+	if (rtti.isExactly(TransformConstraintTimeline::rtti) || rtti.isExactly(PathConstraintMixTimeline::rtti))
+		return _mixTolerance;
+	if (rtti.isExactly(PathConstraintPositionTimeline::rtti) || rtti.isExactly(PathConstraintSpacingTimeline::rtti))
+		return _translateTolerance;
+	return -1;
+}
+
+bool AnimationOptimizer::isConstant(CurveTimeline &timeline, float tolerance) {
+	Vector<float> &frames = timeline._frames;
+	Vector<float> &curves = timeline._curves;
+	size_t entries = timeline.getFrameEntries(), frameCount = timeline.getFrameCount();
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		for (size_t v = 1; v < entries; v++) {
+			if (MathUtil::abs(frames[frame * entries + v] - frames[v]) > tolerance) return false;
+		}
+		// Bezier handles can overshoot even when the keys are equal.
+		int curveType = (int) curves[frame];
+		if (curveType < CurveTimeline::BEZIER) continue;
+		for (size_t v = 1; v < entries; v++) {
+			size_t i = curveType - CurveTimeline::BEZIER + (v - 1) * CurveTimeline::BEZIER_SIZE;
+			for (size_t n = i + CurveTimeline::BEZIER_SIZE; i < n; i += 2) {
+				if (MathUtil::abs(curves[i + 1] - frames[v]) > tolerance) return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool equals(float a, float b, float tolerance) {
+	return MathUtil::abs(a - b) <= tolerance;
+}
+
+bool AnimationOptimizer::isSetupPose(SkeletonData &skeletonData, CurveTimeline &timeline, float tolerance) {
+	// Bone timelines are relative to the setup pose, scale multiplies it.
+	const RTTI &rtti = timeline.getRTTI();
+	Vector<float> &frames = timeline._frames;
+	if (rtti.isExactly(RotateTimeline::rtti) || rtti.isExactly(TranslateXTimeline::rtti) ||
+		rtti.isExactly(TranslateYTimeline::rtti) || rtti.isExactly(ShearXTimeline::rtti) ||
+		rtti.isExactly(ShearYTimeline::rtti))
+		return equals(frames[1], 0, tolerance);
+	if (rtti.isExactly(TranslateTimeline::rtti) || rtti.isExactly(ShearTimeline::rtti))
+		return equals(frames[1], 0, tolerance) && equals(frames[2], 0, tolerance);
+	if (rtti.isExactly(ScaleXTimeline::rtti) || rtti.isExactly(ScaleYTimeline::rtti))
+		return equals(frames[1], 1, tolerance);
+	if (rtti.isExactly(ScaleTimeline::rtti))
+		return equals(frames[1], 1, tolerance) && equals(frames[2], 1, tolerance);
+
+	// Slot color timelines are absolute.
+	if (rtti.isExactly(RGBATimeline::rtti)) {
+		Color &color = skeletonData.getSlots()[static_cast<RGBATimeline &>(timeline).getSlotIndex()]->getColor();
+		return equals(frames[1], color.r, tolerance) && equals(frames[2], color.g, tolerance) &&
+			   equals(frames[3], color.b, tolerance) && equals(frames[4], color.a, tolerance);
+	}
+	if (rtti.isExactly(RGBTimeline::rtti)) {
+		Color &color = skeletonData.getSlots()[static_cast<RGBTimeline &>(timeline).getSlotIndex()]->getColor();
+		return equals(frames[1], color.r, tolerance) && equals(frames[2], color.g, tolerance) &&
+			   equals(frames[3], color.b, tolerance);
+	}
+	if (rtti.isExactly(AlphaTimeline::rtti)) {
+		Color &color = skeletonData.getSlots()[static_cast<AlphaTimeline &>(timeline).getSlotIndex()]->getColor();
+		return equals(frames[1], color.a, tolerance);
+	}
+	if (rtti.isExactly(RGBA2Timeline::rtti)) {
+		SlotData &slot = *skeletonData.getSlots()[static_cast<RGBA2Timeline &>(timeline).getSlotIndex()];
+		Color &color = slot.getColor(), &dark = slot.getDarkColor();
+		return equals(frames[1], color.r, tolerance) && equals(frames[2], color.g, tolerance) &&
+			   equals(frames[3], color.b, tolerance) && equals(frames[4], color.a, tolerance) &&
+			   equals(frames[5], dark.r, tolerance) && equals(frames[6], dark.g, tolerance) &&
+			   equals(frames[7], dark.b, tolerance);
+	}
+	if (rtti.isExactly(RGB2Timeline::rtti)) {
+		SlotData &slot = *skeletonData.getSlots()[static_cast<RGB2Timeline &>(timeline).getSlotIndex()];
+		Color &color = slot.getColor(), &dark = slot.getDarkColor();
+		return equals(frames[1], color.r, tolerance) && equals(frames[2], color.g, tolerance) &&
+			   equals(frames[3], color.b, tolerance) && equals(frames[4], dark.r, tolerance) &&
+			   equals(frames[5], dark.g, tolerance) && equals(frames[6], dark.b, tolerance);
+	}
+
+	// Constraint timelines are absolute.
+	if (rtti.isExactly(TransformConstraintTimeline::rtti)) {
+		int index = static_cast<TransformConstraintTimeline &>(timeline).getTransformConstraintIndex();
+		TransformConstraintData &data = *skeletonData.getTransformConstraints()[index];
+		return equals(frames[1], data.getMixRotate(), tolerance) && equals(frames[2], data.getMixX(), tolerance) &&
+			   equals(frames[3], data.getMixY(), tolerance) && equals(frames[4], data.getMixScaleX(), tolerance) &&
+			   equals(frames[5], data.getMixScaleY(), tolerance) && equals(frames[6], data.getMixShearY(), tolerance);
+	}
+	if (rtti.isExactly(PathConstraintMixTimeline::rtti)) {
+		int index = static_cast<PathConstraintMixTimeline &>(timeline).getPathConstraintIndex();
+		PathConstraintData &data = *skeletonData.getPathConstraints()[index];
+		return equals(frames[1], data.getMixRotate(), tolerance) && equals(frames[2], data.getMixX(), tolerance) &&
+			   equals(frames[3], data.getMixY(), tolerance);
+	}
+	if (rtti.isExactly(PathConstraintPositionTimeline::rtti)) {
+		int index = static_cast<PathConstraintPositionTimeline &>(timeline).getPathConstraintIndex();
+		return equals(frames[1], skeletonData.getPathConstraints()[index]->getPosition(), tolerance);
+	}
+	if (rtti.isExactly(PathConstraintSpacingTimeline::rtti)) {
+		int index = static_cast<PathConstraintSpacingTimeline &>(timeline).getPathConstraintIndex();
+		return equals(frames[1], skeletonData.getPathConstraints()[index]->getSpacing(), tolerance);
+	}
+	return false;
+}
+
+void AnimationOptimizer::markRemovableFrames(CurveTimeline &timeline, float tolerance) {
+	Vector<float> &frames = timeline._frames;
+	Vector<float> &curves = timeline._curves;
+	size_t entries = timeline.getFrameEntries(), frameCount = timeline.getFrameCount();
+	_keep.clear();
+	_keep.setSize(frameCount, true);
+
+	// A frame can be dropped if the segments on both sides are linear and interpolating from the last kept frame to the next
+	// frame reproduces it, and every frame dropped since the last kept one, within the tolerance.
+	size_t anchor = 0;
+	for (size_t frame = 1; frame + 1 < frameCount; frame++) {
+		bool removable = (int) curves[frame - 1] == CurveTimeline::LINEAR && (int) curves[frame] == CurveTimeline::LINEAR;
+		if (removable) {
+			size_t a = anchor * entries, b = (frame + 1) * entries;
+			float startTime = frames[a], duration = frames[b] - startTime;
+			for (size_t k = anchor + 1; k <= frame && removable; k++) {
+				size_t i = k * entries;
+				float t = duration > 0 ? (frames[i] - startTime) / duration : 0;
+				for (size_t v = 1; v < entries; v++) {
+					float value = frames[a + v] + (frames[b + v] - frames[a + v]) * t;
+					if (MathUtil::abs(value - frames[i + v]) > tolerance) {
+						removable = false;
+						break;
+					}
+				}
+			}
+		}
+		if (removable)
+			_keep[frame] = false;
+		else
+			anchor = frame;
+	}
+}
+
+void AnimationOptimizer::compact(CurveTimeline &timeline) {
+	Vector<float> &frames = timeline._frames;
+	Vector<float> &curves = timeline._curves;
+	size_t entries = timeline.getFrameEntries(), frameCount = timeline.getFrameCount();
+	size_t bezierSize = (entries - 1) * CurveTimeline::BEZIER_SIZE;
+
+	size_t keptCount = 0, bezierCount = 0, lastKept = 0;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		if (!_keep[frame]) continue;
+		keptCount++;
+		lastKept = frame;
+		if ((int) curves[frame] >= CurveTimeline::BEZIER) bezierCount++;
+	}
+	if (keptCount == frameCount) return;
+	// The last frame's curve is never read, it is stepped like the loaders leave it.
+	if ((int) curves[lastKept] >= CurveTimeline::BEZIER) bezierCount--;
+
+	// Rebuild the curves, moving the bezier samples of kept frames behind the new frame count.
+	_scratch.clear();
+	_scratch.setSize(keptCount + bezierCount * bezierSize, 0);
+	size_t bezier = keptCount;
+	for (size_t frame = 0, kept = 0; frame < frameCount; frame++) {
+		if (!_keep[frame]) continue;
+		int curveType = frame == lastKept ? CurveTimeline::STEPPED : (int) curves[frame];
+		if (curveType >= CurveTimeline::BEZIER) {
+			size_t source = curveType - CurveTimeline::BEZIER;
+			for (size_t i = 0; i < bezierSize; i++)
+				_scratch[bezier + i] = curves[source + i];
+			_scratch[kept] = (float) (CurveTimeline::BEZIER + bezier);
+			bezier += bezierSize;
+		} else {
+			_scratch[kept] = (float) curveType;
+		}
+
+		if (kept != frame) {
+			for (size_t v = 0; v < entries; v++)
+				frames[kept * entries + v] = frames[frame * entries + v];
+		}
+		kept++;
+	}
+
+	frames.setSize(keptCount * entries, 0);
+	frames.shrink();
+	curves.clear();
+	curves.setSize(_scratch.size(), 0);
+	for (size_t i = 0, n = _scratch.size(); i < n; i++)
+		curves[i] = _scratch[i];
+	curves.shrink();
+}
+
+void AnimationOptimizer::saveOriginal(CurveTimeline &timeline) {
+	Vector<float> &frames = timeline._frames;
+	Vector<float> &curves = timeline._curves;
+	_originalFrames.clear();
+	_originalFrames.addAll(frames);
+	_originalCurves.clear();
+	_originalCurves.addAll(curves);
+
+	// Sample each key and three points between it and the next key, enough to catch a bezier segment that was dropped.
+	size_t entries = timeline.getFrameEntries(), frameCount = timeline.getFrameCount();
+	_sampleTimes.clear();
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float time = frames[frame * entries];
+		_sampleTimes.add(time);
+		if (frame + 1 == frameCount) break;
+		float duration = frames[(frame + 1) * entries] - time;
+		for (int i = 1; i < 4; i++)
+			_sampleTimes.add(time + duration * i / 4);
+	}
+	_samples.clear();
+	for (size_t i = 0, n = _sampleTimes.size(); i < n; i++) {
+		for (size_t v = 1; v < entries; v++)
+			_samples.add(sample(timeline, _sampleTimes[i], v));
+	}
+}
+
+bool AnimationOptimizer::matchesOriginal(CurveTimeline &timeline, float tolerance) {
+	size_t entries = timeline.getFrameEntries();
+	float maxError = 0;
+	for (size_t i = 0, s = 0, n = _sampleTimes.size(); i < n; i++) {
+		for (size_t v = 1; v < entries; v++, s++) {
+			float original = _samples[s], error = MathUtil::abs(sample(timeline, _sampleTimes[i], v) - original);
+			// Allow for rounding, which grows with the size of the values being interpolated.
+			if (error > tolerance + MathUtil::abs(original) * 0.000001f) return false;
+			if (tolerance > 0 && error / tolerance > maxError) maxError = error / tolerance;
+		}
+	}
+	if (maxError > _maxError) _maxError = maxError;
+	return true;
+}
+
+void AnimationOptimizer::restoreOriginal(CurveTimeline &timeline) {
+	timeline._frames.clear();
+	timeline._frames.addAll(_originalFrames);
+	timeline._frames.shrink();
+	timeline._curves.clear();
+	timeline._curves.addAll(_originalCurves);
+	timeline._curves.shrink();
+}
+
+float AnimationOptimizer::sample(CurveTimeline &timeline, float time, size_t value) {
+	Vector<float> &frames = timeline._frames;
+	size_t entries = timeline.getFrameEntries();
+	size_t i = (size_t) Animation::search(frames, time, (int) entries);
+	if (i + entries >= frames.size()) return frames[i + value];
+	int curveType = (int) timeline._curves[i / entries];
+	switch (curveType) {
+		case CurveTimeline::LINEAR: {
+			float before = frames[i], start = frames[i + value];
+			return start + (time - before) / (frames[i + entries] - before) * (frames[i + entries + value] - start);
+		}
+		case CurveTimeline::STEPPED:
+			return frames[i + value];
+		default:
+			return timeline.getBezierValue(time, i, value,
+										   curveType - CurveTimeline::BEZIER + (value - 1) * CurveTimeline::BEZIER_SIZE);
+	}
+}
+
+void AnimationOptimizer::compact(DeformTimeline &timeline) {
+	if (timeline.isCompact()) return;
+	Vector<Vector<float>> &vertices = timeline.getVertices();
+	float min = 0, max = 0;
+	bool first = true;
+	for (size_t i = 0, n = vertices.size(); i < n; i++) {
+		Vector<float> &frame = vertices[i];
+		for (size_t ii = 0, nn = frame.size(); ii < nn; ii++) {
+			float value = frame[ii];
+			if (first) {
+				min = max = value;
+				first = false;
+			} else if (value < min)
+				min = value;
+			else if (value > max)
+				max = value;
+		}
+	}
+	bool quantize = (max - min) / 65535 * 0.5f <= _deformTolerance;
+
+	size_t bytes = timeline.getVerticesMemory();
+	timeline.compact(quantize);
+	if (timeline.isQuantized()) _timelinesQuantized++;
+	size_t compactBytes = timeline.getVerticesMemory();
+	if (compactBytes < bytes) _bytesSaved += bytes - compactBytes;
+}
@@ -60,7 +60,7 @@ TrackEntry::TrackEntry() : _animation(NULL), _previous(NULL), _next(NULL), _mixi
 						   _animationEnd(0), _animationLast(0), _nextAnimationLast(0), _delay(0), _trackTime(0),
 						   _trackLast(0), _nextTrackLast(0), _trackEnd(0), _timeScale(1.0f), _alpha(0), _mixTime(0),
 						   _mixDuration(0), _interruptAlpha(0), _totalAlpha(0), _mixBlend(MixBlend_Replace),
-						   _listener(dummyOnAnimationEventFunc), _listenerObject(NULL) {
+						   _listener(dummyOnAnimationEventFunc), _listenerObject(NULL), _state(NULL) {
 }
 
 TrackEntry::~TrackEntry() {}
@@ -73,45 +73,46 @@ TrackEntry *TrackEntry::getPrevious() { return _previous; }
 
 bool TrackEntry::getLoop() { return _loop; }
 
-void TrackEntry::setLoop(bool inValue) { _loop = inValue; }
+void TrackEntry::setLoop(bool inValue) { _loop = inValue; changed(); }
 
 bool TrackEntry::getHoldPrevious() { return _holdPrevious; }
 
-void TrackEntry::setHoldPrevious(bool inValue) { _holdPrevious = inValue; }
+void TrackEntry::setHoldPrevious(bool inValue) { _holdPrevious = inValue; changed(); }
 
 bool TrackEntry::getReverse() { return _reverse; }
 
-void TrackEntry::setReverse(bool inValue) { _reverse = inValue; }
+void TrackEntry::setReverse(bool inValue) { _reverse = inValue; changed(); }
 
 bool TrackEntry::getShortestRotation() { return _shortestRotation; }
 
-void TrackEntry::setShortestRotation(bool inValue) { _shortestRotation = inValue; }
+void TrackEntry::setShortestRotation(bool inValue) { _shortestRotation = inValue; changed(); }
 
 float TrackEntry::getDelay() { return _delay; }
 
-void TrackEntry::setDelay(float inValue) { _delay = inValue; }
+void TrackEntry::setDelay(float inValue) { _delay = inValue; changed(); }
 
 float TrackEntry::getTrackTime() { return _trackTime; }
 
-void TrackEntry::setTrackTime(float inValue) { _trackTime = inValue; }
+void TrackEntry::setTrackTime(float inValue) { _trackTime = inValue; changed(); }
 
 float TrackEntry::getTrackEnd() { return _trackEnd; }
 
-void TrackEntry::setTrackEnd(float inValue) { _trackEnd = inValue; }
+void TrackEntry::setTrackEnd(float inValue) { _trackEnd = inValue; changed(); }
 
 float TrackEntry::getAnimationStart() { return _animationStart; }
 
-void TrackEntry::setAnimationStart(float inValue) { _animationStart = inValue; }
+void TrackEntry::setAnimationStart(float inValue) { _animationStart = inValue; changed(); }
 
 float TrackEntry::getAnimationEnd() { return _animationEnd; }
 
-void TrackEntry::setAnimationEnd(float inValue) { _animationEnd = inValue; }
+void TrackEntry::setAnimationEnd(float inValue) { _animationEnd = inValue; changed(); }
 
 float TrackEntry::getAnimationLast() { return _animationLast; }
 
 void TrackEntry::setAnimationLast(float inValue) {
 	_animationLast = inValue;
 	_nextAnimationLast = inValue;
+	changed();
 }
 
 float TrackEntry::getAnimationTime() {
@@ -126,11 +127,11 @@ float TrackEntry::getAnimationTime() {
 
 float TrackEntry::getTimeScale() { return _timeScale; }
 
-void TrackEntry::setTimeScale(float inValue) { _timeScale = inValue; }
+void TrackEntry::setTimeScale(float inValue) { _timeScale = inValue; changed(); }
 
 float TrackEntry::getAlpha() { return _alpha; }
 
-void TrackEntry::setAlpha(float inValue) { _alpha = inValue; }
+void TrackEntry::setAlpha(float inValue) { _alpha = inValue; changed(); }
 
 float TrackEntry::getEventThreshold() { return _eventThreshold; }
 
@@ -138,11 +139,11 @@ void TrackEntry::setEventThreshold(float inValue) { _eventThreshold = inValue; }
 
 float TrackEntry::getAttachmentThreshold() { return _attachmentThreshold; }
 
-void TrackEntry::setAttachmentThreshold(float inValue) { _attachmentThreshold = inValue; }
+void TrackEntry::setAttachmentThreshold(float inValue) { _attachmentThreshold = inValue; changed(); }
 
 float TrackEntry::getDrawOrderThreshold() { return _drawOrderThreshold; }
 
-void TrackEntry::setDrawOrderThreshold(float inValue) { _drawOrderThreshold = inValue; }
+void TrackEntry::setDrawOrderThreshold(float inValue) { _drawOrderThreshold = inValue; changed(); }
 
 TrackEntry *TrackEntry::getNext() { return _next; }
 
@@ -152,22 +153,30 @@ bool TrackEntry::isComplete() {
 
 float TrackEntry::getMixTime() { return _mixTime; }
 
-void TrackEntry::setMixTime(float inValue) { _mixTime = inValue; }
+void TrackEntry::setMixTime(float inValue) { _mixTime = inValue; changed(); }
 
 float TrackEntry::getMixDuration() { return _mixDuration; }
 
-void TrackEntry::setMixDuration(float inValue) { _mixDuration = inValue; }
+void TrackEntry::setMixDuration(float inValue) { _mixDuration = inValue; changed(); }
 
 TrackEntry *TrackEntry::getMixingFrom() { return _mixingFrom; }
 
 TrackEntry *TrackEntry::getMixingTo() { return _mixingTo; }
 
-void TrackEntry::setMixBlend(MixBlend blend) { _mixBlend = blend; }
+void TrackEntry::setMixBlend(MixBlend blend) {
+	_mixBlend = blend;
+	changed();
+}
 
 MixBlend TrackEntry::getMixBlend() { return _mixBlend; }
 
 void TrackEntry::resetRotationDirections() {
 	_timelinesRotation.clear();
+	changed();
+}
+
+void TrackEntry::changed() {
+	if (_state) _state->_version++;
 }
 
 void TrackEntry::setListener(AnimationStateListener inValue) {
@@ -229,6 +238,7 @@ EventQueue::~EventQueue() {
 void EventQueue::start(TrackEntry *entry) {
 	_eventQueueEntries.add(newEventQueueEntry(EventType_Start, entry));
 	_state._animationsChanged = true;
+	_state._version++;
 }
 
 void EventQueue::interrupt(TrackEntry *entry) {
@@ -238,6 +248,7 @@ void EventQueue::interrupt(TrackEntry *entry) {
 void EventQueue::end(TrackEntry *entry) {
 	_eventQueueEntries.add(newEventQueueEntry(EventType_End, entry));
 	_state._animationsChanged = true;
+	_state._version++;
 }
 
 void EventQueue::dispose(TrackEntry *entry) {
@@ -319,7 +330,8 @@ AnimationState::AnimationState(AnimationStateData *data) : _data(data),
 														   _listenerObject(NULL),
 														   _unkeyedState(0),
 														   _timeScale(1),
-														   _manualTrackEntryDisposal(false) {
+														   _manualTrackEntryDisposal(false),
+														   _version(0) {
 }
 
 AnimationState::~AnimationState() {
@@ -353,6 +365,7 @@ void AnimationState::update(float delta) {
 		}
 
 		TrackEntry &current = *currentP;
+		if (delta != 0) _version++;
 
 		current._animationLast = current._nextAnimationLast;
 		current._trackLast = current._nextTrackLast;
@@ -491,11 +504,12 @@ bool AnimationState::apply(Skeleton &skeleton) {
 	for (int i = 0, n = (int) slots.size(); i < n; i++) {
 		Slot *slot = slots[i];
 		if (slot->getAttachmentState() == setupState) {
-			const String &attachmentName = slot->getData().getAttachmentName();
-			slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), attachmentName));
+			SlotData &data = slot->getData();
+			slot->setAttachment(skeleton.getAttachment(data.getIndex(), data.getAttachmentName(), data.getAttachmentNameId()));
 		}
 	}
 	_unkeyedState += 2;
+	if (applied) skeleton.markPoseChanged();
 
 	_queue->drain();
 	return applied;
@@ -669,6 +683,10 @@ void AnimationState::setManualTrackEntryDisposal(bool inValue) {
 	_manualTrackEntryDisposal = inValue;
 }
 
+unsigned int AnimationState::getVersion() {
+	return _version;
+}
+
 bool AnimationState::getManualTrackEntryDisposal() {
 	return _manualTrackEntryDisposal;
 }
@@ -692,10 +710,12 @@ void AnimationState::applyAttachmentTimeline(AttachmentTimeline *attachmentTimel
 	Vector<float> &frames = attachmentTimeline->getFrames();
 	if (time < frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), attachments);
+			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), slot->getData().getAttachmentNameId(),
+						  attachments);
 	} else {
-		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[Animation::search(frames, time)],
-					  attachments);
+		int frame = Animation::search(frames, time);
+		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frame],
+					  attachmentTimeline->getAttachmentNameId(skeleton.getData(), frame), attachments);
 	}
 
 	/* If an attachment wasn't set (ie before the first frame or attachments is false), set the setup attachment later.*/
@@ -893,9 +913,9 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	return mix;
 }
 
-void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, bool attachments) {
-	slot.setAttachment(
-			attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName));
+void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, int attachmentNameId,
+								   bool attachments) {
+	slot.setAttachment(skeleton.getAttachment(slot.getData().getIndex(), attachmentName, attachmentNameId));
 	if (attachments) slot.setAttachmentState(_unkeyedState + Current);
 }
 
@@ -963,6 +983,7 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry *entryP = _trackEntryPool.obtain();// Pooling
 	TrackEntry &entry = *entryP;
 
+	entry._state = this;
 	entry._trackIndex = (int) trackIndex;
 	entry._animation = animation;
 	entry._loop = loop;
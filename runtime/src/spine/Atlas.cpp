@@ -35,7 +35,10 @@
 
 using namespace spine;
 
-Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader) {
+Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader),
+																						   _loadTexturesOnDemand(false),
+																						   _indexedBuffer(NULL),
+																						   _indexedRegions(0) {
 	int dirLength;
 	char *dir;
 	int length;
@@ -61,8 +64,10 @@ Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTextur
 }
 
 Atlas::Atlas(const char *data, int length, const char *dir, TextureLoader *textureLoader, bool createTexture)
-	: _textureLoader(
-			  textureLoader) {
+	: _textureLoader(textureLoader),
+	  _loadTexturesOnDemand(false),
+	  _indexedBuffer(NULL),
+	  _indexedRegions(0) {
 	load(data, length, dir, createTexture);
 }
 
@@ -85,12 +90,82 @@ void Atlas::flipV() {
 	}
 }
 
+static unsigned int hashName(const char *chars, size_t length) {
+	// FNV-1a
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= (unsigned char) chars[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+void Atlas::buildRegionIndex() {
+	size_t tableSize = 16;
+	while (tableSize < _regions.size() * 2)
+		tableSize <<= 1;
+	_regionIndex.clear();
+	_regionIndex.setSize(tableSize, -1);
+
+	size_t mask = tableSize - 1;
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		const String &name = _regions[i]->name;
+		size_t slot = hashName(name.buffer(), name.length()) & mask;
+		while (true) {
+			int index = _regionIndex[slot];
+			if (index == -1) {
+				_regionIndex[slot] = (int) i;
+				break;
+			}
+			// Keep the first region with a given name.
+			if (_regions[index]->name == name) break;
+			slot = (slot + 1) & mask;
+		}
+	}
+	_indexedBuffer = _regions.buffer();
+	_indexedRegions = _regions.size();
+}
+
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
+	if (_indexedBuffer != _regions.buffer() || _indexedRegions != _regions.size() || _regionIndex.size() == 0)
+		buildRegionIndex();
+
+	size_t mask = _regionIndex.size() - 1;
+	size_t slot = hashName(name.buffer(), name.length()) & mask;
+	while (true) {
+		int index = _regionIndex[slot];
+		if (index == -1) break;
+		if (_regions[index]->name == name) return _regions[index];
+		slot = (slot + 1) & mask;
+	}
+
+	// A region replaced or renamed in place leaves the storage and size unchanged, so the index may be stale.
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		if (_regions[i]->name == name) {
+			buildRegionIndex();
+			return _regions[i];
+		}
+	}
 	return NULL;
 }
 
+void Atlas::loadTexture(AtlasPage &page) {
+	if (page.texture || !_textureLoader || page.texturePath.isEmpty()) return;
+	_textureLoader->load(page, page.texturePath);
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		AtlasRegion *region = _regions[i];
+		if (region->page == &page && !region->rendererObject) region->rendererObject = page.texture;
+	}
+}
+
+void Atlas::setLoadTexturesOnDemand(bool loadTexturesOnDemand) {
+	_loadTexturesOnDemand = loadTexturesOnDemand;
+}
+
+bool Atlas::getLoadTexturesOnDemand() {
+	return _loadTexturesOnDemand;
+}
+
 Vector<AtlasPage *> &Atlas::getPages() {
 	return _pages;
 }
@@ -257,7 +332,8 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			memcpy(path, dir, dirLength);
 			if (needsSlash) path[dirLength] = '/';
 			strcpy(path + dirLength + needsSlash, name);
-			page = new (__FILE__, __LINE__) AtlasPage(String(name, true));
+			page = new (__FILE__, __LINE__) AtlasPage(String());
+			page->name.own(name);
 
 			while (true) {
 				line = reader.readLine();
@@ -280,19 +356,16 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				}
 			}
 
-			if (createTexture) {
-				if (_textureLoader) _textureLoader->load(*page, String(path));
-				SpineExtension::free(path, __FILE__, __LINE__);
-			} else {
-				page->texturePath = String(path, true);
-			}
+			// The path is kept for texture loaders that read the image again, see TextureLoader::readPixels().
+			page->texturePath = String(path, true);
+			if (createTexture && _textureLoader) _textureLoader->load(*page, page->texturePath);
 			page->index = (int) _pages.size();
 			_pages.add(page);
 		} else {
 			AtlasRegion *region = new (__FILE__, __LINE__) AtlasRegion();
 			region->page = page;
 			region->rendererObject = page->texture;
-			region->name = String(line->copy(), true);
+			region->name.own(line->copy());
 			while (true) {
 				line = reader.readLine();
 				int count = reader.readEntry(entry, line);
@@ -328,7 +401,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				} else if (entry[0].equals("index")) {
 					region->index = entry[1].toInt();
 				} else {
-					region->names.add(String(entry[0].copy()));
+					region->names.add(String(entry[0].copy(), true));
 					for (int i = 0; i < count; i++) {
 						region->values.add(entry[i + 1].toInt());
 					}
@@ -351,4 +424,6 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			_regions.add(region);
 		}
 	}
+
+	buildRegionIndex();
 }
@@ -48,8 +48,10 @@ namespace spine {
 		Vector<TextureRegion *> &regions = sequence->getRegions();
 		for (int i = 0, n = (int) regions.size(); i < n; i++) {
 			String path = sequence->getPath(basePath, i);
-			regions[i] = atlas->findRegion(path);
-			if (!regions[i]) return false;
+			AtlasRegion *region = atlas->findRegion(path);
+			if (!region) return false;
+			if (atlas->getLoadTexturesOnDemand()) atlas->loadTexture(*region->page);
+			regions[i] = region;
 			regions[i]->rendererObject = regions[i];
 		}
 		return true;
@@ -107,7 +109,9 @@ namespace spine {
 	}
 
 	AtlasRegion *AtlasAttachmentLoader::findRegion(const String &name) {
-		return _atlas->findRegion(name);
+		AtlasRegion *region = _atlas->findRegion(name);
+		if (region && _atlas->getLoadTexturesOnDemand()) _atlas->loadTexture(*region->page);
+		return region;
 	}
 
 }// namespace spine
@@ -43,7 +43,8 @@ using namespace spine;
 RTTI_IMPL(AttachmentTimeline, Timeline)
 
 AttachmentTimeline::AttachmentTimeline(size_t frameCount, int slotIndex) : Timeline(frameCount, 1),
-																		   _slotIndex(slotIndex) {
+																		   _slotIndex(slotIndex),
+																		   _attachmentNameData(NULL) {
 	PropertyId ids[] = {((PropertyId) Property_Attachment << 32) | slotIndex};
 	setPropertyIds(ids, 1);
 
@@ -55,8 +56,8 @@ AttachmentTimeline::AttachmentTimeline(size_t frameCount, int slotIndex) : Timel
 
 AttachmentTimeline::~AttachmentTimeline() {}
 
-void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName) {
-	slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName, int attachmentNameId) {
+	slot.setAttachment(skeleton.getAttachment(_slotIndex, *attachmentName, attachmentNameId));
 }
 
 void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
@@ -69,32 +70,39 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 	if (!slot->_bone._active) return;
 
 	if (direction == MixDirection_Out) {
-		if (blend == MixBlend_Setup) setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+		if (blend == MixBlend_Setup) setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameId);
 		return;
 	}
 
 	if (time < _frames[0]) {
 		// Time is before first frame.
 		if (blend == MixBlend_Setup || blend == MixBlend_First) {
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameId);
 		}
 		return;
 	}
 
 	if (time < _frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, &slot->_data._attachmentName, slot->_data._attachmentNameId);
 		return;
 	}
 
-	setAttachment(skeleton, *slot, &_attachmentNames[Animation::search(_frames, time)]);
+	int frame = Animation::search(_frames, time);
+	setAttachment(skeleton, *slot, &_attachmentNames[frame], getAttachmentNameId(skeleton._data, frame));
 }
 
 void AttachmentTimeline::setFrame(int frame, float time, const String &attachmentName) {
 	_frames[frame] = time;
 	_attachmentNames[frame] = attachmentName;
+	if (_attachmentNameIds.size() > 0) _attachmentNameIds[frame] = -2;
 }
 
 Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
+
+int AttachmentTimeline::getAttachmentNameId(SkeletonData *skeletonData, int frame) {
+	if (skeletonData != _attachmentNameData) return -2;
+	return _attachmentNameIds[frame];
+}
@@ -70,6 +70,13 @@ Bone::Bone(BoneData &data, Skeleton &skeleton, Bone *parent) : Updatable(),
 															   _c(0),
 															   _d(1),
 															   _worldY(0),
+															   _lastA(1),
+															   _lastB(0),
+															   _lastWorldX(0),
+															   _lastC(0),
+															   _lastD(1),
+															   _lastWorldY(0),
+															   _worldVersion(0),
 															   _sorted(false),
 															   _active(false) {
 	setToSetupPose();
@@ -259,6 +266,8 @@ void Bone::rotateWorld(float degrees) {
 	_b = cos * b - sin * d;
 	_c = sin * a + cos * c;
 	_d = sin * b + cos * d;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getWorldToLocalRotationX() {
@@ -315,6 +324,7 @@ float Bone::getX() {
 
 void Bone::setX(float inValue) {
 	_x = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getY() {
@@ -323,6 +333,7 @@ float Bone::getY() {
 
 void Bone::setY(float inValue) {
 	_y = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getRotation() {
@@ -331,6 +342,7 @@ float Bone::getRotation() {
 
 void Bone::setRotation(float inValue) {
 	_rotation = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getScaleX() {
@@ -339,6 +351,7 @@ float Bone::getScaleX() {
 
 void Bone::setScaleX(float inValue) {
 	_scaleX = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getScaleY() {
@@ -347,6 +360,7 @@ float Bone::getScaleY() {
 
 void Bone::setScaleY(float inValue) {
 	_scaleY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getShearX() {
@@ -355,6 +369,7 @@ float Bone::getShearX() {
 
 void Bone::setShearX(float inValue) {
 	_shearX = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getShearY() {
@@ -363,6 +378,7 @@ float Bone::getShearY() {
 
 void Bone::setShearY(float inValue) {
 	_shearY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getAppliedRotation() {
@@ -427,6 +443,8 @@ float Bone::getA() {
 
 void Bone::setA(float inValue) {
 	_a = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getB() {
@@ -435,6 +453,8 @@ float Bone::getB() {
 
 void Bone::setB(float inValue) {
 	_b = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getC() {
@@ -443,6 +463,8 @@ float Bone::getC() {
 
 void Bone::setC(float inValue) {
 	_c = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getD() {
@@ -451,6 +473,8 @@ float Bone::getD() {
 
 void Bone::setD(float inValue) {
 	_d = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getWorldX() {
@@ -459,6 +483,8 @@ float Bone::getWorldX() {
 
 void Bone::setWorldX(float inValue) {
 	_worldX = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getWorldY() {
@@ -467,6 +493,8 @@ float Bone::getWorldY() {
 
 void Bone::setWorldY(float inValue) {
 	_worldY = inValue;
+	_worldVersion++;
+	_skeleton.markPoseChanged();
 }
 
 float Bone::getWorldRotationX() {
@@ -574,3 +602,19 @@ bool Bone::isActive() {
 void Bone::setActive(bool inValue) {
 	_active = inValue;
 }
+
+unsigned int Bone::getWorldVersion() {
+	return _worldVersion;
+}
+
+void Bone::updateWorldVersion() {
+	if (_a == _lastA && _b == _lastB && _worldX == _lastWorldX && _c == _lastC && _d == _lastD && _worldY == _lastWorldY)
+		return;
+	_lastA = _a;
+	_lastB = _b;
+	_lastWorldX = _worldX;
+	_lastC = _c;
+	_lastD = _d;
+	_lastWorldY = _worldY;
+	_worldVersion++;
+}
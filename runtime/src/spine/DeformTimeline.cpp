@@ -36,6 +36,8 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/Float4.h>
+#include <spine/MathUtil.h>
 #include <spine/Property.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -45,7 +47,8 @@ using namespace spine;
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
 DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIndex, VertexAttachment *attachment)
-	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment) {
+	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _frameVertexCount(0), _quantizeOffset(0),
+	  _quantizeScale(0), _attachment(attachment) {
 	PropertyId ids[] = {((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | attachment->_id) & 0xffffffff)};
 	setPropertyIds(ids, 1);
 
@@ -56,6 +59,110 @@ DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIn
 	}
 }
 
+namespace {
+	// Vertices are decoded from compact frames a block at a time, on the stack.
+	const size_t DECODE_BLOCK = 256;
+
+	// Blend operations on the frame value v, the current deform value d, the setup value s and alpha a. Each performs the same
+	// arithmetic on vertex positions or deform offsets as the scalar form it replaced.
+	struct SetOp {
+		static const bool usesSetup = false, usesDeform = false;
+
+		template<typename T>
+		static T blend(T v, T, T, T) { return v; }
+	};
+
+	struct SetAlphaOp {
+		static const bool usesSetup = false, usesDeform = false;
+
+		template<typename T>
+		static T blend(T v, T, T, T a) { return v * a; }
+	};
+
+	struct SetupMixOp {
+		static const bool usesSetup = true, usesDeform = false;
+
+		template<typename T>
+		static T blend(T v, T, T s, T a) { return s + (v - s) * a; }
+	};
+
+	struct MixOp {
+		static const bool usesSetup = false, usesDeform = true;
+
+		template<typename T>
+		static T blend(T v, T d, T, T a) { return d + (v - d) * a; }
+	};
+
+	struct AddOp {
+		static const bool usesSetup = false, usesDeform = true;
+
+		template<typename T>
+		static T blend(T v, T d, T, T) { return d + v; }
+	};
+
+	struct AddAlphaOp {
+		static const bool usesSetup = false, usesDeform = true;
+
+		template<typename T>
+		static T blend(T v, T d, T, T a) { return d + v * a; }
+	};
+
+	struct AddSetupOp {
+		static const bool usesSetup = true, usesDeform = true;
+
+		template<typename T>
+		static T blend(T v, T d, T s, T) { return d + (v - s); }
+	};
+
+	struct AddSetupAlphaOp {
+		static const bool usesSetup = true, usesDeform = true;
+
+		template<typename T>
+		static T blend(T v, T d, T s, T a) { return d + (v - s) * a; }
+	};
+
+	typedef void (*BlendVertices)(float *deform, const float *prev, const float *next, const float *setup, size_t count,
+								  float percent, float alpha);
+
+	/// Blends the previous frame, or the previous and next frames interpolated by percent, into the deform.
+	template<typename Op, bool interpolate>
+	void blendVertices(float *deform, const float *prev, const float *next, const float *setup, size_t count, float percent,
+					   float alpha) {
+		size_t i = 0;
+		Float4 percent4 = splat4(percent), alpha4 = splat4(alpha), zero4 = splat4(0);
+		for (; i + 4 <= count; i += 4) {
+			Float4 v = load4(prev + i);
+			if (interpolate) v = v + (load4(next + i) - v) * percent4;
+			Float4 d = Op::usesDeform ? load4(deform + i) : zero4;
+			Float4 s = Op::usesSetup ? load4(setup + i) : zero4;
+			store4(deform + i, Op::blend(v, d, s, alpha4));
+		}
+		for (; i < count; i++) {
+			float v = prev[i];
+			if (interpolate) v = v + (next[i] - v) * percent;
+			deform[i] = Op::blend(v, Op::usesDeform ? deform[i] : 0.0f, Op::usesSetup ? setup[i] : 0.0f, alpha);
+		}
+	}
+
+	/// Weighted attachments deform offsets from the setup pose, unweighted ones replace the vertex positions.
+	template<bool interpolate>
+	BlendVertices selectBlend(MixBlend blend, float alpha, bool weighted) {
+		if (alpha == 1) {
+			if (blend != MixBlend_Add) return blendVertices<SetOp, interpolate>;
+			return weighted ? blendVertices<AddOp, interpolate> : blendVertices<AddSetupOp, interpolate>;
+		}
+		switch (blend) {
+			case MixBlend_Setup:
+				return weighted ? blendVertices<SetAlphaOp, interpolate> : blendVertices<SetupMixOp, interpolate>;
+			case MixBlend_First:
+			case MixBlend_Replace:
+				return blendVertices<MixOp, interpolate>;
+			default:
+				return weighted ? blendVertices<AddAlphaOp, interpolate> : blendVertices<AddSetupAlphaOp, interpolate>;
+		}
+	}
+}
+
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 						   MixBlend blend, MixDirection direction) {
 	SP_UNUSED(lastTime);
@@ -77,12 +184,12 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	Vector<float> &deformArray = slot._deform;
+	slot.markDeformChanged();
 	if (deformArray.size() == 0) {
 		blend = MixBlend_Setup;
 	}
 
-	Vector<Vector<float>> &vertices = _vertices;
-	size_t vertexCount = vertices[0].size();
+	size_t vertexCount = getVertexCount();
 
 	Vector<float> &frames = _frames;
 	if (time < _frames[0]) {
@@ -116,144 +223,55 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
+	// A deform that was empty is always blended with MixBlend_Setup, which sets every value.
+	if (deformArray.size() == 0)
+		deformArray.setSizeUninitialized(vertexCount);
+	else
+		deformArray.setSize(vertexCount, 0);
+	float *deform = deformArray.buffer();
 
-	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
-		Vector<float> &lastVertices = vertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
-		} else {
-			switch (blend) {
-				case MixBlend_Setup: {
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, with alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deform[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						// Weighted deform offsets, with alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] = lastVertices[i] * alpha;
-					}
-					break;
-				}
-				case MixBlend_First:
-				case MixBlend_Replace:
-					// Vertex positions or deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - deform[i]) * alpha;
-					break;
-				case MixBlend_Add:
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, no alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-					} else {
-						// Weighted deform offsets, alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += lastVertices[i] * alpha;
-					}
-			}
-		}
+	size_t frame;
+	float percent = 0;
+	bool interpolate = time < frames[frames.size() - 1];
+	if (interpolate) {
+		frame = Animation::search(frames, time);
+		percent = getCurvePercent(time, (int) frame);
+	} else
+		frame = frames.size() - 1;
+	bool weighted = attachment->getBones().size() > 0;
+	BlendVertices blendFunction = interpolate ? selectBlend<true>(blend, alpha, weighted) : selectBlend<false>(blend, alpha, weighted);
+	const float *setupVertices = weighted ? NULL : attachment->getVertices().buffer();
+
+	const float *prevVertices = getDenseFrame(frame);
+	const float *nextVertices = interpolate ? getDenseFrame(frame + 1) : prevVertices;
+	if (prevVertices && nextVertices) {
+		blendFunction(deform, prevVertices, nextVertices, setupVertices, vertexCount, percent, alpha);
 		return;
 	}
 
-	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::search(frames, time);
-	float percent = getCurvePercent(time, frame);
-	Vector<float> &prevVertices = vertices[frame];
-	Vector<float> &nextVertices = vertices[frame + 1];
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
+	// Blocks outside the stored values of the frames equal the setup pose, so adding them changes nothing.
+	const float *base = weighted ? NULL : _attachment->getVertices().buffer();
+	size_t start = _frameStarts[frame], end = start + _frameOffsets[frame + 1] - _frameOffsets[frame];
+	if (interpolate) {
+		size_t nextStart = _frameStarts[frame + 1], nextEnd = nextStart + _frameOffsets[frame + 2] - _frameOffsets[frame + 1];
+		if (nextStart < nextEnd) {
+			if (start == end) {
+				start = nextStart;
+				end = nextEnd;
 			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
+				start = MathUtil::min(start, nextStart);
+				end = MathUtil::max(end, nextEnd);
 			}
 		}
-	} else {
-		switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-				}
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-		}
+	}
+	bool additive = blend == MixBlend_Add;
+	float prevBlock[DECODE_BLOCK], nextBlock[DECODE_BLOCK];
+	for (size_t i = 0; i < vertexCount; i += DECODE_BLOCK) {
+		size_t count = MathUtil::min(DECODE_BLOCK, vertexCount - i);
+		if (additive && (i + count <= start || i >= end)) continue;
+		decodeFrame(frame, i, count, base, prevBlock);
+		if (interpolate) decodeFrame(frame + 1, i, count, base, nextBlock);
+		blendFunction(deform + i, prevBlock, nextBlock, setupVertices ? setupVertices + i : NULL, count, percent, alpha);
 	}
 }
 
@@ -319,6 +337,116 @@ Vector<Vector<float>> &DeformTimeline::getVertices() {
 	return _vertices;
 }
 
+size_t DeformTimeline::getVertexCount() {
+	return _vertices.size() > 0 ? _vertices[0].size() : _frameVertexCount;
+}
+
+const float *DeformTimeline::getDenseFrame(size_t frame) {
+	if (_vertices.size() > 0) return _vertices[frame].buffer();
+	if (_quantizedVertices.size() > 0 || _frameStarts[frame] != 0 ||
+		_frameOffsets[frame + 1] - _frameOffsets[frame] != _frameVertexCount)
+		return NULL;
+	return _flatVertices.buffer() + _frameOffsets[frame];
+}
+
+void DeformTimeline::decodeFrame(size_t frame, size_t start, size_t count, const float *base, float *vertices) {
+	size_t end = start + count;
+	size_t storedStart = _frameStarts[frame], offset = _frameOffsets[frame];
+	size_t storedEnd = storedStart + _frameOffsets[frame + 1] - offset;
+	size_t i = start;
+	for (size_t n = MathUtil::min(storedStart, end); i < n; i++)
+		vertices[i - start] = base ? base[i] : 0;
+	size_t n = MathUtil::min(storedEnd, end);
+	if (_quantizedVertices.size() > 0) {
+		const unsigned short *quantized = _quantizedVertices.buffer() + offset - storedStart;
+		for (; i < n; i++)
+			vertices[i - start] = _quantizeOffset + quantized[i] * _quantizeScale;
+	} else {
+		const float *values = _flatVertices.buffer() + offset - storedStart;
+		for (; i < n; i++)
+			vertices[i - start] = values[i];
+	}
+	for (; i < end; i++)
+		vertices[i - start] = base ? base[i] : 0;
+}
+
+void DeformTimeline::getFrameVertices(size_t frame, Vector<float> &vertices) {
+	size_t vertexCount = getVertexCount();
+	vertices.setSize(vertexCount, 0);
+	if (_vertices.size() > 0) {
+		for (size_t i = 0; i < vertexCount; i++)
+			vertices[i] = _vertices[frame][i];
+	} else
+		decodeFrame(frame, 0, vertexCount, _attachment->getBones().size() > 0 ? NULL : _attachment->getVertices().buffer(),
+					vertices.buffer());
+}
+
+void DeformTimeline::compact(bool quantize) {
+	if (_vertices.size() > 0) {
+		size_t frameCount = _vertices.size();
+		_frameVertexCount = _vertices[0].size();
+		const float *base = _attachment->getBones().size() > 0 ? NULL : _attachment->getVertices().buffer();
+		_frameStarts.setSize(frameCount, 0);
+		_frameOffsets.setSize(frameCount + 1, 0);
+		_flatVertices.clear();
+		for (size_t i = 0; i < frameCount; i++) {
+			Vector<float> &vertices = _vertices[i];
+			size_t start = 0, end = vertices.size();
+			while (start < end && vertices[start] == (base ? base[start] : 0))
+				start++;
+			while (end > start && vertices[end - 1] == (base ? base[end - 1] : 0))
+				end--;
+			_frameStarts[i] = start;
+			_frameOffsets[i] = _flatVertices.size();
+			for (size_t ii = start; ii < end; ii++)
+				_flatVertices.add(vertices[ii]);
+		}
+		_frameOffsets[frameCount] = _flatVertices.size();
+		_flatVertices.shrink();
+		_vertices.clear();
+		_vertices.shrink();
+	}
+	if (!quantize || _quantizedVertices.size() > 0 || _flatVertices.size() == 0) return;
+
+	float min = _flatVertices[0], max = min;
+	for (size_t i = 1, n = _flatVertices.size(); i < n; i++) {
+		float value = _flatVertices[i];
+		if (value < min) min = value;
+		if (value > max) max = value;
+	}
+	_quantizeOffset = min;
+	_quantizeScale = (max - min) / 65535;
+	float inverseScale = _quantizeScale > 0 ? 1 / _quantizeScale : 0;
+	_quantizedVertices.setSize(_flatVertices.size(), 0);
+	for (size_t i = 0, n = _flatVertices.size(); i < n; i++) {
+		float value = (_flatVertices[i] - min) * inverseScale + 0.5f;
+		_quantizedVertices[i] = (unsigned short) (value > 65535 ? 65535 : value);
+	}
+	_quantizedVertices.shrink();
+	_flatVertices.clear();
+	_flatVertices.shrink();
+}
+
+bool DeformTimeline::isCompact() {
+	return _vertices.size() == 0;
+}
+
+bool DeformTimeline::isQuantized() {
+	return _quantizedVertices.size() > 0;
+}
+
+float DeformTimeline::getQuantizationError() {
+	return _quantizeScale * 0.5f;
+}
+
+size_t DeformTimeline::getVerticesMemory() {
+	size_t bytes = _vertices.getCapacity() * sizeof(Vector<float>);
+	for (size_t i = 0, n = _vertices.size(); i < n; i++)
+		bytes += _vertices[i].getCapacity() * sizeof(float);
+	bytes += (_frameStarts.getCapacity() + _frameOffsets.getCapacity()) * sizeof(size_t);
+	return bytes + _flatVertices.getCapacity() * sizeof(float) + _quantizedVertices.getCapacity() * sizeof(unsigned short);
+}
+
 VertexAttachment *DeformTimeline::getAttachment() {
 	return _attachment;
 }
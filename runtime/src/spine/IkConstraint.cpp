@@ -264,6 +264,7 @@ break_outer : {
 
 IkConstraint::IkConstraint(IkConstraintData &data, Skeleton &skeleton) : Updatable(),
 																		 _data(data),
+																		 _skeleton(skeleton),
 																		 _bendDirection(data.getBendDirection()),
 																		 _compress(data.getCompress()),
 																		 _stretch(data.getStretch()),
@@ -314,6 +315,7 @@ Bone *IkConstraint::getTarget() {
 
 void IkConstraint::setTarget(Bone *inValue) {
 	_target = inValue;
+	_skeleton.markPoseChanged();
 }
 
 int IkConstraint::getBendDirection() {
@@ -322,6 +324,7 @@ int IkConstraint::getBendDirection() {
 
 void IkConstraint::setBendDirection(int inValue) {
 	_bendDirection = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float IkConstraint::getMix() {
@@ -330,6 +333,7 @@ float IkConstraint::getMix() {
 
 void IkConstraint::setMix(float inValue) {
 	_mix = inValue;
+	_skeleton.markPoseChanged();
 }
 
 bool IkConstraint::getStretch() {
@@ -338,6 +342,7 @@ bool IkConstraint::getStretch() {
 
 void IkConstraint::setStretch(bool inValue) {
 	_stretch = inValue;
+	_skeleton.markPoseChanged();
 }
 
 bool IkConstraint::getCompress() {
@@ -346,6 +351,7 @@ bool IkConstraint::getCompress() {
 
 void IkConstraint::setCompress(bool inValue) {
 	_compress = inValue;
+	_skeleton.markPoseChanged();
 }
 
 bool IkConstraint::isActive() {
@@ -362,4 +368,5 @@ float IkConstraint::getSoftness() {
 
 void IkConstraint::setSoftness(float inValue) {
 	_softness = inValue;
+	_skeleton.markPoseChanged();
 }
@@ -28,6 +28,8 @@
  *****************************************************************************/
 
 #include <spine/MeshAttachment.h>
+#include <spine/ContainerUtil.h>
+#include <spine/Slot.h>
 
 using namespace spine;
 
@@ -41,10 +43,12 @@ MeshAttachment::MeshAttachment(const String &name) : VertexAttachment(name),
 													 _width(0),
 													 _height(0),
 													 _region(NULL),
-													 _sequence(NULL) {}
+													 _sequence(NULL),
+													 _lodError(0) {}
 
 MeshAttachment::~MeshAttachment() {
 	if (_sequence) delete _sequence;
+	ContainerUtil::cleanUpVectorOfPointers(_lods);
 }
 
 void MeshAttachment::updateRegion() {
@@ -52,63 +56,76 @@ void MeshAttachment::updateRegion() {
 		_uvs.setSize(_regionUVs.size(), 0);
 	}
 
-	if (_region == nullptr) {
+	if (_sequence) {
+		// Every frame is computed up front so drawing a frame never changes the attachment.
+		Vector<TextureRegion *> &regions = _sequence->getRegions();
+		size_t n = _regionUVs.size();
+		_sequenceUVs.setSize(regions.size() * n, 0);
+		for (size_t i = 0; i < regions.size(); i++)
+			computeUVs(regions[i], _sequenceUVs.buffer() + i * n);
+		_region = regions[_sequence->resolveIndex(-1)];
+	}
+	computeUVs(_region, _uvs.buffer());
+}
+
+void MeshAttachment::computeUVs(TextureRegion *region, float *uvs) {
+	if (region == nullptr) {
 		return;
 	}
 
 	int i = 0, n = (int) _regionUVs.size();
-	float u = _region->u, v = _region->v;
+	float u = region->u, v = region->v;
 	float width = 0, height = 0;
-	switch (_region->degrees) {
+	switch (region->degrees) {
 		case 90: {
-			float textureWidth = _region->height / (_region->u2 - _region->u);
-			float textureHeight = _region->width / (_region->v2 - _region->v);
-			u -= (_region->originalHeight - _region->offsetY - _region->height) / textureWidth;
-			v -= (_region->originalWidth - _region->offsetX - _region->width) / textureHeight;
-			width = _region->originalHeight / textureWidth;
-			height = _region->originalWidth / textureHeight;
+			float textureWidth = region->height / (region->u2 - region->u);
+			float textureHeight = region->width / (region->v2 - region->v);
+			u -= (region->originalHeight - region->offsetY - region->height) / textureWidth;
+			v -= (region->originalWidth - region->offsetX - region->width) / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i + 1] * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i]) * height;
+				uvs[i] = u + _regionUVs[i + 1] * width;
+				uvs[i + 1] = v + (1 - _regionUVs[i]) * height;
 			}
 			return;
 		}
 		case 180: {
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			u -= (_region->originalWidth - _region->offsetX - _region->width) / textureWidth;
-			v -= _region->offsetY / textureHeight;
-			width = _region->originalWidth / textureWidth;
-			height = _region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= (region->originalWidth - region->offsetX - region->width) / textureWidth;
+			v -= region->offsetY / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i]) * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i + 1]) * height;
+				uvs[i] = u + (1 - _regionUVs[i]) * width;
+				uvs[i + 1] = v + (1 - _regionUVs[i + 1]) * height;
 			}
 			return;
 		}
 		case 270: {
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			u -= _region->offsetY / textureWidth;
-			v -= _region->offsetX / textureHeight;
-			width = _region->originalHeight / textureWidth;
-			height = _region->originalWidth / textureHeight;
+			float textureHeight = region->height / (region->v2 - region->v);
+			float textureWidth = region->width / (region->u2 - region->u);
+			u -= region->offsetY / textureWidth;
+			v -= region->offsetX / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i + 1]) * width;
-				_uvs[i + 1] = v + _regionUVs[i] * height;
+				uvs[i] = u + (1 - _regionUVs[i + 1]) * width;
+				uvs[i + 1] = v + _regionUVs[i] * height;
 			}
 			return;
 		}
 		default: {
-			float textureWidth = _region->width / (_region->u2 - _region->u);
-			float textureHeight = _region->height / (_region->v2 - _region->v);
-			u -= _region->offsetX / textureWidth;
-			v -= (_region->originalHeight - _region->offsetY - _region->height) / textureHeight;
-			width = _region->originalWidth / textureWidth;
-			height = _region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= region->offsetX / textureWidth;
+			v -= (region->originalHeight - region->offsetY - region->height) / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i] * width;
-				_uvs[i + 1] = v + _regionUVs[i + 1] * height;
+				uvs[i] = u + _regionUVs[i] * width;
+				uvs[i + 1] = v + _regionUVs[i + 1] * height;
 			}
 		}
 	}
@@ -130,6 +147,11 @@ Vector<float> &MeshAttachment::getUVs() {
 	return _uvs;
 }
 
+float *MeshAttachment::getUVs(Slot &slot) {
+	if (_sequence == NULL || _sequenceUVs.size() == 0) return _uvs.buffer();
+	return _sequenceUVs.buffer() + _sequence->resolveIndex(slot.getSequenceIndex()) * _regionUVs.size();
+}
+
 Vector<unsigned short> &MeshAttachment::getTriangles() {
 	return _triangles;
 }
@@ -150,6 +172,11 @@ void MeshAttachment::setRegion(TextureRegion *region) {
 	_region = region;
 }
 
+TextureRegion *MeshAttachment::getRegion(Slot &slot) {
+	if (_sequence == NULL) return _region;
+	return _sequence->getRegions()[_sequence->resolveIndex(slot.getSequenceIndex())];
+}
+
 Sequence *MeshAttachment::getSequence() {
 	return _sequence;
 }
@@ -174,6 +201,7 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 		_edges.clearAndAddAll(inValue->_edges);
 		_width = inValue->_width;
 		_height = inValue->_height;
+		updateSkinning();
 	}
 }
 
@@ -213,13 +241,16 @@ Attachment *MeshAttachment::copy() {
 	copyTo(copy);
 	copy->_regionUVs.clearAndAddAll(_regionUVs);
 	copy->_uvs.clearAndAddAll(_uvs);
+	copy->_sequenceUVs.clearAndAddAll(_sequenceUVs);
 	copy->_triangles.clearAndAddAll(_triangles);
 	copy->_hullLength = _hullLength;
 
 	// Nonessential.
-	copy->_edges.clearAndAddAll(copy->_edges);
+	copy->_edges.clearAndAddAll(_edges);
 	copy->_width = _width;
 	copy->_height = _height;
+
+	copyLods(copy, false);
 	return copy;
 }
 
@@ -231,11 +262,46 @@ MeshAttachment *MeshAttachment::newLinkedMesh() {
 	copy->_timelineAttachment = this->_timelineAttachment;
 	copy->setParentMesh(_parentMesh ? _parentMesh : this);
 	if (copy->_region) copy->updateRegion();
+	copyLods(copy, true);
 	return copy;
 }
 
+void MeshAttachment::copyLods(MeshAttachment *copy, bool linked) {
+	// A linked level shares the vertices of this mesh's level, as the linked copy shares this mesh's, see
+	// MeshOptimizer::linkLods().
+	for (size_t i = 0, n = _lods.size(); i < n; ++i) {
+		MeshAttachment *lod = _lods[i];
+		MeshAttachment *lodCopy = linked ? lod->newLinkedMesh() : static_cast<MeshAttachment *>(lod->copy());
+		lodCopy->_timelineAttachment = copy->_timelineAttachment;
+		lodCopy->_lodDeform.clearAndAddAll(lod->_lodDeform);
+		lodCopy->_lodError = lod->_lodError;
+		copy->_lods.add(lodCopy);
+	}
+}
+
 void MeshAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 										  size_t stride) {
-	if (_sequence) _sequence->apply(&slot, this);
-	VertexAttachment::computeWorldVertices(slot, start, count, worldVertices, offset, stride);
+	Vector<float> &deform = slot.getDeform();
+	if (_lodDeform.size() == 0 || deform.size() == 0) {
+		VertexAttachment::computeWorldVertices(slot, start, count, worldVertices, offset, stride);
+		return;
+	}
+
+	// The slot's deform belongs to the full mesh, it is read through the index of each value this level kept. Nothing is
+	// written to the attachment, which skeletons on other threads may be drawing.
+	transformVertices(slot, deform, _lodDeform.buffer(), start, count, worldVertices, offset, stride);
+}
+
+Vector<MeshAttachment *> &MeshAttachment::getLods() {
+	return _lods;
+}
+
+float MeshAttachment::getLodError() {
+	return _lodError;
+}
+
+MeshAttachment *MeshAttachment::getLod(float maxError) {
+	for (int i = (int) _lods.size() - 1; i >= 0; i--)
+		if (_lods[i]->_lodError <= maxError) return _lods[i];
+	return this;
 }
@@ -0,0 +1,575 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/MeshOptimizer.h>
+
+#include <spine/Animation.h>
+#include <spine/Bone.h>
+#include <spine/DeformTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/Slot.h>
+
+#include <float.h>
+
+using namespace spine;
+
+namespace {
+	/// Removes vertices of a triangle mesh by collapsing them into a neighbour. The UVs decide which triangle a removed vertex
+	/// falls in and the positions measure how far the image moves there.
+	class MeshSimplifier {
+	public:
+		MeshSimplifier(Vector<float> &positions, Vector<float> &uvs, Vector<unsigned short> &triangles, int hullVertices)
+				: _positions(positions), _uvs(uvs) {
+			int vertexCount = (int) (uvs.size() >> 1);
+			_aliveCount = vertexCount;
+			_alive.setSize(vertexCount, true);
+			_locked.setSize(vertexCount, false);
+			_vertexTriangles.setSize(vertexCount, Vector<int>());
+			_removed.setSize(vertexCount, Vector<int>());
+			_cost.setSize(vertexCount, FLT_MAX);
+			_target.setSize(vertexCount, -1);
+			for (size_t i = 0, n = triangles.size(); i < n; i++) {
+				_triangles.add(triangles[i]);
+				_vertexTriangles[triangles[i]].add((int) (i / 3));
+			}
+			_triangleAlive.setSize(triangles.size() / 3, true);
+			for (int v = 0; v < vertexCount; v++)
+				_locked[v] = v < hullVertices || _vertexTriangles[v].size() == 0 || isBoundary(v);
+			for (int v = 0; v < vertexCount; v++)
+				updateCost(v);
+		}
+
+		/// Collapses the cheapest vertex until at most targetCount remain or no collapse is within maxError (0 for no limit).
+		/// Returns the number of vertices removed.
+		int simplify(int targetCount, float maxError) {
+			int removed = 0;
+			while (_aliveCount > targetCount) {
+				int best = -1;
+				float bestCost = FLT_MAX;
+				for (int v = 0, n = (int) _alive.size(); v < n; v++) {
+					if (_cost[v] < bestCost) {
+						best = v;
+						bestCost = _cost[v];
+					}
+				}
+				if (best == -1 || (maxError > 0 && bestCost > maxError)) break;
+				collapse(best, _target[best]);
+				removed++;
+			}
+			return removed;
+		}
+
+		/// The largest distance between a removed vertex and the point of the remaining triangles with its UV.
+		float computeError() {
+			float error = 0;
+			for (int u = 0, n = (int) _alive.size(); u < n; u++) {
+				Vector<int> &removed = _removed[u];
+				for (size_t i = 0, nn = removed.size(); i < nn; i++) {
+					float bestWeight = -FLT_MAX, x = 0, y = 0;
+					search(_vertexTriangles[u], removed[i], -1, -1, bestWeight, x, y);
+					if (bestWeight < -0.001f) search(allTriangles(), removed[i], -1, -1, bestWeight, x, y);
+					error = MathUtil::max(error, distance(removed[i], x, y));
+				}
+			}
+			return error;
+		}
+
+		Vector<bool> &getAlive() { return _alive; }
+
+		int getAliveCount() { return _aliveCount; }
+
+		/// Adds the remaining triangles, with each vertex replaced by its new index.
+		void getTriangles(Vector<int> &newIndex, Vector<unsigned short> &triangles) {
+			for (size_t t = 0, n = _triangleAlive.size(); t < n; t++) {
+				if (!_triangleAlive[t]) continue;
+				for (int i = 0; i < 3; i++)
+					triangles.add((unsigned short) newIndex[_triangles[t * 3 + i]]);
+			}
+		}
+
+	private:
+		Vector<float> &_positions;
+		Vector<float> &_uvs;
+		int _aliveCount;
+		Vector<int> _triangles;
+		Vector<bool> _triangleAlive;
+		Vector<bool> _alive;
+		Vector<bool> _locked;
+		Vector<Vector<int> > _vertexTriangles;
+		Vector<Vector<int> > _removed; // removed vertices last collapsed into the star of each vertex
+		Vector<float> _cost;
+		Vector<int> _target;
+		Vector<int> _neighbours;
+		Vector<int> _everyTriangle;
+
+		bool contains(int t, int v) {
+			return _triangles[t * 3] == v || _triangles[t * 3 + 1] == v || _triangles[t * 3 + 2] == v;
+		}
+
+		Vector<int> &allTriangles() {
+			_everyTriangle.clear();
+			for (size_t t = 0, n = _triangleAlive.size(); t < n; t++)
+				if (_triangleAlive[t]) _everyTriangle.add((int) t);
+			return _everyTriangle;
+		}
+
+		bool isBoundary(int v) {
+			Vector<int> &triangles = _vertexTriangles[v];
+			for (size_t i = 0, n = triangles.size(); i < n; i++) {
+				for (int k = 0; k < 3; k++) {
+					int x = _triangles[triangles[i] * 3 + k];
+					if (x == v) continue;
+					int shared = 0;
+					for (size_t ii = 0; ii < n; ii++)
+						if (contains(triangles[ii], x)) shared++;
+					if (shared == 1) return true;
+				}
+			}
+			return false;
+		}
+
+		float area(int a, int b, int c) {
+			float ax = _uvs[a << 1], ay = _uvs[(a << 1) + 1];
+			return (_uvs[b << 1] - ax) * (_uvs[(c << 1) + 1] - ay) - (_uvs[c << 1] - ax) * (_uvs[(b << 1) + 1] - ay);
+		}
+
+		float distance(int p, float x, float y) {
+			float dx = _positions[p << 1] - x, dy = _positions[(p << 1) + 1] - y;
+			return MathUtil::sqrt(dx * dx + dy * dy);
+		}
+
+		/// Finds the triangle that best contains the UV of p, with vertex v replaced by u. Triangles that have both v and u
+		/// are skipped, as the collapse removes them.
+		void search(Vector<int> &triangles, int p, int v, int u, float &bestWeight, float &x, float &y) {
+			float px = _uvs[p << 1], py = _uvs[(p << 1) + 1];
+			for (size_t i = 0, n = triangles.size(); i < n; i++) {
+				int t = triangles[i];
+				if (v != -1 && contains(t, v) && contains(t, u)) continue;
+				int a = _triangles[t * 3], b = _triangles[t * 3 + 1], c = _triangles[t * 3 + 2];
+				if (a == v) a = u;
+				if (b == v) b = u;
+				if (c == v) c = u;
+				float d = area(a, b, c);
+				if (d == 0) continue;
+				float ax = _uvs[a << 1], ay = _uvs[(a << 1) + 1];
+				float bx = _uvs[b << 1], by = _uvs[(b << 1) + 1];
+				float cx = _uvs[c << 1], cy = _uvs[(c << 1) + 1];
+				float la = ((bx - px) * (cy - py) - (cx - px) * (by - py)) / d;
+				float lb = ((cx - px) * (ay - py) - (ax - px) * (cy - py)) / d;
+				float lc = 1 - la - lb;
+				float weight = MathUtil::min(la, MathUtil::min(lb, lc));
+				if (weight <= bestWeight) continue;
+				bestWeight = weight;
+				x = la * _positions[a << 1] + lb * _positions[b << 1] + lc * _positions[c << 1];
+				y = la * _positions[(a << 1) + 1] + lb * _positions[(b << 1) + 1] + lc * _positions[(c << 1) + 1];
+			}
+		}
+
+		float pointError(int p, int v, int u) {
+			float bestWeight = -FLT_MAX, x = 0, y = 0;
+			search(_vertexTriangles[u], p, v, u, bestWeight, x, y);
+			search(_vertexTriangles[v], p, v, u, bestWeight, x, y);
+			return bestWeight == -FLT_MAX ? FLT_MAX : distance(p, x, y);
+		}
+
+		/// Returns the error of collapsing v into u, or FLT_MAX if the collapse would fold or tear the mesh.
+		float collapseCost(int v, int u) {
+			Vector<int> &trianglesV = _vertexTriangles[v], &trianglesU = _vertexTriangles[u];
+
+			// The vertices adjacent to both must be exactly those of the triangles on the edge, else the mesh tears.
+			int shared = 0;
+			_neighbours.clear();
+			for (size_t i = 0, n = trianglesV.size(); i < n; i++) {
+				int t = trianglesV[i];
+				if (contains(t, u)) shared++;
+				for (int k = 0; k < 3; k++) {
+					int x = _triangles[t * 3 + k];
+					if (x != v && x != u && !_neighbours.contains(x)) _neighbours.add(x);
+				}
+			}
+			int common = 0;
+			for (size_t i = 0, n = _neighbours.size(); i < n; i++) {
+				for (size_t ii = 0, nn = trianglesU.size(); ii < nn; ii++) {
+					if (contains(trianglesU[ii], _neighbours[i])) {
+						common++;
+						break;
+					}
+				}
+			}
+			if (common != shared) return FLT_MAX;
+
+			// The remaining triangles must not flip or become degenerate in UV space.
+			for (size_t i = 0, n = trianglesV.size(); i < n; i++) {
+				int t = trianglesV[i];
+				if (contains(t, u)) continue;
+				int a = _triangles[t * 3], b = _triangles[t * 3 + 1], c = _triangles[t * 3 + 2];
+				float before = area(a, b, c);
+				float after = area(a == v ? u : a, b == v ? u : b, c == v ? u : c);
+				if (before * after <= 0 || MathUtil::abs(after) < MathUtil::abs(before) * 0.001f) return FLT_MAX;
+			}
+
+			float error = pointError(v, v, u);
+			Vector<int> &removedV = _removed[v], &removedU = _removed[u];
+			for (size_t i = 0, n = removedV.size(); i < n; i++)
+				error = MathUtil::max(error, pointError(removedV[i], v, u));
+			for (size_t i = 0, n = removedU.size(); i < n; i++)
+				error = MathUtil::max(error, pointError(removedU[i], v, u));
+			return error;
+		}
+
+		void updateCost(int v) {
+			_cost[v] = FLT_MAX;
+			_target[v] = -1;
+			if (!_alive[v] || _locked[v]) return;
+			Vector<int> &triangles = _vertexTriangles[v];
+			for (size_t i = 0, n = triangles.size(); i < n; i++) {
+				for (int k = 0; k < 3; k++) {
+					int u = _triangles[triangles[i] * 3 + k];
+					if (u == v || u == _target[v]) continue;
+					float cost = collapseCost(v, u);
+					if (cost < _cost[v]) {
+						_cost[v] = cost;
+						_target[v] = u;
+					}
+				}
+			}
+		}
+
+		void collapse(int v, int u) {
+			Vector<int> &triangles = _vertexTriangles[v];
+			for (size_t i = 0, n = triangles.size(); i < n; i++) {
+				int t = triangles[i];
+				if (contains(t, u)) {
+					_triangleAlive[t] = false;
+					for (int k = 0; k < 3; k++) {
+						int x = _triangles[t * 3 + k];
+						if (x == v) continue;
+						Vector<int> &other = _vertexTriangles[x];
+						int index = other.indexOf(t);
+						if (index >= 0) other.removeAt(index);
+					}
+				} else {
+					for (int k = 0; k < 3; k++)
+						if (_triangles[t * 3 + k] == v) _triangles[t * 3 + k] = u;
+					_vertexTriangles[u].add(t);
+				}
+			}
+			triangles.clear();
+			_alive[v] = false;
+			_cost[v] = FLT_MAX;
+			_aliveCount--;
+			_removed[u].add(v);
+			_removed[u].addAll(_removed[v]);
+			_removed[v].clear();
+
+			updateCost(u);
+			Vector<int> &star = _vertexTriangles[u];
+			for (size_t i = 0, n = star.size(); i < n; i++) {
+				for (int k = 0; k < 3; k++) {
+					int x = _triangles[star[i] * 3 + k];
+					if (x != u) updateCost(x);
+				}
+			}
+		}
+	};
+}
+
+MeshOptimizer::MeshOptimizer() : _maxBones(0),
+								 _minWeight(0),
+								 _lodCount(0),
+								 _lodRatio(0.5f),
+								 _lodMinVertices(32),
+								 _lodMaxError(0),
+								 _meshesPruned(0),
+								 _meshesSkipped(0),
+								 _influencesBefore(0),
+								 _influencesAfter(0),
+								 _maxWeightRemoved(0),
+								 _maxPruneError(0),
+								 _lodsCreated(0),
+								 _lodVerticesBefore(0),
+								 _lodVerticesAfter(0),
+								 _maxLodError(0) {
+}
+
+void MeshOptimizer::resetStatistics() {
+	_meshesPruned = 0;
+	_meshesSkipped = 0;
+	_influencesBefore = 0;
+	_influencesAfter = 0;
+	_maxWeightRemoved = 0;
+	_maxPruneError = 0;
+	_lodsCreated = 0;
+	_lodVerticesBefore = 0;
+	_lodVerticesAfter = 0;
+	_maxLodError = 0;
+}
+
+void MeshOptimizer::optimize(SkeletonData &skeletonData) {
+	resetStatistics();
+
+	// Errors are measured in the setup pose, without constraints.
+	Skeleton skeleton(&skeletonData);
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; ++i)
+		bones[i]->updateWorldTransform();
+
+	Vector<MeshAttachment *> meshes;
+	Vector<int> slotIndices;
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	for (size_t i = 0, n = skins.size(); i < n; ++i) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (!entry._attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(entry._attachment);
+			if (meshes.contains(mesh)) continue;
+			meshes.add(mesh);
+			slotIndices.add((int) entry._slotIndex);
+		}
+	}
+
+	// Linked meshes take their vertices from their parent, so they are updated after it.
+	Vector<Slot *> &slots = skeleton.getSlots();
+	for (size_t i = 0, n = meshes.size(); i < n; ++i) {
+		MeshAttachment &mesh = *meshes[i];
+		if (mesh._parentMesh) continue;
+		Slot &slot = *slots[slotIndices[i]];
+		if (mesh._bones.size() > 0) prune(skeletonData, mesh, slot, meshes);
+		if (_lodCount > 0) generateLods(mesh, slot);
+	}
+	for (size_t i = 0, n = meshes.size(); i < n; ++i)
+		if (meshes[i]->_parentMesh) linkLods(*meshes[i]);
+}
+
+void MeshOptimizer::prune(SkeletonData &skeletonData, MeshAttachment &mesh, Slot &slot, Vector<MeshAttachment *> &meshes) {
+	size_t influenceCount = mesh._vertices.size() / 3;
+	_influencesBefore += influenceCount;
+
+	// Deform timelines of the mesh or its linked meshes store a value pair per influence.
+	Vector<DeformTimeline *> timelines;
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0, n = animations.size(); i < n; ++i) {
+		Vector<Timeline *> &animationTimelines = animations[i]->getTimelines();
+		for (size_t ii = 0, nn = animationTimelines.size(); ii < nn; ++ii) {
+			if (!animationTimelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *timeline = static_cast<DeformTimeline *>(animationTimelines[ii]);
+			VertexAttachment *attachment = timeline->getAttachment();
+			if (attachment != &mesh && !(attachment->getRTTI().isExactly(MeshAttachment::rtti) &&
+										 static_cast<MeshAttachment *>(attachment)->_parentMesh == &mesh))
+				continue;
+			if (timeline->isCompact()) {
+				_meshesSkipped++;
+				_influencesAfter += influenceCount;
+				return;
+			}
+			timelines.add(timeline);
+		}
+	}
+
+	// Keep the strongest influences of each vertex, in their original order, and scale their weights to the old total.
+	Vector<int> &bones = mesh._bones;
+	Vector<float> &vertices = mesh._vertices;
+	Vector<int> newBones, kept;
+	Vector<float> newVertices;
+	Vector<bool> ranked, keep;
+	for (size_t b = 0, influence = 0, n = bones.size(); b < n;) {
+		int count = bones[b];
+		const float *weights = vertices.buffer() + influence * 3 + 2;
+		ranked.clear();
+		ranked.setSize(count, false);
+		keep.clear();
+		keep.setSize(count, false);
+		float total = 0, keptTotal = 0;
+		int keptCount = 0;
+		for (int rank = 0; rank < count; rank++) {
+			int strongest = -1;
+			for (int j = 0; j < count; j++)
+				if (!ranked[j] && (strongest == -1 || weights[j * 3] > weights[strongest * 3])) strongest = j;
+			ranked[strongest] = true;
+			float weight = weights[strongest * 3];
+			total += weight;
+			if (rank == 0 || ((_maxBones <= 0 || rank < _maxBones) && weight >= _minWeight)) {
+				keep[strongest] = true;
+				keptTotal += weight;
+				keptCount++;
+			}
+		}
+		_maxWeightRemoved = MathUtil::max(_maxWeightRemoved, total - keptTotal);
+		float scale = keptTotal > 0 ? total / keptTotal : 1;
+		newBones.add(keptCount);
+		for (int j = 0; j < count; j++) {
+			if (!keep[j]) continue;
+			size_t v = (influence + j) * 3;
+			newBones.add(bones[b + 1 + j]);
+			newVertices.add(vertices[v]);
+			newVertices.add(vertices[v + 1]);
+			newVertices.add(keptCount < count ? vertices[v + 2] * scale : vertices[v + 2]);
+			kept.add((int) (influence + j));
+		}
+		b += count + 1;
+		influence += count;
+	}
+	_influencesAfter += kept.size();
+	if (kept.size() == influenceCount) return;
+
+	size_t worldVerticesLength = mesh._worldVerticesLength;
+	_worldVertices.setSize(worldVerticesLength, 0);
+	mesh.VertexAttachment::computeWorldVertices(slot, 0, worldVerticesLength, _worldVertices, 0, 2);
+	bones.clearAndAddAll(newBones);
+	vertices.clearAndAddAll(newVertices);
+	mesh.updateSkinning();
+	_prunedWorldVertices.setSize(worldVerticesLength, 0);
+	mesh.VertexAttachment::computeWorldVertices(slot, 0, worldVerticesLength, _prunedWorldVertices, 0, 2);
+	for (size_t i = 0; i < worldVerticesLength; i += 2) {
+		float dx = _prunedWorldVertices[i] - _worldVertices[i], dy = _prunedWorldVertices[i + 1] - _worldVertices[i + 1];
+		_maxPruneError = MathUtil::max(_maxPruneError, MathUtil::sqrt(dx * dx + dy * dy));
+	}
+
+	Vector<float> frameVertices;
+	for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+		Vector<Vector<float> > &frames = timelines[i]->getVertices();
+		for (size_t frame = 0, frameCount = frames.size(); frame < frameCount; ++frame) {
+			Vector<float> &deform = frames[frame];
+			if (deform.size() != influenceCount << 1) continue;
+			frameVertices.setSize(kept.size() << 1, 0);
+			for (size_t ii = 0, nn = kept.size(); ii < nn; ++ii) {
+				frameVertices[ii << 1] = deform[kept[ii] << 1];
+				frameVertices[(ii << 1) + 1] = deform[(kept[ii] << 1) + 1];
+			}
+			deform.clearAndAddAll(frameVertices);
+		}
+	}
+
+	for (size_t i = 0, n = meshes.size(); i < n; ++i)
+		if (meshes[i]->_parentMesh == &mesh) meshes[i]->setParentMesh(&mesh);
+	_meshesPruned++;
+}
+
+void MeshOptimizer::generateLods(MeshAttachment &mesh, Slot &slot) {
+	if (mesh._sequence || mesh._lods.size() > 0) return;
+	int vertexCount = (int) (mesh._worldVerticesLength >> 1);
+	if (vertexCount < _lodMinVertices || mesh._regionUVs.size() != (size_t) vertexCount << 1) return;
+
+	_worldVertices.setSize(mesh._worldVerticesLength, 0);
+	mesh.VertexAttachment::computeWorldVertices(slot, 0, mesh._worldVerticesLength, _worldVertices, 0, 2);
+	MeshSimplifier simplifier(_worldVertices, mesh._regionUVs, mesh._triangles, mesh._hullLength >> 1);
+
+	// The value pairs of each vertex in the full mesh's vertices and deform.
+	Vector<int> vertexStarts;
+	if (mesh._bones.size() > 0) {
+		for (size_t b = 0, influence = 0, n = mesh._bones.size(); b < n; b += mesh._bones[b] + 1) {
+			vertexStarts.add((int) b);
+			vertexStarts.add((int) influence);
+			influence += mesh._bones[b];
+		}
+	}
+
+	Vector<int> newIndex;
+	int targetCount = vertexCount;
+	for (int level = 0; level < _lodCount; level++) {
+		targetCount = (int) (targetCount * _lodRatio);
+		if (simplifier.simplify(targetCount, _lodMaxError) == 0) break;
+
+		MeshAttachment *lod = new (__FILE__, __LINE__) MeshAttachment(mesh.getName());
+		lod->setRegion(mesh._region);
+		lod->_path = mesh._path;
+		lod->_color.set(mesh._color);
+		lod->_timelineAttachment = mesh._timelineAttachment;
+		lod->_hullLength = mesh._hullLength;
+		lod->_width = mesh._width;
+		lod->_height = mesh._height;
+
+		// Hull vertices are never removed, so they stay first as the hull length requires.
+		Vector<bool> &alive = simplifier.getAlive();
+		newIndex.clear();
+		newIndex.setSize(vertexCount, -1);
+		int lodVertexCount = 0;
+		for (int v = 0; v < vertexCount; v++) {
+			if (!alive[v]) continue;
+			newIndex[v] = lodVertexCount++;
+			lod->_regionUVs.add(mesh._regionUVs[v << 1]);
+			lod->_regionUVs.add(mesh._regionUVs[(v << 1) + 1]);
+			if (mesh._bones.size() == 0) {
+				lod->_vertices.add(mesh._vertices[v << 1]);
+				lod->_vertices.add(mesh._vertices[(v << 1) + 1]);
+				lod->_lodDeform.add(v << 1);
+				lod->_lodDeform.add((v << 1) + 1);
+				continue;
+			}
+			int b = vertexStarts[v << 1], influence = vertexStarts[(v << 1) + 1];
+			int count = mesh._bones[b];
+			lod->_bones.add(count);
+			for (int j = 0; j < count; j++, influence++) {
+				lod->_bones.add(mesh._bones[b + 1 + j]);
+				lod->_vertices.add(mesh._vertices[influence * 3]);
+				lod->_vertices.add(mesh._vertices[influence * 3 + 1]);
+				lod->_vertices.add(mesh._vertices[influence * 3 + 2]);
+				lod->_lodDeform.add(influence << 1);
+				lod->_lodDeform.add((influence << 1) + 1);
+			}
+		}
+		lod->_worldVerticesLength = lodVertexCount << 1;
+		simplifier.getTriangles(newIndex, lod->_triangles);
+		lod->_lodError = simplifier.computeError();
+		lod->updateRegion();
+		lod->updateSkinning();
+		mesh._lods.add(lod);
+
+		_lodsCreated++;
+		_maxLodError = MathUtil::max(_maxLodError, lod->_lodError);
+	}
+	if (mesh._lods.size() > 0) {
+		_lodVerticesBefore += vertexCount;
+		_lodVerticesAfter += mesh._lods[mesh._lods.size() - 1]->_worldVerticesLength >> 1;
+	}
+}
+
+void MeshOptimizer::linkLods(MeshAttachment &mesh) {
+	MeshAttachment &parent = *mesh._parentMesh;
+	if (mesh._sequence || mesh._lods.size() > 0) return;
+	for (size_t i = 0, n = parent._lods.size(); i < n; ++i) {
+		MeshAttachment *parentLod = parent._lods[i];
+		MeshAttachment *lod = new (__FILE__, __LINE__) MeshAttachment(mesh.getName());
+		lod->setRegion(mesh._region);
+		lod->_path = mesh._path;
+		lod->_color.set(mesh._color);
+		lod->_timelineAttachment = mesh._timelineAttachment;
+		lod->setParentMesh(parentLod);
+		lod->_lodDeform.clearAndAddAll(parentLod->_lodDeform);
+		lod->_lodError = parentLod->_lodError;
+		lod->updateRegion();
+		mesh._lods.add(lod);
+		_lodsCreated++;
+	}
+}
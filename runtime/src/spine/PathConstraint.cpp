@@ -49,6 +49,7 @@ const int PathConstraint::AFTER = -3;
 
 PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : Updatable(),
 																			   _data(data),
+																			   _skeleton(skeleton),
 																			   _target(skeleton.findSlot(
 																					   data.getTarget()->getName())),
 																			   _position(data.getPosition()),
@@ -56,14 +57,14 @@ PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : U
 																			   _mixRotate(data.getMixRotate()),
 																			   _mixX(data.getMixX()),
 																			   _mixY(data.getMixY()),
+																			   _curvesClosed(false),
+																			   _pathLength(0),
 																			   _active(false) {
 	_bones.ensureCapacity(_data.getBones().size());
 	for (size_t i = 0; i < _data.getBones().size(); i++) {
 		BoneData *boneData = _data.getBones()[i];
 		_bones.add(skeleton.findBone(boneData->getName()));
 	}
-
-	_segments.setSize(10, 0);
 }
 
 void PathConstraint::update() {
@@ -230,6 +231,7 @@ float PathConstraint::getPosition() {
 
 void PathConstraint::setPosition(float inValue) {
 	_position = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float PathConstraint::getSpacing() {
@@ -238,6 +240,7 @@ float PathConstraint::getSpacing() {
 
 void PathConstraint::setSpacing(float inValue) {
 	_spacing = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float PathConstraint::getMixRotate() {
@@ -246,6 +249,7 @@ float PathConstraint::getMixRotate() {
 
 void PathConstraint::setMixRotate(float inValue) {
 	_mixRotate = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float PathConstraint::getMixX() {
@@ -254,6 +258,7 @@ float PathConstraint::getMixX() {
 
 void PathConstraint::setMixX(float inValue) {
 	_mixX = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float PathConstraint::getMixY() {
@@ -262,6 +267,7 @@ float PathConstraint::getMixY() {
 
 void PathConstraint::setMixY(float inValue) {
 	_mixY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 Vector<Bone *> &PathConstraint::getBones() {
@@ -274,6 +280,7 @@ Slot *PathConstraint::getTarget() {
 
 void PathConstraint::setTarget(Slot *inValue) {
 	_target = inValue;
+	_skeleton.markPoseChanged();
 }
 
 PathConstraintData &PathConstraint::getData() {
@@ -370,6 +377,92 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		return out;
 	}
 
+	// World vertices and curve lengths.
+	updateCurves(path);
+	Vector<float> &curvesWorld = _curvesWorld;
+	verticesLength = (int) curvesWorld.size();
+	pathLength = _pathLength;
+
+	if (_data._positionMode == PositionMode_Percent) position *= pathLength;
+
+	float multiplier = 0;
+	switch (_data._spacingMode) {
+		case SpacingMode_Percent:
+			multiplier = pathLength;
+			break;
+		case SpacingMode_Proportional:
+			multiplier = pathLength / spacesCount;
+			break;
+		default:
+			multiplier = 1;
+	}
+
+	float *segments = NULL, *w = NULL;
+	for (int i = 0, o = 0, curve = 0, segment = 0; i < spacesCount; i++, o += 3) {
+		float space = _spaces[i] * multiplier;
+		position += space;
+		float p = position;
+
+		if (closed) {
+			p = MathUtil::fmod(p, pathLength);
+			if (p < 0) p += pathLength;
+			curve = 0;
+		} else if (p < 0) {
+			addBeforePosition(p, curvesWorld, 0, out, o);
+			continue;
+		} else if (p > pathLength) {
+			addAfterPosition(p - pathLength, curvesWorld, verticesLength - 4, out, o);
+			continue;
+		}
+
+		// Determine curve containing position.
+		for (;; curve++) {
+			float length = _curves[curve];
+			if (p > length) continue;
+			if (curve == 0)
+				p /= length;
+			else {
+				float prev = _curves[curve - 1];
+				p = (p - prev) / (length - prev);
+			}
+			break;
+		}
+
+		// Curve segment lengths.
+		if (curve != prevCurve) {
+			prevCurve = curve;
+			segments = getSegments(curve);
+			w = curvesWorld.buffer() + curve * 6;
+			segment = 0;
+		}
+
+		// Weight by segment length.
+		p *= segments[9];
+		for (;; segment++) {
+			float length = segments[segment];
+			if (p > length) continue;
+			if (segment == 0)
+				p /= length;
+			else {
+				float prev = segments[segment - 1];
+				p = segment + (p - prev) / (length - prev);
+			}
+			break;
+		}
+		addCurvePosition(p * 0.1f, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7], out, o,
+						 tangents || (i > 0 && space < EPSILON));
+	}
+
+	return out;
+}
+
+void PathConstraint::updateCurves(PathAttachment &path) {
+	Slot &target = *_target;
+	Vector<float> &world = _world;
+	bool closed = path.isClosed();
+	int verticesLength = (int) path.getWorldVerticesLength();
+	int curveCount = verticesLength / 6;
+
 	// World vertices.
 	if (closed) {
 		verticesLength += 2;
@@ -385,10 +478,17 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		path.computeWorldVertices(target, 2, verticesLength, world, 0);
 	}
 
+	// The lengths only depend on the world vertices, so they are kept until the path moves or is deformed.
+	if (closed == _curvesClosed && world.size() == _curvesWorld.size() &&
+		memcmp(world.buffer(), _curvesWorld.buffer(), world.size() * sizeof(float)) == 0)
+		return;
+	_curvesClosed = closed;
+	_curvesWorld.clearAndAddAll(world);
+
 	// Curve lengths.
 	_curves.setSize(curveCount, 0);
-	pathLength = 0;
-	float x1 = world[0], y1 = world[1], cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
+	float pathLength = 0;
+	float x1 = world[0], y1 = world[1], cx1, cy1, cx2, cy2, x2, y2;
 	float tmpx, tmpy, dddfx, dddfy, ddfx, ddfy, dfx, dfy;
 	for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
 		cx1 = world[w];
@@ -421,111 +521,133 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		x1 = x2;
 		y1 = y2;
 	}
+	_pathLength = pathLength;
 
-	if (_data._positionMode == PositionMode_Percent) position *= pathLength;
+	// Segment lengths are computed the first time a curve is used.
+	_segments.setSize(curveCount * 10, 0);
+	for (int i = 0; i < curveCount; i++)
+		_segments[i * 10] = -1;
+}
 
-	float multiplier = 0;
-	switch (_data._spacingMode) {
-		case SpacingMode_Percent:
-			multiplier = pathLength;
-			break;
-		case SpacingMode_Proportional:
-			multiplier = pathLength / spacesCount;
-			break;
-		default:
-			multiplier = 1;
+float *PathConstraint::getSegments(int curve) {
+	float *segments = _segments.buffer() + curve * 10;
+	if (segments[0] >= 0) return segments;
+
+	float *world = _curvesWorld.buffer() + curve * 6;
+	float x1 = world[0], y1 = world[1], cx1 = world[2], cy1 = world[3];
+	float cx2 = world[4], cy2 = world[5], x2 = world[6], y2 = world[7];
+	float tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
+	float tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
+	float dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
+	float dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
+	float ddfx = tmpx * 2 + dddfx;
+	float ddfy = tmpy * 2 + dddfy;
+	float dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
+	float dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
+	float curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+	segments[0] = curveLength;
+	for (int i = 1; i < 8; i++) {
+		dfx += ddfx;
+		dfy += ddfy;
+		ddfx += dddfx;
+		ddfy += dddfy;
+		curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		segments[i] = curveLength;
 	}
+	dfx += ddfx;
+	dfy += ddfy;
+	curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+	segments[8] = curveLength;
+	dfx += ddfx + dddfx;
+	dfy += ddfy + dddfy;
+	curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+	segments[9] = curveLength;
+	return segments;
+}
 
-	float curveLength = 0;
-	for (int i = 0, o = 0, curve = 0, segment = 0; i < spacesCount; i++, o += 3) {
-		float space = _spaces[i] * multiplier;
-		position += space;
-		float p = position;
+bool PathConstraint::computePathPositions(Vector<float> &positions, Vector<float> &output, bool tangents) {
+	Attachment *baseAttachment = _target->getAttachment();
+	if (baseAttachment == NULL || !baseAttachment->getRTTI().instanceOf(PathAttachment::rtti)) {
+		return false;
+	}
+	PathAttachment &path = *static_cast<PathAttachment *>(baseAttachment);
+
+	updateCurves(path);
+	Vector<float> &world = _curvesWorld;
+	bool closed = path.isClosed(), constantSpeed = path.isConstantSpeed();
+	int curveCount = (int) _curves.size();
+	float *lengths = _curves.buffer(), pathLength = _pathLength;
+	if (!constantSpeed) {
+		lengths = path.getLengths().buffer();
+		pathLength = lengths[curveCount - 1];
+	}
+
+	size_t count = positions.size();
+	output.setSize(count * 3, 0);
+	for (size_t i = 0, o = 0; i < count; i++, o += 3) {
+		float p = positions[i];
+		if (_data._positionMode == PositionMode_Percent) p *= pathLength;
 
 		if (closed) {
 			p = MathUtil::fmod(p, pathLength);
 			if (p < 0) p += pathLength;
-			curve = 0;
 		} else if (p < 0) {
-			addBeforePosition(p, world, 0, out, o);
+			addBeforePosition(p, world, 0, output, (int) o);
 			continue;
 		} else if (p > pathLength) {
-			addAfterPosition(p - pathLength, world, verticesLength - 4, out, o);
+			addAfterPosition(p - pathLength, world, (int) world.size() - 4, output, (int) o);
 			continue;
 		}
 
 		// Determine curve containing position.
-		for (;; curve++) {
-			float length = _curves[curve];
-			if (p > length) continue;
-			if (curve == 0)
-				p /= length;
-			else {
-				float prev = _curves[curve - 1];
-				p = (p - prev) / (length - prev);
-			}
-			break;
+		int curve = 0;
+		for (int high = curveCount - 1; curve < high;) {
+			int middle = (curve + high) >> 1;
+			if (p > lengths[middle])
+				curve = middle + 1;
+			else
+				high = middle;
 		}
-
-		// Curve segment lengths.
-		if (curve != prevCurve) {
-			prevCurve = curve;
-			int ii = curve * 6;
-			x1 = world[ii];
-			y1 = world[ii + 1];
-			cx1 = world[ii + 2];
-			cy1 = world[ii + 3];
-			cx2 = world[ii + 4];
-			cy2 = world[ii + 5];
-			x2 = world[ii + 6];
-			y2 = world[ii + 7];
-			tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
-			tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
-			dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
-			dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
-			ddfx = tmpx * 2 + dddfx;
-			ddfy = tmpy * 2 + dddfy;
-			dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
-			dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
-			curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[0] = curveLength;
-			for (ii = 1; ii < 8; ii++) {
-				dfx += ddfx;
-				dfy += ddfy;
-				ddfx += dddfx;
-				ddfy += dddfy;
-				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-				_segments[ii] = curveLength;
-			}
-			dfx += ddfx;
-			dfy += ddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[8] = curveLength;
-			dfx += ddfx + dddfx;
-			dfy += ddfy + dddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[9] = curveLength;
-			segment = 0;
+		float length = lengths[curve];
+		if (curve == 0)
+			p /= length;
+		else {
+			float prev = lengths[curve - 1];
+			p = (p - prev) / (length - prev);
 		}
 
-		// Weight by segment length.
-		p *= curveLength;
-		for (;; segment++) {
-			float length = _segments[segment];
-			if (p > length) continue;
+		float *w = world.buffer() + curve * 6;
+		if (constantSpeed) {
+			// Weight by segment length.
+			float *segments = getSegments(curve);
+			p *= segments[9];
+			int segment = 0;
+			for (int high = 9; segment < high;) {
+				int middle = (segment + high) >> 1;
+				if (p > segments[middle])
+					segment = middle + 1;
+				else
+					high = middle;
+			}
+			length = segments[segment];
 			if (segment == 0)
 				p /= length;
 			else {
-				float prev = _segments[segment - 1];
+				float prev = segments[segment - 1];
 				p = segment + (p - prev) / (length - prev);
 			}
-			break;
+			p *= 0.1f;
 		}
-		addCurvePosition(p * 0.1f, x1, y1, cx1, cy1, cx2, cy2, x2, y2, out, o,
-						 tangents || (i > 0 && space < EPSILON));
+		addCurvePosition(p, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7], output, (int) o, tangents);
 	}
 
-	return out;
+	// Positions before or after an open path and at the start of a curve get a rotation even without tangents, which
+	// update() relies on.
+	if (!tangents) {
+		for (size_t o = 2, n = output.size(); o < n; o += 3)
+			output[o] = 0;
+	}
+	return true;
 }
 
 void PathConstraint::addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o) {
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/RenderCommandBuilder.h>
+
+#include <spine/Atlas.h>
+#include <spine/Bone.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+#include <limits.h>
+#include <string.h>
+
+using namespace spine;
+
+namespace {
+	unsigned short quadIndices[6] = {0, 1, 2, 2, 3, 0};
+
+	unsigned int packColor(float r, float g, float b, float a) {
+		return (unsigned int) (unsigned char) (r * 255.f) | (unsigned int) (unsigned char) (g * 255.f) << 8 |
+			   (unsigned int) (unsigned char) (b * 255.f) << 16 | (unsigned int) (unsigned char) (a * 255.f) << 24;
+	}
+
+	template<typename T>
+	T *append(Vector<T> &vector, size_t count) {
+		size_t size = vector.size();
+		vector.setSizeUninitialized(size + count);
+		return vector.buffer() + size;
+	}
+}
+
+void RenderBuffer::clear() {
+	positions.clear();
+	uvs.clear();
+	colors.clear();
+	darkColors.clear();
+	indices.clear();
+	batches.clear();
+	slots.clear();
+}
+
+RenderCommandBuilder::RenderCommandBuilder() : _color(1, 1, 1, 1), _premultipliedAlpha(false), _darkColors(false),
+											   _startSlotIndex(0), _endSlotIndex(INT_MAX), _maxBatchVertices(65535),
+											   _maxBatchIndices(65535) {
+}
+
+void RenderCommandBuilder::setSlotsRange(int start, int end) {
+	_startSlotIndex = start;
+	_endSlotIndex = end;
+}
+
+void RenderCommandBuilder::setMaxBatchSize(int vertices, int indices) {
+	_maxBatchVertices = vertices;
+	_maxBatchIndices = indices;
+}
+
+void RenderCommandBuilder::build(Skeleton &skeleton, RenderBuffer &buffer, float lodError, const float *worldVertices,
+								 const int *slotOffsets) {
+	Color &skeletonColor = skeleton.getColor();
+	const float tintR = _color.r * skeletonColor.r, tintG = _color.g * skeletonColor.g, tintB = _color.b * skeletonColor.b;
+	const float tintA = _color.a * skeletonColor.a;
+	if (tintA == 0) return;
+
+	const unsigned int darkAlpha = _premultipliedAlpha ? 0xff000000u : 0;
+	const size_t firstBatch = buffer.batches.size();
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		const int slotIndex = slot.getData().getIndex();
+		if (!attachment || slotIndex < _startSlotIndex || slotIndex > _endSlotIndex || !slot.getBone().isActive()) {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+
+		const float *positions, *uvs;
+		const unsigned short *triangles;
+		size_t vertexCount, indexCount;
+		TextureRegion *region;
+		Color *attachmentColor;
+		const int offset = worldVertices ? slotOffsets[slotIndex] : -1;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *regionAttachment = static_cast<RegionAttachment *>(attachment);
+			region = regionAttachment->getRegion(slot);
+			uvs = regionAttachment->getUVs(slot);
+			triangles = quadIndices;
+			vertexCount = 4;
+			indexCount = 6;
+			attachmentColor = &regionAttachment->getColor();
+			if (offset != -1)
+				positions = worldVertices + offset;
+			else {
+				_worldVertices.setSizeUninitialized(8);
+				regionAttachment->computeWorldVertices(slot, _worldVertices.buffer(), 0, 2);
+				positions = _worldVertices.buffer();
+			}
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			MeshAttachment *lod = mesh->getLod(lodError);
+			region = lod->getRegion(slot);
+			uvs = lod->getUVs(slot);
+			triangles = lod->getTriangles().buffer();
+			vertexCount = lod->getWorldVerticesLength() >> 1;
+			indexCount = lod->getTriangles().size();
+			attachmentColor = &mesh->getColor();
+			if (offset != -1)
+				positions = worldVertices + offset;
+			else {
+				_worldVertices.setSizeUninitialized(lod->getWorldVerticesLength());
+				lod->computeWorldVertices(slot, 0, lod->getWorldVerticesLength(), _worldVertices.buffer(), 0, 2);
+				positions = _worldVertices.buffer();
+			}
+		} else {
+			if (attachment->getRTTI().isExactly(ClippingAttachment::rtti))
+				_clipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+			else
+				_clipper.clipEnd(slot);
+			continue;
+		}
+
+		Color &slotColor = slot.getColor();
+		const float a = attachmentColor->a * (tintA * slotColor.a);
+		if (a == 0 || !region) {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+		float r = attachmentColor->r * (tintR * slotColor.r);
+		float g = attachmentColor->g * (tintG * slotColor.g);
+		float b = attachmentColor->b * (tintB * slotColor.b);
+		if (_premultipliedAlpha) {
+			r *= a;
+			g *= a;
+			b *= a;
+		}
+
+		if (_clipper.isClipping()) {
+			_clipper.clipTriangles(const_cast<float *>(positions), const_cast<unsigned short *>(triangles), indexCount,
+								   const_cast<float *>(uvs), 2);
+			if (_clipper.getClippedTriangles().size() == 0) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+			positions = _clipper.getClippedVertices().buffer();
+			uvs = _clipper.getClippedUVs().buffer();
+			triangles = _clipper.getClippedTriangles().buffer();
+			vertexCount = _clipper.getClippedVertices().size() >> 1;
+			indexCount = _clipper.getClippedTriangles().size();
+		}
+
+		void *texture = static_cast<AtlasRegion *>(region)->page->texture;
+		const BlendMode blendMode = slot.getData().getBlendMode();
+		RenderBatch *batch = buffer.batches.size() > firstBatch ? &buffer.batches[buffer.batches.size() - 1] : NULL;
+		if (!batch || batch->texture != texture || batch->blendMode != blendMode ||
+			batch->vertexCount + (int) vertexCount > _maxBatchVertices ||
+			batch->indexCount + (int) indexCount > _maxBatchIndices) {
+			RenderBatch newBatch;
+			newBatch.texture = texture;
+			newBatch.blendMode = blendMode;
+			newBatch.vertexStart = (int) (buffer.positions.size() >> 1);
+			newBatch.vertexCount = 0;
+			newBatch.indexStart = (int) buffer.indices.size();
+			newBatch.indexCount = 0;
+			buffer.batches.add(newBatch);
+			batch = &buffer.batches[buffer.batches.size() - 1];
+		}
+
+		RenderSlot renderSlot;
+		renderSlot.slot = &slot;
+		renderSlot.batch = (int) buffer.batches.size() - 1;
+		renderSlot.vertexStart = (int) (buffer.positions.size() >> 1);
+		renderSlot.vertexCount = (int) vertexCount;
+		renderSlot.indexStart = (int) buffer.indices.size();
+		renderSlot.indexCount = (int) indexCount;
+		buffer.slots.add(renderSlot);
+
+		memcpy(append(buffer.positions, vertexCount * 2), positions, sizeof(float) * vertexCount * 2);
+		memcpy(append(buffer.uvs, vertexCount * 2), uvs, sizeof(float) * vertexCount * 2);
+		const unsigned int color = packColor(r, g, b, a);
+		unsigned int *colors = append(buffer.colors, vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+			colors[v] = color;
+		if (_darkColors) {
+			unsigned int darkColor = darkAlpha;
+			if (slot.hasDarkColor()) {
+				Color &dark = slot.getDarkColor();
+				darkColor = packColor(dark.r, dark.g, dark.b, 0) | darkAlpha;
+			}
+			unsigned int *darkColors = append(buffer.darkColors, vertexCount);
+			for (size_t v = 0; v < vertexCount; ++v)
+				darkColors[v] = darkColor;
+		}
+		const unsigned short indexOffset = (unsigned short) batch->vertexCount;
+		unsigned short *indices = append(buffer.indices, indexCount);
+		for (size_t ii = 0; ii < indexCount; ++ii)
+			indices[ii] = (unsigned short) (triangles[ii] + indexOffset);
+
+		batch->vertexCount += (int) vertexCount;
+		batch->indexCount += (int) indexCount;
+		_clipper.clipEnd(slot);
+	}
+	_clipper.clipEnd();
+}
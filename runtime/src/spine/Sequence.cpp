@@ -58,16 +58,17 @@ Sequence *Sequence::copy() {
 }
 
 void Sequence::apply(Slot *slot, Attachment *attachment) {
-	int index = slot->getSequenceIndex();
-	if (index == -1) index = _setupIndex;
-	if (index >= (int) _regions.size()) index = (int) _regions.size() - 1;
-	TextureRegion *region = _regions[index];
+	TextureRegion *region = _regions[resolveIndex(slot->getSequenceIndex())];
 
 	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
 		RegionAttachment *regionAttachment = static_cast<RegionAttachment *>(attachment);
 		if (regionAttachment->getRegion() != region) {
 			regionAttachment->setRegion(region);
-			regionAttachment->updateRegion();
+			float *uvs = regionAttachment->getUVs(*slot), *offset = regionAttachment->getOffset(*slot);
+			for (int i = 0; i < NUM_UVS; i++) {
+				regionAttachment->getUVs()[i] = uvs[i];
+				regionAttachment->getOffset()[i] = offset[i];
+			}
 		}
 	}
 
@@ -75,11 +76,20 @@ void Sequence::apply(Slot *slot, Attachment *attachment) {
 		MeshAttachment *meshAttachment = static_cast<MeshAttachment *>(attachment);
 		if (meshAttachment->getRegion() != region) {
 			meshAttachment->setRegion(region);
-			meshAttachment->updateRegion();
+			float *uvs = meshAttachment->getUVs(*slot);
+			Vector<float> &meshUVs = meshAttachment->getUVs();
+			for (size_t i = 0, n = meshUVs.size(); i < n; i++)
+				meshUVs[i] = uvs[i];
 		}
 	}
 }
 
+int Sequence::resolveIndex(int sequenceIndex) {
+	if (sequenceIndex == -1) sequenceIndex = _setupIndex;
+	if (sequenceIndex >= (int) _regions.size()) sequenceIndex = (int) _regions.size() - 1;
+	return sequenceIndex;
+}
+
 String Sequence::getPath(const String &basePath, int index) {
 	String result(basePath);
 	String frame;
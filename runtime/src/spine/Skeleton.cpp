@@ -53,77 +53,229 @@
 
 using namespace spine;
 
+namespace {
+	/// Returns the offset in a block of count objects of the type, after aligning size and adding them to it.
+	template<typename T>
+	size_t reserve(size_t &size, size_t count) {
+		size_t offset = (size + alignof(T) - 1) & ~(alignof(T) - 1);
+		size = offset + count * sizeof(T);
+		return offset;
+	}
+}
+
 Skeleton::Skeleton(SkeletonData *skeletonData) : _data(skeletonData),
 												 _skin(NULL),
 												 _color(1, 1, 1, 1),
 												 _scaleX(1),
 												 _scaleY(1),
 												 _x(0),
-												 _y(0) {
-	_bones.ensureCapacity(_data->getBones().size());
-	for (size_t i = 0; i < _data->getBones().size(); ++i) {
+												 _y(0),
+												 _poseVersion(1),
+												 _block(NULL) {
+	construct();
+	updateCache();
+}
+
+Skeleton::Skeleton(Skeleton &prototype) : _data(prototype._data),
+										  _skin(NULL),
+										  _color(1, 1, 1, 1),
+										  _scaleX(1),
+										  _scaleY(1),
+										  _x(0),
+										  _y(0),
+										  _poseVersion(1),
+										  _block(NULL) {
+	construct();
+	copyFrom(prototype);
+}
+
+void Skeleton::construct() {
+	// Bones, constraints and slots are constructed in one block rather than allocated one by one, so creating a skeleton
+	// makes one allocation for them and updating it walks contiguous memory. Bones are in data order, parents first, which
+	// is the update order of the bones, followed by each type of constraint. The block is not laid out in update cache order:
+	// that order interleaves constraints with the bones they move and changes with the skin, while the block is laid out
+	// once, before the cache exists. Without constraints the update cache only steps forward in the block, with them it
+	// steps back after each constraint.
+	size_t boneCount = _data->getBones().size(), slotCount = _data->getSlots().size();
+	size_t ikCount = _data->getIkConstraints().size(), transformCount = _data->getTransformConstraints().size();
+	size_t pathCount = _data->getPathConstraints().size();
+	size_t blockSize = 0;
+	size_t bonesOffset = reserve<Bone>(blockSize, boneCount);
+	size_t ikOffset = reserve<IkConstraint>(blockSize, ikCount);
+	size_t transformOffset = reserve<TransformConstraint>(blockSize, transformCount);
+	size_t pathOffset = reserve<PathConstraint>(blockSize, pathCount);
+	size_t slotsOffset = reserve<Slot>(blockSize, slotCount);
+	if (blockSize > 0) _block = SpineExtension::calloc<char>(blockSize, __FILE__, __LINE__);
+
+	Bone *bones = (Bone *) (_block + bonesOffset);
+	_bones.ensureCapacity(boneCount);
+	for (size_t i = 0; i < boneCount; ++i) {
 		BoneData *data = _data->getBones()[i];
 
 		Bone *bone;
 		if (data->getParent() == NULL) {
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, NULL);
+			bone = new (bones + i) Bone(*data, *this, NULL);
 		} else {
 			Bone *parent = _bones[data->getParent()->getIndex()];
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, parent);
+			bone = new (bones + i) Bone(*data, *this, parent);
 			parent->getChildren().add(bone);
 		}
 
 		_bones.add(bone);
 	}
 
-	_slots.ensureCapacity(_data->getSlots().size());
-	_drawOrder.ensureCapacity(_data->getSlots().size());
-	for (size_t i = 0; i < _data->getSlots().size(); ++i) {
+	Slot *slots = (Slot *) (_block + slotsOffset);
+	_slots.ensureCapacity(slotCount);
+	_drawOrder.ensureCapacity(slotCount);
+	for (size_t i = 0; i < slotCount; ++i) {
 		SlotData *data = _data->getSlots()[i];
 
 		Bone *bone = _bones[data->getBoneData().getIndex()];
-		Slot *slot = new (__FILE__, __LINE__) Slot(*data, *bone);
+		Slot *slot = new (slots + i) Slot(*data, *bone);
 
 		_slots.add(slot);
 		_drawOrder.add(slot);
 	}
 
-	_ikConstraints.ensureCapacity(_data->getIkConstraints().size());
-	for (size_t i = 0; i < _data->getIkConstraints().size(); ++i) {
+	IkConstraint *ikConstraints = (IkConstraint *) (_block + ikOffset);
+	_ikConstraints.ensureCapacity(ikCount);
+	for (size_t i = 0; i < ikCount; ++i) {
 		IkConstraintData *data = _data->getIkConstraints()[i];
 
-		IkConstraint *constraint = new (__FILE__, __LINE__) IkConstraint(*data, *this);
+		IkConstraint *constraint = new (ikConstraints + i) IkConstraint(*data, *this);
 
 		_ikConstraints.add(constraint);
 	}
 
-	_transformConstraints.ensureCapacity(_data->getTransformConstraints().size());
-	for (size_t i = 0; i < _data->getTransformConstraints().size(); ++i) {
+	TransformConstraint *transformConstraints = (TransformConstraint *) (_block + transformOffset);
+	_transformConstraints.ensureCapacity(transformCount);
+	for (size_t i = 0; i < transformCount; ++i) {
 		TransformConstraintData *data = _data->getTransformConstraints()[i];
 
-		TransformConstraint *constraint = new (__FILE__, __LINE__) TransformConstraint(*data, *this);
+		TransformConstraint *constraint = new (transformConstraints + i) TransformConstraint(*data, *this);
 
 		_transformConstraints.add(constraint);
 	}
 
-	_pathConstraints.ensureCapacity(_data->getPathConstraints().size());
-	for (size_t i = 0; i < _data->getPathConstraints().size(); ++i) {
+	PathConstraint *pathConstraints = (PathConstraint *) (_block + pathOffset);
+	_pathConstraints.ensureCapacity(pathCount);
+	for (size_t i = 0; i < pathCount; ++i) {
 		PathConstraintData *data = _data->getPathConstraints()[i];
 
-		PathConstraint *constraint = new (__FILE__, __LINE__) PathConstraint(*data, *this);
+		PathConstraint *constraint = new (pathConstraints + i) PathConstraint(*data, *this);
 
 		_pathConstraints.add(constraint);
 	}
 
-	updateCache();
+	_updateCache.ensureCapacity(boneCount + ikCount + transformCount + pathCount);
 }
 
 Skeleton::~Skeleton() {
-	ContainerUtil::cleanUpVectorOfPointers(_bones);
-	ContainerUtil::cleanUpVectorOfPointers(_slots);
-	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
-	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
-	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	// The objects live in the block, so they are destroyed but not deleted.
+	for (size_t i = 0, n = _bones.size(); i < n; ++i)
+		_bones[i]->~Bone();
+	for (size_t i = 0, n = _slots.size(); i < n; ++i)
+		_slots[i]->~Slot();
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i)
+		_ikConstraints[i]->~IkConstraint();
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i)
+		_transformConstraints[i]->~TransformConstraint();
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i)
+		_pathConstraints[i]->~PathConstraint();
+	if (_block) SpineExtension::free(_block, __FILE__, __LINE__);
+}
+
+Skeleton *Skeleton::copy() {
+	return new (__FILE__, __LINE__) Skeleton(*this);
+}
+
+void Skeleton::copyFrom(Skeleton &prototype) {
+	assert(prototype._data == _data);
+	_skin = prototype._skin;
+	_color.set(prototype._color);
+	_scaleX = prototype._scaleX;
+	_scaleY = prototype._scaleY;
+	_x = prototype._x;
+	_y = prototype._y;
+
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		Bone &bone = *_bones[i], &source = *prototype._bones[i];
+		bone._x = source._x;
+		bone._y = source._y;
+		bone._rotation = source._rotation;
+		bone._scaleX = source._scaleX;
+		bone._scaleY = source._scaleY;
+		bone._shearX = source._shearX;
+		bone._shearY = source._shearY;
+		bone._ax = source._ax;
+		bone._ay = source._ay;
+		bone._arotation = source._arotation;
+		bone._ascaleX = source._ascaleX;
+		bone._ascaleY = source._ascaleY;
+		bone._ashearX = source._ashearX;
+		bone._ashearY = source._ashearY;
+		bone._a = source._a;
+		bone._b = source._b;
+		bone._worldX = source._worldX;
+		bone._c = source._c;
+		bone._d = source._d;
+		bone._worldY = source._worldY;
+		bone._sorted = source._sorted;
+		bone._active = source._active;
+		bone.updateWorldVersion();
+	}
+
+	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+		Slot &slot = *_slots[i], &source = *prototype._slots[i];
+		slot._color.set(source._color);
+		slot._darkColor.set(source._darkColor);
+		slot._attachment = source._attachment;
+		slot._attachmentState = source._attachmentState;
+		slot._sequenceIndex = source._sequenceIndex;
+		slot._deform.clearAndAddAll(source._deform);
+		slot._deformVersion++;
+	}
+
+	_drawOrder.clear();
+	for (size_t i = 0, n = prototype._drawOrder.size(); i < n; ++i)
+		_drawOrder.add(_slots[prototype._drawOrder[i]->getData().getIndex()]);
+
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i) {
+		IkConstraint &constraint = *_ikConstraints[i], &source = *prototype._ikConstraints[i];
+		constraint._bendDirection = source._bendDirection;
+		constraint._compress = source._compress;
+		constraint._stretch = source._stretch;
+		constraint._mix = source._mix;
+		constraint._softness = source._softness;
+		constraint._active = source._active;
+	}
+
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i) {
+		TransformConstraint &constraint = *_transformConstraints[i], &source = *prototype._transformConstraints[i];
+		constraint._mixRotate = source._mixRotate;
+		constraint._mixX = source._mixX;
+		constraint._mixY = source._mixY;
+		constraint._mixScaleX = source._mixScaleX;
+		constraint._mixScaleY = source._mixScaleY;
+		constraint._mixShearY = source._mixShearY;
+		constraint._active = source._active;
+	}
+
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i) {
+		PathConstraint &constraint = *_pathConstraints[i], &source = *prototype._pathConstraints[i];
+		constraint._position = source._position;
+		constraint._spacing = source._spacing;
+		constraint._mixRotate = source._mixRotate;
+		constraint._mixX = source._mixX;
+		constraint._mixY = source._mixY;
+		constraint._active = source._active;
+	}
+
+	// Both blocks have the same layout, so the update cache maps to the objects at the same offsets.
+	_updateCache.clear();
+	for (size_t i = 0, n = prototype._updateCache.size(); i < n; ++i)
+		_updateCache.add((Updatable *) (_block + ((char *) prototype._updateCache[i] - prototype._block)));
+	_poseVersion++;
 }
 
 void Skeleton::updateCache() {
@@ -220,6 +372,9 @@ void Skeleton::updateWorldTransform() {
 	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
 		_updateCache[i]->update();
 	}
+	for (size_t i = 0, n = _bones.size(); i < n; i++)
+		_bones[i]->updateWorldVersion();
+	_poseVersion++;
 }
 
 void Skeleton::updateWorldTransform(Bone *parent) {
@@ -245,6 +400,9 @@ void Skeleton::updateWorldTransform(Bone *parent) {
 		Updatable *updatable = _updateCache[i];
 		if (updatable != rb) updatable->update();
 	}
+	for (size_t i = 0, n = _bones.size(); i < n; i++)
+		_bones[i]->updateWorldVersion();
+	_poseVersion++;
 }
 
 void Skeleton::setToSetupPose() {
@@ -253,6 +411,7 @@ void Skeleton::setToSetupPose() {
 }
 
 void Skeleton::setBonesToSetupPose() {
+	_poseVersion++;
 	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
 		_bones[i]->setToSetupPose();
 	}
@@ -295,6 +454,7 @@ void Skeleton::setBonesToSetupPose() {
 }
 
 void Skeleton::setSlotsToSetupPose() {
+	_poseVersion++;
 	_drawOrder.clear();
 	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
 		_drawOrder.add(_slots[i]);
@@ -321,26 +481,116 @@ void Skeleton::setSkin(const String &skinName) {
 void Skeleton::setSkin(Skin *newSkin) {
 	if (_skin == newSkin) return;
 	if (newSkin != NULL) {
+		// What is computed for a skin is kept in the skin, so swapping back and forth between skins avoids looking up
+		// attachments by name and sorting the update cache again.
+		Skin &skin = *newSkin;
+		Skin *defaultSkin = _data->getDefaultSkin();
+		unsigned int defaultVersion = defaultSkin != NULL ? defaultSkin->_version : 0;
+		if (skin._cacheData != _data || skin._cacheVersion != skin._version || skin._cacheDefaultVersion != defaultVersion ||
+			skin._cacheSetupVersion != _data->_setupAttachmentsVersion) {
+			skin._cacheData = _data;
+			skin._cacheVersion = skin._version;
+			skin._cacheDefaultVersion = defaultVersion;
+			skin._cacheSetupVersion = _data->_setupAttachmentsVersion;
+			skin._cacheSetupAttachments.setSize(_slots.size(), NULL);
+			for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+				const String &name = _slots[i]->_data.getAttachmentName();
+				skin._cacheSetupAttachments[i] = name.length() > 0 ? skin.getAttachment(i, name) : NULL;
+			}
+			skin._cacheUpdateOffsets.clear();
+			skin._cacheFromSkins.clear();
+		}
+
 		if (_skin != NULL) {
-			Skeleton &thisRef = *this;
-			newSkin->attachAll(thisRef, *_skin);
+			Skin &oldSkin = *_skin;
+			int index = skin._cacheFromSkins.indexOf(&oldSkin);
+			if (index >= 0 && skin._cacheFromVersions[index] != oldSkin._version) {
+				skin._cacheFromSkins.clear();
+				index = -1;
+			}
+			if (index < 0) {
+				if (skin._cacheFromSkins.size() == 0) {
+					skin._cacheFromVersions.clear();
+					skin._cacheSwapStarts.clear();
+					skin._cacheSwapStarts.add(0);
+					skin._cacheSwapSlots.clear();
+					skin._cacheSwapFrom.clear();
+					skin._cacheSwapTo.clear();
+				}
+				index = (int) skin._cacheFromSkins.size();
+				skin._cacheFromSkins.add(&oldSkin);
+				skin._cacheFromVersions.add(oldSkin._version);
+				// The attachments of the new skin with the names of the old skin's attachments, see Skin::attachAll().
+				Skin::AttachmentMap::Entries entries = oldSkin.getAttachments();
+				while (entries.hasNext()) {
+					Skin::AttachmentMap::Entry &entry = entries.next();
+					Attachment *attachment = skin.getAttachment(entry._slotIndex, entry._name);
+					if (!attachment) continue;
+					skin._cacheSwapSlots.add((int) entry._slotIndex);
+					skin._cacheSwapFrom.add(entry._attachment);
+					skin._cacheSwapTo.add(attachment);
+				}
+				skin._cacheSwapStarts.add(skin._cacheSwapSlots.size());
+			}
+			for (size_t i = skin._cacheSwapStarts[index], n = skin._cacheSwapStarts[index + 1]; i < n; ++i) {
+				Slot *slot = _slots[skin._cacheSwapSlots[i]];
+				if (slot->getAttachment() == skin._cacheSwapFrom[i]) slot->setAttachment(skin._cacheSwapTo[i]);
+			}
 		} else {
 			for (size_t i = 0, n = _slots.size(); i < n; ++i) {
-				Slot *slotP = _slots[i];
-				Slot &slot = *slotP;
-				const String &name = slot._data.getAttachmentName();
-				if (name.length() > 0) {
-					Attachment *attachment = newSkin->getAttachment(i, name);
-					if (attachment != NULL) {
-						slot.setAttachment(attachment);
-					}
-				}
+				Attachment *attachment = skin._cacheSetupAttachments[i];
+				if (attachment != NULL) _slots[i]->setAttachment(attachment);
 			}
 		}
 	}
 
 	_skin = newSkin;
-	updateCache();
+	if (newSkin == NULL)
+		updateCache();
+	else if (newSkin->_cacheUpdateOffsets.size() == 0) {
+		updateCache();
+		cacheUpdateCache(*newSkin);
+	} else
+		restoreUpdateCache(*newSkin);
+	_poseVersion++;
+}
+
+void Skeleton::cacheUpdateCache(Skin &skin) {
+	// Skeletons of the same data have the same block layout, so the offsets are valid for all of them.
+	skin._cacheUpdateOffsets.clear();
+	for (size_t i = 0, n = _updateCache.size(); i < n; ++i)
+		skin._cacheUpdateOffsets.add((char *) _updateCache[i] - _block);
+
+	skin._cacheSorted.clear();
+	skin._cacheActive.clear();
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		skin._cacheSorted.add(_bones[i]->_sorted);
+		skin._cacheActive.add(_bones[i]->_active);
+	}
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i)
+		skin._cacheActive.add(_ikConstraints[i]->_active);
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i)
+		skin._cacheActive.add(_transformConstraints[i]->_active);
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i)
+		skin._cacheActive.add(_pathConstraints[i]->_active);
+}
+
+void Skeleton::restoreUpdateCache(Skin &skin) {
+	_updateCache.clear();
+	for (size_t i = 0, n = skin._cacheUpdateOffsets.size(); i < n; ++i)
+		_updateCache.add((Updatable *) (_block + skin._cacheUpdateOffsets[i]));
+
+	size_t flag = 0;
+	for (size_t i = 0, n = _bones.size(); i < n; ++i, ++flag) {
+		_bones[i]->_sorted = skin._cacheSorted[i];
+		_bones[i]->_active = skin._cacheActive[flag];
+	}
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i, ++flag)
+		_ikConstraints[i]->_active = skin._cacheActive[flag];
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i, ++flag)
+		_transformConstraints[i]->_active = skin._cacheActive[flag];
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i, ++flag)
+		_pathConstraints[i]->_active = skin._cacheActive[flag];
 }
 
 Attachment *Skeleton::getAttachment(const String &slotName, const String &attachmentName) {
@@ -360,6 +610,20 @@ Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName)
 	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentName) : NULL;
 }
 
+Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName, int attachmentNameId) {
+	if (attachmentNameId == -2) return getAttachment(slotIndex, attachmentName);
+	if (attachmentNameId == -1) return NULL;
+
+	if (_skin != NULL) {
+		Attachment *attachment = _skin->getAttachment(*_data, slotIndex, attachmentNameId);
+		if (attachment != NULL) {
+			return attachment;
+		}
+	}
+
+	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(*_data, slotIndex, attachmentNameId) : NULL;
+}
+
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
 	assert(slotName.length() > 0);
 
@@ -368,7 +632,8 @@ void Skeleton::setAttachment(const String &slotName, const String &attachmentNam
 		if (slot->_data.getName() == slotName) {
 			Attachment *attachment = NULL;
 			if (attachmentName.length() > 0) {
-				attachment = getAttachment((int) i, attachmentName);
+				int attachmentNameId = _data->findAttachmentNameId(attachmentName);
+				attachment = getAttachment((int) i, attachmentName, attachmentNameId == -1 ? -2 : attachmentNameId);
 
 				assert(attachment != NULL);
 			}
@@ -517,6 +782,7 @@ Color &Skeleton::getColor() {
 void Skeleton::setPosition(float x, float y) {
 	_x = x;
 	_y = y;
+	_poseVersion++;
 }
 
 float Skeleton::getX() {
@@ -525,6 +791,7 @@ float Skeleton::getX() {
 
 void Skeleton::setX(float inValue) {
 	_x = inValue;
+	_poseVersion++;
 }
 
 float Skeleton::getY() {
@@ -533,6 +800,7 @@ float Skeleton::getY() {
 
 void Skeleton::setY(float inValue) {
 	_y = inValue;
+	_poseVersion++;
 }
 
 float Skeleton::getScaleX() {
@@ -541,6 +809,7 @@ float Skeleton::getScaleX() {
 
 void Skeleton::setScaleX(float inValue) {
 	_scaleX = inValue;
+	_poseVersion++;
 }
 
 float Skeleton::getScaleY() {
@@ -549,6 +818,15 @@ float Skeleton::getScaleY() {
 
 void Skeleton::setScaleY(float inValue) {
 	_scaleY = inValue;
+	_poseVersion++;
+}
+
+unsigned int Skeleton::getPoseVersion() {
+	return _poseVersion;
+}
+
+void Skeleton::markPoseChanged() {
+	_poseVersion++;
 }
 
 void Skeleton::sortIkConstraint(IkConstraint *constraint) {
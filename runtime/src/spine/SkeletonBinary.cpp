@@ -172,6 +172,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		const char *slotName = readString(input);
 		BoneData *boneData = skeletonData->_bones[readVarint(input, true)];
 		SlotData *slotData = new (__FILE__, __LINE__) SlotData(i, String(slotName, true), *boneData);
+		slotData->_skeletonData = skeletonData;
 
 		readColor(input, slotData->getColor());
 		unsigned char a = readByte(input);
@@ -306,7 +307,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
 		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
-		if (linkedMesh->_mesh->_region) linkedMesh->_mesh->updateRegion();
+		if (linkedMesh->_mesh->_region || linkedMesh->_mesh->_sequence) linkedMesh->_mesh->updateRegion();
 		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
@@ -344,6 +345,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	delete input;
+	skeletonData->internAttachmentNames();
 	return skeletonData;
 }
 
@@ -539,7 +541,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			region->_height = height;
 			region->getColor().set(color);
 			region->_sequence = sequence;
-			if (sequence == NULL) region->updateRegion();
+			region->updateRegion();
 			_attachmentLoader->configureAttachment(region);
 			return region;
 		}
@@ -552,6 +554,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			}
 			readVertices(input, box->getVertices(), box->getBones(), vertexCount);
 			box->setWorldVerticesLength(vertexCount << 1);
+			box->updateSkinning();
 			if (nonessential) {
 				readColor(input, box->getColor());
 			}
@@ -596,11 +599,12 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			mesh->_bones.addAll(bones);
 			mesh->_vertices.addAll(vertices);
 			mesh->setWorldVerticesLength(vertexCount << 1);
+			mesh->updateSkinning();
 			mesh->_triangles.addAll(triangles);
 			mesh->_regionUVs.addAll(uvs);
-			if (sequence == NULL) mesh->updateRegion();
-			mesh->_hullLength = hullLength;
 			mesh->_sequence = sequence;
+			mesh->updateRegion();
+			mesh->_hullLength = hullLength;
 			if (nonessential) {
 				mesh->_edges.addAll(edges);
 				mesh->_width = width;
@@ -654,6 +658,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			int vertexCount = readVarint(input, true);
 			readVertices(input, path->getVertices(), path->getBones(), vertexCount);
 			path->setWorldVerticesLength(vertexCount << 1);
+			path->updateSkinning();
 			int lengthsLength = vertexCount / 3;
 			path->_lengths.setSize(lengthsLength, 0);
 			for (int i = 0; i < lengthsLength; ++i) {
@@ -691,6 +696,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			}
 			readVertices(input, clip->getVertices(), clip->getBones(), vertexCount);
 			clip->setWorldVerticesLength(vertexCount << 1);
+			clip->updateSkinning();
 			clip->_endSlot = skeletonData->_slots[endSlotIndex];
 			if (nonessential) {
 				readColor(input, clip->getColor());
@@ -0,0 +1,1024 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SkeletonBinaryWriter.h>
+
+#include <spine/Animation.h>
+#include <spine/AttachmentTimeline.h>
+#include <spine/AttachmentType.h>
+#include <spine/BoneData.h>
+#include <spine/BoundingBoxAttachment.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/ColorTimeline.h>
+#include <spine/DeformTimeline.h>
+#include <spine/DrawOrderTimeline.h>
+#include <spine/Event.h>
+#include <spine/EventData.h>
+#include <spine/EventTimeline.h>
+#include <spine/IkConstraintData.h>
+#include <spine/IkConstraintTimeline.h>
+#include <spine/MeshAttachment.h>
+#include <spine/PathAttachment.h>
+#include <spine/PathConstraintData.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintPositionTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
+#include <spine/PointAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/RotateTimeline.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/Sequence.h>
+#include <spine/SequenceTimeline.h>
+#include <spine/ShearTimeline.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraintData.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TranslateTimeline.h>
+#include <spine/Version.h>
+
+using namespace spine;
+
+namespace {
+	struct AttachmentTimelineEntry {
+		Timeline *timeline;
+		size_t skinIndex;
+		size_t slotIndex;
+		String attachmentName;
+	};
+
+	int getSlotIndex(Timeline *timeline) {
+		const RTTI &rtti = timeline->getRTTI();
+		if (rtti.isExactly(AttachmentTimeline::rtti)) return static_cast<AttachmentTimeline *>(timeline)->getSlotIndex();
+		if (rtti.isExactly(RGBATimeline::rtti)) return static_cast<RGBATimeline *>(timeline)->getSlotIndex();
+		if (rtti.isExactly(RGBTimeline::rtti)) return static_cast<RGBTimeline *>(timeline)->getSlotIndex();
+		if (rtti.isExactly(RGBA2Timeline::rtti)) return static_cast<RGBA2Timeline *>(timeline)->getSlotIndex();
+		if (rtti.isExactly(RGB2Timeline::rtti)) return static_cast<RGB2Timeline *>(timeline)->getSlotIndex();
+		if (rtti.isExactly(AlphaTimeline::rtti)) return static_cast<AlphaTimeline *>(timeline)->getSlotIndex();
+		return -1;
+	}
+
+	int getBoneTimelineType(Timeline *timeline, int &boneIndex) {
+		const RTTI &rtti = timeline->getRTTI();
+		if (rtti.isExactly(RotateTimeline::rtti)) {
+			boneIndex = static_cast<RotateTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_ROTATE;
+		}
+		if (rtti.isExactly(TranslateTimeline::rtti)) {
+			boneIndex = static_cast<TranslateTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_TRANSLATE;
+		}
+		if (rtti.isExactly(TranslateXTimeline::rtti)) {
+			boneIndex = static_cast<TranslateXTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_TRANSLATEX;
+		}
+		if (rtti.isExactly(TranslateYTimeline::rtti)) {
+			boneIndex = static_cast<TranslateYTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_TRANSLATEY;
+		}
+		if (rtti.isExactly(ScaleTimeline::rtti)) {
+			boneIndex = static_cast<ScaleTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SCALE;
+		}
+		if (rtti.isExactly(ScaleXTimeline::rtti)) {
+			boneIndex = static_cast<ScaleXTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SCALEX;
+		}
+		if (rtti.isExactly(ScaleYTimeline::rtti)) {
+			boneIndex = static_cast<ScaleYTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SCALEY;
+		}
+		if (rtti.isExactly(ShearTimeline::rtti)) {
+			boneIndex = static_cast<ShearTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SHEAR;
+		}
+		if (rtti.isExactly(ShearXTimeline::rtti)) {
+			boneIndex = static_cast<ShearXTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SHEARX;
+		}
+		if (rtti.isExactly(ShearYTimeline::rtti)) {
+			boneIndex = static_cast<ShearYTimeline *>(timeline)->getBoneIndex();
+			return SkeletonBinary::BONE_SHEARY;
+		}
+		return -1;
+	}
+
+	int getPathTimelineType(Timeline *timeline, int &constraintIndex) {
+		const RTTI &rtti = timeline->getRTTI();
+		if (rtti.isExactly(PathConstraintPositionTimeline::rtti)) {
+			constraintIndex = static_cast<PathConstraintPositionTimeline *>(timeline)->getPathConstraintIndex();
+			return SkeletonBinary::PATH_POSITION;
+		}
+		if (rtti.isExactly(PathConstraintSpacingTimeline::rtti)) {
+			constraintIndex = static_cast<PathConstraintSpacingTimeline *>(timeline)->getPathConstraintIndex();
+			return SkeletonBinary::PATH_SPACING;
+		}
+		if (rtti.isExactly(PathConstraintMixTimeline::rtti)) {
+			constraintIndex = static_cast<PathConstraintMixTimeline *>(timeline)->getPathConstraintIndex();
+			return SkeletonBinary::PATH_MIX;
+		}
+		return -1;
+	}
+
+	size_t getBezierCount(CurveTimeline &timeline, size_t valueCount) {
+		Vector<float> &curves = timeline.getCurves();
+		size_t count = 0;
+		for (size_t frame = 0, frameLast = timeline.getFrameCount() - 1; frame < frameLast; frame++)
+			if (curves[frame] >= SkeletonBinary::CURVE_BEZIER) count += valueCount;
+		return count;
+	}
+
+	unsigned char toByte(float value) {
+		if (value <= 0) return 0;
+		if (value >= 1) return 255;
+		return (unsigned char) (value * 255 + 0.5f);
+	}
+
+	float quantize(float value, float precision) {
+		double steps = (double) value / precision;
+		return (float) ((long long) (steps < 0 ? steps - 0.5 : steps + 0.5) * (double) precision);
+	}
+
+	/// Recovers the control points of a bezier segment from the samples at t = 0.3 and t = 0.7 written by
+	/// CurveTimeline::setBezier.
+	float controlPoint(float p0, float p3, float at3, float at7, bool first) {
+		double c1 = at3 - 0.343 * p0 - 0.027 * p3;
+		double c2 = at7 - 0.027 * p0 - 0.343 * p3;
+		if (first) return (float) ((0.441 * c1 - 0.189 * c2) / 0.15876);
+		return (float) ((0.441 * c2 - 0.189 * c1) / 0.15876);
+	}
+}
+
+SkeletonBinaryWriter::SkeletonBinaryWriter() : _output(NULL), _error(), _nonessential(true), _precision(0) {
+}
+
+SkeletonBinaryWriter::~SkeletonBinaryWriter() {
+}
+
+bool SkeletonBinaryWriter::writeSkeletonData(SkeletonData &skeletonData, Vector<unsigned char> &output) {
+	_error = "";
+	_strings.clear();
+
+	// The string table precedes the data referencing it, so the body is written first.
+	Vector<unsigned char> body;
+	_output = &body;
+
+	/* Bones. */
+	Vector<BoneData *> &bones = skeletonData.getBones();
+	writeVarint((int) bones.size(), true);
+	for (size_t i = 0; i < bones.size(); ++i) {
+		BoneData *data = bones[i];
+		writeString(data->getName());
+		if (i > 0) writeVarint(data->getParent()->getIndex(), true);
+		writeFloat(data->getRotation());
+		writeFloat(data->getX());
+		writeFloat(data->getY());
+		writeFloat(data->getScaleX());
+		writeFloat(data->getScaleY());
+		writeFloat(data->getShearX());
+		writeFloat(data->getShearY());
+		writeFloat(data->getLength());
+		writeVarint(data->getTransformMode(), true);
+		writeBoolean(data->isSkinRequired());
+		if (_nonessential) writeColor(data->getColor());
+	}
+
+	/* Slots. */
+	Vector<SlotData *> &slots = skeletonData.getSlots();
+	writeVarint((int) slots.size(), true);
+	for (size_t i = 0; i < slots.size(); ++i) {
+		SlotData *slotData = slots[i];
+		writeString(slotData->getName());
+		writeVarint(slotData->getBoneData().getIndex(), true);
+		writeColor(slotData->getColor());
+		if (slotData->hasDarkColor()) {
+			Color &dark = slotData->getDarkColor();
+			writeByte(0);
+			writeByte(toByte(dark.r));
+			writeByte(toByte(dark.g));
+			writeByte(toByte(dark.b));
+		} else
+			writeInt(-1);
+		writeStringRef(slotData->getAttachmentName());
+		writeVarint(slotData->getBlendMode(), true);
+	}
+
+	/* IK constraints. */
+	Vector<IkConstraintData *> &ikConstraints = skeletonData.getIkConstraints();
+	writeVarint((int) ikConstraints.size(), true);
+	for (size_t i = 0; i < ikConstraints.size(); ++i) {
+		IkConstraintData *data = ikConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeBoolean(data->isSkinRequired());
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ++ii)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		writeFloat(data->getMix());
+		writeFloat(data->getSoftness());
+		writeByte((unsigned char) (signed char) data->getBendDirection());
+		writeBoolean(data->getCompress());
+		writeBoolean(data->getStretch());
+		writeBoolean(data->getUniform());
+	}
+
+	/* Transform constraints. */
+	Vector<TransformConstraintData *> &transformConstraints = skeletonData.getTransformConstraints();
+	writeVarint((int) transformConstraints.size(), true);
+	for (size_t i = 0; i < transformConstraints.size(); ++i) {
+		TransformConstraintData *data = transformConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeBoolean(data->isSkinRequired());
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ++ii)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		writeBoolean(data->isLocal());
+		writeBoolean(data->isRelative());
+		writeFloat(data->getOffsetRotation());
+		writeFloat(data->getOffsetX());
+		writeFloat(data->getOffsetY());
+		writeFloat(data->getOffsetScaleX());
+		writeFloat(data->getOffsetScaleY());
+		writeFloat(data->getOffsetShearY());
+		writeFloat(data->getMixRotate());
+		writeFloat(data->getMixX());
+		writeFloat(data->getMixY());
+		writeFloat(data->getMixScaleX());
+		writeFloat(data->getMixScaleY());
+		writeFloat(data->getMixShearY());
+	}
+
+	/* Path constraints. */
+	Vector<PathConstraintData *> &pathConstraints = skeletonData.getPathConstraints();
+	writeVarint((int) pathConstraints.size(), true);
+	for (size_t i = 0; i < pathConstraints.size(); ++i) {
+		PathConstraintData *data = pathConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeBoolean(data->isSkinRequired());
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ++ii)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		writeVarint(data->getPositionMode(), true);
+		writeVarint(data->getSpacingMode(), true);
+		writeVarint(data->getRotateMode(), true);
+		writeFloat(data->getOffsetRotation());
+		writeFloat(data->getPosition());
+		writeFloat(data->getSpacing());
+		writeFloat(data->getMixRotate());
+		writeFloat(data->getMixX());
+		writeFloat(data->getMixY());
+	}
+
+	/* Skins, the default skin first. */
+	Skin *defaultSkin = skeletonData.getDefaultSkin();
+	if (defaultSkin) {
+		if (!writeSkin(skeletonData, *defaultSkin, true)) return false;
+	} else
+		writeVarint(0, true);
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	writeVarint((int) (skins.size() - (defaultSkin && skins.contains(defaultSkin) ? 1 : 0)), true);
+	for (size_t i = 0; i < skins.size(); ++i) {
+		if (skins[i] == defaultSkin) continue;
+		if (!writeSkin(skeletonData, *skins[i], false)) return false;
+	}
+
+	/* Events. */
+	Vector<EventData *> &events = skeletonData.getEvents();
+	writeVarint((int) events.size(), true);
+	for (size_t i = 0; i < events.size(); ++i) {
+		EventData *eventData = events[i];
+		writeStringRef(eventData->getName());
+		writeVarint(eventData->getIntValue(), false);
+		writeFloat(eventData->getFloatValue());
+		writeString(eventData->getStringValue());
+		writeString(eventData->getAudioPath());
+		if (!eventData->getAudioPath().isEmpty()) {
+			writeFloat(eventData->getVolume());
+			writeFloat(eventData->getBalance());
+		}
+	}
+
+	/* Animations. */
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	writeVarint((int) animations.size(), true);
+	for (size_t i = 0; i < animations.size(); ++i) {
+		writeString(animations[i]->getName());
+		if (!writeAnimation(skeletonData, *animations[i])) return false;
+	}
+
+	/* Header and string table. */
+	output.clear();
+	_output = &output;
+	writeInt(0);
+	writeInt(0);
+	const String &version = skeletonData.getVersion();
+	writeString(version.isEmpty() ? String(SPINE_VERSION_STRING) : version);
+	writeFloat(skeletonData.getX());
+	writeFloat(skeletonData.getY());
+	writeFloat(skeletonData.getWidth());
+	writeFloat(skeletonData.getHeight());
+	writeBoolean(_nonessential);
+	if (_nonessential) {
+		writeFloat(skeletonData.getFps());
+		writeString(skeletonData.getImagesPath());
+		writeString(skeletonData.getAudioPath());
+	}
+	writeVarint((int) _strings.size(), true);
+	for (size_t i = 0; i < _strings.size(); ++i)
+		writeString(_strings[i]);
+	output.addAll(body);
+	_output = NULL;
+
+	// The hash identifies the exported data, use a 64 bit FNV-1a hash of everything following it.
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 8; i < output.size(); ++i)
+		hash = (hash ^ output[i]) * 1099511628211ULL;
+	unsigned int low = (unsigned int) hash, high = (unsigned int) (hash >> 32);
+	for (int i = 0; i < 4; ++i) {
+		output[i] = (unsigned char) (low >> (24 - i * 8));
+		output[4 + i] = (unsigned char) (high >> (24 - i * 8));
+	}
+	return true;
+}
+
+void SkeletonBinaryWriter::setError(const char *value1, const char *value2) {
+	_error = String(value1);
+	if (value2) _error.append(value2);
+}
+
+void SkeletonBinaryWriter::writeByte(unsigned char value) {
+	_output->add(value);
+}
+
+void SkeletonBinaryWriter::writeBoolean(bool value) {
+	writeByte(value ? 1 : 0);
+}
+
+void SkeletonBinaryWriter::writeInt(int value) {
+	writeByte((unsigned char) ((unsigned int) value >> 24));
+	writeByte((unsigned char) ((unsigned int) value >> 16));
+	writeByte((unsigned char) ((unsigned int) value >> 8));
+	writeByte((unsigned char) value);
+}
+
+void SkeletonBinaryWriter::writeFloat(float value) {
+	union {
+		int intValue;
+		float floatValue;
+	} floatToInt;
+	floatToInt.floatValue = value;
+	writeInt(floatToInt.intValue);
+}
+
+void SkeletonBinaryWriter::writeValue(float value) {
+	writeFloat(_precision > 0 ? quantize(value, _precision) : value);
+}
+
+void SkeletonBinaryWriter::writeVarint(int value, bool optimizePositive) {
+	unsigned int bits = optimizePositive ? (unsigned int) value : ((unsigned int) value << 1) ^ (unsigned int) (value >> 31);
+	while (bits > 0x7F) {
+		writeByte((unsigned char) ((bits & 0x7F) | 0x80));
+		bits >>= 7;
+	}
+	writeByte((unsigned char) bits);
+}
+
+void SkeletonBinaryWriter::writeString(const String &value) {
+	// Empty strings are written as null, which SkeletonBinary reads back as an empty string.
+	if (value.isEmpty()) {
+		writeVarint(0, true);
+		return;
+	}
+	size_t length = value.length();
+	writeVarint((int) length + 1, true);
+	const char *chars = value.buffer();
+	for (size_t i = 0; i < length; ++i)
+		writeByte((unsigned char) chars[i]);
+}
+
+void SkeletonBinaryWriter::writeStringRef(const String &value) {
+	if (value.isEmpty()) {
+		writeVarint(0, true);
+		return;
+	}
+	int index = _strings.indexOf(value);
+	if (index < 0) {
+		index = (int) _strings.size();
+		_strings.add(value);
+	}
+	writeVarint(index + 1, true);
+}
+
+void SkeletonBinaryWriter::writeColor(const Color &color) {
+	writeByte(toByte(color.r));
+	writeByte(toByte(color.g));
+	writeByte(toByte(color.b));
+	writeByte(toByte(color.a));
+}
+
+void SkeletonBinaryWriter::writeShortArray(Vector<unsigned short> &array) {
+	writeVarint((int) array.size(), true);
+	for (size_t i = 0; i < array.size(); ++i) {
+		writeByte((unsigned char) (array[i] >> 8));
+		writeByte((unsigned char) array[i]);
+	}
+}
+
+bool SkeletonBinaryWriter::writeSkin(SkeletonData &skeletonData, Skin &skin, bool defaultSkin) {
+	if (!defaultSkin) {
+		writeStringRef(skin.getName());
+		Vector<BoneData *> &bones = skin.getBones();
+		writeVarint((int) bones.size(), true);
+		for (size_t i = 0; i < bones.size(); ++i)
+			writeVarint(bones[i]->getIndex(), true);
+
+		Vector<ConstraintData *> &constraints = skin.getConstraints();
+		Vector<int> indices;
+		for (size_t i = 0; i < constraints.size(); ++i)
+			if (constraints[i]->getRTTI().isExactly(IkConstraintData::rtti))
+				indices.add(skeletonData.getIkConstraints().indexOf(static_cast<IkConstraintData *>(constraints[i])));
+		writeVarint((int) indices.size(), true);
+		for (size_t i = 0; i < indices.size(); ++i)
+			writeVarint(indices[i], true);
+
+		indices.clear();
+		for (size_t i = 0; i < constraints.size(); ++i)
+			if (constraints[i]->getRTTI().isExactly(TransformConstraintData::rtti))
+				indices.add(skeletonData.getTransformConstraints().indexOf(static_cast<TransformConstraintData *>(constraints[i])));
+		writeVarint((int) indices.size(), true);
+		for (size_t i = 0; i < indices.size(); ++i)
+			writeVarint(indices[i], true);
+
+		indices.clear();
+		for (size_t i = 0; i < constraints.size(); ++i)
+			if (constraints[i]->getRTTI().isExactly(PathConstraintData::rtti))
+				indices.add(skeletonData.getPathConstraints().indexOf(static_cast<PathConstraintData *>(constraints[i])));
+		writeVarint((int) indices.size(), true);
+		for (size_t i = 0; i < indices.size(); ++i)
+			writeVarint(indices[i], true);
+	}
+
+	size_t slotCount = skeletonData.getSlots().size();
+	Vector<int> attachmentCounts;
+	attachmentCounts.setSize(slotCount, 0);
+	int slotsWithAttachments = 0;
+	Skin::AttachmentMap::Entries entries = skin.getAttachments();
+	while (entries.hasNext()) {
+		Skin::AttachmentMap::Entry &entry = entries.next();
+		if (attachmentCounts[entry._slotIndex]++ == 0) slotsWithAttachments++;
+	}
+
+	writeVarint(slotsWithAttachments, true);
+	for (size_t slotIndex = 0; slotIndex < slotCount; ++slotIndex) {
+		if (attachmentCounts[slotIndex] == 0) continue;
+		writeVarint((int) slotIndex, true);
+		writeVarint(attachmentCounts[slotIndex], true);
+		Skin::AttachmentMap::Entries slotEntries = skin.getAttachments();
+		while (slotEntries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = slotEntries.next();
+			if (entry._slotIndex != slotIndex) continue;
+			writeStringRef(entry._name);
+			if (!writeAttachment(skeletonData, skin, slotIndex, entry._name, entry._attachment)) return false;
+		}
+	}
+	return true;
+}
+
+void SkeletonBinaryWriter::writeSequence(Sequence *sequence) {
+	writeBoolean(sequence != NULL);
+	if (!sequence) return;
+	writeVarint((int) sequence->getRegions().size(), true);
+	writeVarint(sequence->getStart(), true);
+	writeVarint(sequence->getDigits(), true);
+	writeVarint(sequence->getSetupIndex(), true);
+}
+
+bool SkeletonBinaryWriter::writeAttachment(SkeletonData &skeletonData, Skin &skin, size_t slotIndex,
+										   const String &attachmentName, Attachment *attachment) {
+	SP_UNUSED(skin);
+	SP_UNUSED(slotIndex);
+	const String &name = attachment->getName();
+	writeStringRef(name == attachmentName ? String() : name);
+
+	const RTTI &rtti = attachment->getRTTI();
+	if (rtti.isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+		writeByte(AttachmentType_Region);
+		writeStringRef(region->getPath() == name ? String() : region->getPath());
+		writeFloat(region->getRotation());
+		writeFloat(region->getX());
+		writeFloat(region->getY());
+		writeFloat(region->getScaleX());
+		writeFloat(region->getScaleY());
+		writeFloat(region->getWidth());
+		writeFloat(region->getHeight());
+		writeColor(region->getColor());
+		writeSequence(region->getSequence());
+	} else if (rtti.isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+		MeshAttachment *parent = mesh->getParentMesh();
+		if (parent) {
+			String parentName;
+			Skin *parentSkin = findAttachmentSkin(skeletonData, parent, slotIndex, &parentName);
+			if (!parentSkin) {
+				setError("Parent mesh not found: ", name.buffer());
+				return false;
+			}
+			writeByte(AttachmentType_Linkedmesh);
+			writeStringRef(mesh->getPath() == name ? String() : mesh->getPath());
+			writeColor(mesh->getColor());
+			writeStringRef(parentSkin == skeletonData.getDefaultSkin() ? String() : parentSkin->getName());
+			writeStringRef(parentName);
+			writeBoolean(mesh->getTimelineAttachment() != mesh);
+			writeSequence(mesh->getSequence());
+			if (_nonessential) {
+				writeFloat(mesh->getWidth());
+				writeFloat(mesh->getHeight());
+			}
+		} else {
+			writeByte(AttachmentType_Mesh);
+			writeStringRef(mesh->getPath() == name ? String() : mesh->getPath());
+			writeColor(mesh->getColor());
+			Vector<float> &uvs = mesh->getRegionUVs();
+			writeVarint((int) (uvs.size() >> 1), true);
+			for (size_t i = 0; i < uvs.size(); ++i)
+				writeFloat(uvs[i]);
+			writeShortArray(mesh->getTriangles());
+			writeVertices(*mesh);
+			writeVarint(mesh->getHullLength() >> 1, true);
+			writeSequence(mesh->getSequence());
+			if (_nonessential) {
+				writeShortArray(mesh->getEdges());
+				writeFloat(mesh->getWidth());
+				writeFloat(mesh->getHeight());
+			}
+		}
+	} else if (rtti.isExactly(BoundingBoxAttachment::rtti)) {
+		BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
+		writeByte(AttachmentType_Boundingbox);
+		writeVarint((int) (box->getWorldVerticesLength() >> 1), true);
+		writeVertices(*box);
+		if (_nonessential) writeColor(box->getColor());
+	} else if (rtti.isExactly(PathAttachment::rtti)) {
+		PathAttachment *path = static_cast<PathAttachment *>(attachment);
+		writeByte(AttachmentType_Path);
+		writeBoolean(path->isClosed());
+		writeBoolean(path->isConstantSpeed());
+		int vertexCount = (int) (path->getWorldVerticesLength() >> 1);
+		writeVarint(vertexCount, true);
+		writeVertices(*path);
+		Vector<float> &lengths = path->getLengths();
+		for (int i = 0, n = vertexCount / 3; i < n; ++i)
+			writeFloat(i < (int) lengths.size() ? lengths[i] : 0);
+		if (_nonessential) writeColor(path->getColor());
+	} else if (rtti.isExactly(PointAttachment::rtti)) {
+		PointAttachment *point = static_cast<PointAttachment *>(attachment);
+		writeByte(AttachmentType_Point);
+		writeFloat(point->getRotation());
+		writeFloat(point->getX());
+		writeFloat(point->getY());
+		if (_nonessential) writeColor(point->getColor());
+	} else if (rtti.isExactly(ClippingAttachment::rtti)) {
+		ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
+		writeByte(AttachmentType_Clipping);
+		writeVarint(clip->getEndSlot() ? clip->getEndSlot()->getIndex() : 0, true);
+		writeVarint((int) (clip->getWorldVerticesLength() >> 1), true);
+		writeVertices(*clip);
+		if (_nonessential) writeColor(clip->getColor());
+	} else {
+		setError("Unsupported attachment type: ", name.buffer());
+		return false;
+	}
+	return true;
+}
+
+void SkeletonBinaryWriter::writeVertices(VertexAttachment &attachment) {
+	Vector<float> &vertices = attachment.getVertices();
+	Vector<int> &bones = attachment.getBones();
+	writeBoolean(bones.size() > 0);
+	if (bones.size() == 0) {
+		for (size_t i = 0; i < vertices.size(); ++i)
+			writeFloat(vertices[i]);
+		return;
+	}
+	for (size_t v = 0, b = 0; v < bones.size();) {
+		int boneCount = bones[v++];
+		writeVarint(boneCount, true);
+		for (size_t nn = v + boneCount; v < nn; ++v, b += 3) {
+			writeVarint(bones[v], true);
+			writeFloat(vertices[b]);
+			writeFloat(vertices[b + 1]);
+			writeFloat(vertices[b + 2]);
+		}
+	}
+}
+
+Skin *SkeletonBinaryWriter::findAttachmentSkin(SkeletonData &skeletonData, Attachment *attachment, size_t slotIndex,
+											   String *attachmentName) {
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	for (size_t i = 0; i < skins.size(); ++i) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (entry._slotIndex == slotIndex && entry._attachment == attachment) {
+				*attachmentName = entry._name;
+				return skins[i];
+			}
+		}
+	}
+	return NULL;
+}
+
+void SkeletonBinaryWriter::writeCurve(CurveTimeline &timeline, size_t frame, size_t entries, size_t valueCount) {
+	Vector<float> &curves = timeline.getCurves();
+	int curveType = (int) curves[frame];
+	if (curveType < CurveTimeline::BEZIER) {
+		writeByte((unsigned char) curveType);
+		return;
+	}
+	writeByte(SkeletonBinary::CURVE_BEZIER);
+	Vector<float> &frames = timeline.getFrames();
+	float time1 = frames[frame * entries], time2 = frames[(frame + 1) * entries];
+	for (size_t value = 0; value < valueCount; ++value) {
+		size_t i = curveType - CurveTimeline::BEZIER + value * CurveTimeline::BEZIER_SIZE;
+		float value1, value2;
+		if (entries == 1) {
+			// Deform timelines interpolate a percentage.
+			value1 = 0;
+			value2 = 1;
+		} else {
+			value1 = frames[frame * entries + 1 + value];
+			value2 = frames[(frame + 1) * entries + 1 + value];
+		}
+		writeFloat(controlPoint(time1, time2, curves[i + 4], curves[i + 12], true));
+		writeValue(controlPoint(value1, value2, curves[i + 5], curves[i + 13], true));
+		writeFloat(controlPoint(time1, time2, curves[i + 4], curves[i + 12], false));
+		writeValue(controlPoint(value1, value2, curves[i + 5], curves[i + 13], false));
+	}
+}
+
+void SkeletonBinaryWriter::writeFrames(CurveTimeline &timeline, bool colors) {
+	Vector<float> &frames = timeline.getFrames();
+	size_t entries = timeline.getFrameEntries();
+	for (size_t frame = 0, frameCount = timeline.getFrameCount(); frame < frameCount; ++frame) {
+		size_t offset = frame * entries;
+		writeFloat(frames[offset]);
+		for (size_t i = 1; i < entries; ++i) {
+			if (colors)
+				writeByte(toByte(frames[offset + i]));
+			else
+				writeValue(frames[offset + i]);
+		}
+		if (frame > 0) writeCurve(timeline, frame - 1, entries, entries - 1);
+	}
+}
+
+bool SkeletonBinaryWriter::writeAnimation(SkeletonData &skeletonData, Animation &animation) {
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	writeVarint((int) timelines.size(), true);
+
+	// Slot timelines.
+	size_t slotCount = skeletonData.getSlots().size();
+	Vector<int> counts;
+	counts.setSize(slotCount, 0);
+	int groupCount = 0;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		int slotIndex = getSlotIndex(timelines[i]);
+		if (slotIndex >= 0 && counts[slotIndex]++ == 0) groupCount++;
+	}
+	writeVarint(groupCount, true);
+	for (size_t slotIndex = 0; slotIndex < slotCount; ++slotIndex) {
+		if (counts[slotIndex] == 0) continue;
+		writeVarint((int) slotIndex, true);
+		writeVarint(counts[slotIndex], true);
+		for (size_t i = 0; i < timelines.size(); ++i) {
+			Timeline *timeline = timelines[i];
+			if (getSlotIndex(timeline) != (int) slotIndex) continue;
+			const RTTI &rtti = timeline->getRTTI();
+			int type;
+			if (rtti.isExactly(AttachmentTimeline::rtti)) {
+				AttachmentTimeline *attachmentTimeline = static_cast<AttachmentTimeline *>(timeline);
+				writeByte(SkeletonBinary::SLOT_ATTACHMENT);
+				writeVarint((int) timeline->getFrameCount(), true);
+				Vector<float> &frames = timeline->getFrames();
+				Vector<String> &attachmentNames = attachmentTimeline->getAttachmentNames();
+				for (size_t frame = 0; frame < frames.size(); ++frame) {
+					writeFloat(frames[frame]);
+					writeStringRef(attachmentNames[frame]);
+				}
+				continue;
+			} else if (rtti.isExactly(RGBATimeline::rtti))
+				type = SkeletonBinary::SLOT_RGBA;
+			else if (rtti.isExactly(RGBTimeline::rtti))
+				type = SkeletonBinary::SLOT_RGB;
+			else if (rtti.isExactly(RGBA2Timeline::rtti))
+				type = SkeletonBinary::SLOT_RGBA2;
+			else if (rtti.isExactly(RGB2Timeline::rtti))
+				type = SkeletonBinary::SLOT_RGB2;
+			else
+				type = SkeletonBinary::SLOT_ALPHA;
+			CurveTimeline *curveTimeline = static_cast<CurveTimeline *>(timeline);
+			writeByte((unsigned char) type);
+			writeVarint((int) curveTimeline->getFrameCount(), true);
+			writeVarint((int) getBezierCount(*curveTimeline, curveTimeline->getFrameEntries() - 1), true);
+			writeFrames(*curveTimeline, true);
+		}
+	}
+
+	// Bone timelines.
+	size_t boneCount = skeletonData.getBones().size();
+	counts.clear();
+	counts.setSize(boneCount, 0);
+	groupCount = 0;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		int boneIndex;
+		if (getBoneTimelineType(timelines[i], boneIndex) >= 0 && counts[boneIndex]++ == 0) groupCount++;
+	}
+	writeVarint(groupCount, true);
+	for (size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex) {
+		if (counts[boneIndex] == 0) continue;
+		writeVarint((int) boneIndex, true);
+		writeVarint(counts[boneIndex], true);
+		for (size_t i = 0; i < timelines.size(); ++i) {
+			int timelineBoneIndex;
+			int type = getBoneTimelineType(timelines[i], timelineBoneIndex);
+			if (type < 0 || timelineBoneIndex != (int) boneIndex) continue;
+			CurveTimeline *timeline = static_cast<CurveTimeline *>(timelines[i]);
+			writeByte((unsigned char) type);
+			writeVarint((int) timeline->getFrameCount(), true);
+			writeVarint((int) getBezierCount(*timeline, timeline->getFrameEntries() - 1), true);
+			writeFrames(*timeline, false);
+		}
+	}
+
+	// IK timelines.
+	groupCount = 0;
+	for (size_t i = 0; i < timelines.size(); ++i)
+		if (timelines[i]->getRTTI().isExactly(IkConstraintTimeline::rtti)) groupCount++;
+	writeVarint(groupCount, true);
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		if (!timelines[i]->getRTTI().isExactly(IkConstraintTimeline::rtti)) continue;
+		IkConstraintTimeline *timeline = static_cast<IkConstraintTimeline *>(timelines[i]);
+		Vector<float> &frames = timeline->getFrames();
+		size_t entries = timeline->getFrameEntries();
+		writeVarint(timeline->getIkConstraintIndex(), true);
+		writeVarint((int) timeline->getFrameCount(), true);
+		writeVarint((int) getBezierCount(*timeline, 2), true);
+		for (size_t frame = 0, frameCount = timeline->getFrameCount(); frame < frameCount; ++frame) {
+			size_t offset = frame * entries;
+			if (frame > 0) {
+				writeFloat(frames[offset]);
+				writeValue(frames[offset + 1]);
+				writeValue(frames[offset + 2]);
+				writeCurve(*timeline, frame - 1, entries, 2);
+			} else {
+				writeFloat(frames[0]);
+				writeValue(frames[1]);
+				writeValue(frames[2]);
+			}
+			writeByte((unsigned char) (signed char) frames[offset + 3]);
+			writeBoolean(frames[offset + 4] != 0);
+			writeBoolean(frames[offset + 5] != 0);
+		}
+	}
+
+	// Transform constraint timelines.
+	groupCount = 0;
+	for (size_t i = 0; i < timelines.size(); ++i)
+		if (timelines[i]->getRTTI().isExactly(TransformConstraintTimeline::rtti)) groupCount++;
+	writeVarint(groupCount, true);
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		if (!timelines[i]->getRTTI().isExactly(TransformConstraintTimeline::rtti)) continue;
+		TransformConstraintTimeline *timeline = static_cast<TransformConstraintTimeline *>(timelines[i]);
+		writeVarint(timeline->getTransformConstraintIndex(), true);
+		writeVarint((int) timeline->getFrameCount(), true);
+		writeVarint((int) getBezierCount(*timeline, timeline->getFrameEntries() - 1), true);
+		writeFrames(*timeline, false);
+	}
+
+	// Path constraint timelines.
+	size_t pathCount = skeletonData.getPathConstraints().size();
+	counts.clear();
+	counts.setSize(pathCount, 0);
+	groupCount = 0;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		int constraintIndex;
+		if (getPathTimelineType(timelines[i], constraintIndex) >= 0 && counts[constraintIndex]++ == 0) groupCount++;
+	}
+	writeVarint(groupCount, true);
+	for (size_t constraintIndex = 0; constraintIndex < pathCount; ++constraintIndex) {
+		if (counts[constraintIndex] == 0) continue;
+		writeVarint((int) constraintIndex, true);
+		writeVarint(counts[constraintIndex], true);
+		for (size_t i = 0; i < timelines.size(); ++i) {
+			int timelineConstraintIndex;
+			int type = getPathTimelineType(timelines[i], timelineConstraintIndex);
+			if (type < 0 || timelineConstraintIndex != (int) constraintIndex) continue;
+			CurveTimeline *timeline = static_cast<CurveTimeline *>(timelines[i]);
+			writeByte((unsigned char) type);
+			writeVarint((int) timeline->getFrameCount(), true);
+			writeVarint((int) getBezierCount(*timeline, timeline->getFrameEntries() - 1), true);
+			writeFrames(*timeline, false);
+		}
+	}
+
+	// Deform and sequence timelines, grouped by the skin and slot holding their attachment.
+	Vector<Skin *> outputSkins;
+	Skin *defaultSkin = skeletonData.getDefaultSkin();
+	if (defaultSkin) outputSkins.add(defaultSkin);
+	for (size_t i = 0; i < skeletonData.getSkins().size(); ++i)
+		if (skeletonData.getSkins()[i] != defaultSkin) outputSkins.add(skeletonData.getSkins()[i]);
+
+	Vector<AttachmentTimelineEntry> attachmentTimelines;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		Timeline *timeline = timelines[i];
+		Attachment *attachment;
+		size_t slotIndex;
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			attachment = static_cast<DeformTimeline *>(timeline)->getAttachment();
+			slotIndex = static_cast<DeformTimeline *>(timeline)->getSlotIndex();
+		} else if (timeline->getRTTI().isExactly(SequenceTimeline::rtti)) {
+			attachment = static_cast<SequenceTimeline *>(timeline)->getAttachment();
+			slotIndex = static_cast<SequenceTimeline *>(timeline)->getSlotIndex();
+		} else
+			continue;
+		AttachmentTimelineEntry entry;
+		entry.timeline = timeline;
+		entry.slotIndex = slotIndex;
+		Skin *skin = findAttachmentSkin(skeletonData, attachment, slotIndex, &entry.attachmentName);
+		if (!skin) {
+			setError("Timeline attachment not found in any skin, animation: ", animation.getName().buffer());
+			return false;
+		}
+		entry.skinIndex = outputSkins.indexOf(skin);
+		attachmentTimelines.add(entry);
+	}
+
+	groupCount = 0;
+	for (size_t skinIndex = 0; skinIndex < outputSkins.size(); ++skinIndex) {
+		for (size_t i = 0; i < attachmentTimelines.size(); ++i) {
+			if (attachmentTimelines[i].skinIndex == skinIndex) {
+				groupCount++;
+				break;
+			}
+		}
+	}
+	writeVarint(groupCount, true);
+	for (size_t skinIndex = 0; skinIndex < outputSkins.size(); ++skinIndex) {
+		counts.clear();
+		counts.setSize(slotCount, 0);
+		int slotGroupCount = 0;
+		for (size_t i = 0; i < attachmentTimelines.size(); ++i)
+			if (attachmentTimelines[i].skinIndex == skinIndex && counts[attachmentTimelines[i].slotIndex]++ == 0) slotGroupCount++;
+		if (slotGroupCount == 0) continue;
+		writeVarint((int) skinIndex, true);
+		writeVarint(slotGroupCount, true);
+		for (size_t slotIndex = 0; slotIndex < slotCount; ++slotIndex) {
+			if (counts[slotIndex] == 0) continue;
+			writeVarint((int) slotIndex, true);
+			writeVarint(counts[slotIndex], true);
+			for (size_t i = 0; i < attachmentTimelines.size(); ++i) {
+				AttachmentTimelineEntry &entry = attachmentTimelines[i];
+				if (entry.skinIndex != skinIndex || entry.slotIndex != slotIndex) continue;
+				writeStringRef(entry.attachmentName);
+				if (entry.timeline->getRTTI().isExactly(SequenceTimeline::rtti)) {
+					SequenceTimeline *timeline = static_cast<SequenceTimeline *>(entry.timeline);
+					Vector<float> &frames = timeline->getFrames();
+					size_t entries = timeline->getFrameEntries();
+					writeByte(SkeletonBinary::ATTACHMENT_SEQUENCE);
+					writeVarint((int) timeline->getFrameCount(), true);
+					for (size_t frame = 0; frame < frames.size(); frame += entries) {
+						writeFloat(frames[frame]);
+						writeInt((int) frames[frame + 1]);
+						writeFloat(frames[frame + 2]);
+					}
+					continue;
+				}
+
+				DeformTimeline *timeline = static_cast<DeformTimeline *>(entry.timeline);
+				VertexAttachment *attachment = timeline->getAttachment();
+				bool weighted = attachment->getBones().size() > 0;
+				Vector<float> &setupVertices = attachment->getVertices();
+				Vector<float> &frames = timeline->getFrames();
+				writeByte(SkeletonBinary::ATTACHMENT_DEFORM);
+				writeVarint((int) timeline->getFrameCount(), true);
+				writeVarint((int) getBezierCount(*timeline, 1), true);
+				for (size_t frame = 0, frameCount = timeline->getFrameCount(); frame < frameCount; ++frame) {
+					writeFloat(frames[frame]);
+					if (frame > 0) writeCurve(*timeline, frame - 1, 1, 1);
+					timeline->getFrameVertices(frame, _deform);
+					if (!weighted) {
+						for (size_t v = 0; v < _deform.size(); ++v)
+							_deform[v] -= setupVertices[v];
+					}
+					if (_precision > 0) {
+						for (size_t v = 0; v < _deform.size(); ++v)
+							_deform[v] = quantize(_deform[v], _precision);
+					}
+					size_t start = 0, end = _deform.size();
+					while (start < end && _deform[start] == 0)
+						start++;
+					while (end > start && _deform[end - 1] == 0)
+						end--;
+					writeVarint((int) (end - start), true);
+					if (end == start) continue;
+					writeVarint((int) start, true);
+					for (size_t v = start; v < end; ++v)
+						writeFloat(_deform[v]);
+				}
+			}
+		}
+	}
+
+	// Draw order timeline.
+	DrawOrderTimeline *drawOrderTimeline = NULL;
+	EventTimeline *eventTimeline = NULL;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		if (timelines[i]->getRTTI().isExactly(DrawOrderTimeline::rtti))
+			drawOrderTimeline = static_cast<DrawOrderTimeline *>(timelines[i]);
+		else if (timelines[i]->getRTTI().isExactly(EventTimeline::rtti))
+			eventTimeline = static_cast<EventTimeline *>(timelines[i]);
+	}
+	if (drawOrderTimeline) {
+		Vector<float> &frames = drawOrderTimeline->getFrames();
+		Vector<Vector<int> > &drawOrders = drawOrderTimeline->getDrawOrders();
+		writeVarint((int) frames.size(), true);
+		Vector<int> offsets;
+		for (size_t frame = 0; frame < frames.size(); ++frame) {
+			writeFloat(frames[frame]);
+			Vector<int> &drawOrder = drawOrders[frame];
+			// Offsets are written in slot order: for each moved slot, its index and the distance to its new position.
+			offsets.clear();
+			offsets.setSize(drawOrder.size(), 0);
+			int changed = 0;
+			for (size_t index = 0; index < drawOrder.size(); ++index) {
+				offsets[drawOrder[index]] = (int) index - drawOrder[index];
+				if (offsets[drawOrder[index]] != 0) changed++;
+			}
+			writeVarint(changed, true);
+			for (size_t slotIndex = 0; slotIndex < offsets.size(); ++slotIndex) {
+				if (offsets[slotIndex] == 0) continue;
+				writeVarint((int) slotIndex, true);
+				writeVarint(offsets[slotIndex], true);
+			}
+		}
+	} else
+		writeVarint(0, true);
+
+	// Event timeline.
+	if (eventTimeline) {
+		Vector<Event *> &events = eventTimeline->getEvents();
+		writeVarint((int) events.size(), true);
+		for (size_t i = 0; i < events.size(); ++i) {
+			Event *event = events[i];
+			const EventData &eventData = event->getData();
+			writeFloat(event->getTime());
+			writeVarint(skeletonData.getEvents().indexOf(const_cast<EventData *>(&eventData)), true);
+			writeVarint(event->getIntValue(), false);
+			writeFloat(event->getFloatValue());
+			bool ownString = !(event->getStringValue() == eventData.getStringValue());
+			writeBoolean(ownString);
+			if (ownString) writeString(event->getStringValue());
+			if (!eventData.getAudioPath().isEmpty()) {
+				writeFloat(event->getVolume());
+				writeFloat(event->getBalance());
+			}
+		}
+	} else
+		writeVarint(0, true);
+	return true;
+}
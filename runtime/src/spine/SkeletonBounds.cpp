@@ -39,7 +39,7 @@
 
 using namespace spine;
 
-SkeletonBounds::SkeletonBounds() : _minX(0), _minY(0), _maxX(0), _maxY(0) {
+SkeletonBounds::SkeletonBounds() : _skeleton(NULL), _minX(0), _minY(0), _maxX(0), _maxY(0), _aabbDirty(false) {
 }
 
 SkeletonBounds::~SkeletonBounds() {
@@ -51,14 +51,10 @@ SkeletonBounds::~SkeletonBounds() {
 void SkeletonBounds::update(Skeleton &skeleton, bool updateAabb) {
 	Vector<Slot *> &slots = skeleton.getSlots();
 	size_t slotCount = slots.size();
+	_skeleton = &skeleton;
 
-	_boundingBoxes.clear();
-	for (size_t i = 0, n = _polygons.size(); i < n; ++i) {
-		_polygonPool.free(_polygons[i]);
-	}
-
-	_polygons.clear();
-
+	// Polygons are kept for bounding boxes that are in the same place as in the last update, so they can be reused.
+	size_t count = 0;
 	for (size_t i = 0; i < slotCount; i++) {
 		Slot *slot = slots[i];
 		if (!slot->getBone().isActive()) continue;
@@ -66,36 +62,121 @@ void SkeletonBounds::update(Skeleton &skeleton, bool updateAabb) {
 		Attachment *attachment = slot->getAttachment();
 		if (attachment == NULL || !attachment->getRTTI().instanceOf(BoundingBoxAttachment::rtti)) continue;
 		BoundingBoxAttachment *boundingBox = static_cast<BoundingBoxAttachment *>(attachment);
-		_boundingBoxes.add(boundingBox);
-
-		spine::Polygon *polygonP = _polygonPool.obtain();
-		_polygons.add(polygonP);
 
-		Polygon &polygon = *polygonP;
-
-		size_t count = boundingBox->getWorldVerticesLength();
-		polygon._count = (int) count;
-		if (polygon._vertices.size() < count) {
-			polygon._vertices.setSize(count, 0);
+		if (count == _polygons.size()) {
+			spine::Polygon *polygon = _polygonPool.obtain();
+			polygon->_pose.clear();
+			_polygons.add(polygon);
+			_boundingBoxes.add(boundingBox);
+			_slots.add(slot);
+		} else if (_boundingBoxes[count] != boundingBox || _slots[count] != slot) {
+			_polygons[count]->_pose.clear();
+			_boundingBoxes[count] = boundingBox;
+			_slots[count] = slot;
 		}
-		boundingBox->computeWorldVertices(*slot, polygon._vertices);
+		_polygons[count]->_dirty = true;
+		count++;
 	}
-
-	if (updateAabb)
-		aabbCompute();
-	else {
-		_minX = FLT_MIN;
-		_minY = FLT_MIN;
+	for (size_t i = count, n = _polygons.size(); i < n; i++)
+		_polygonPool.free(_polygons[i]);
+	_polygons.setSize(count, NULL);
+	_boundingBoxes.setSize(count, NULL);
+	_slots.setSize(count, NULL);
+
+	_aabbDirty = updateAabb;
+	if (!updateAabb) {
+		_minX = -FLT_MAX;
+		_minY = -FLT_MAX;
 		_maxX = FLT_MAX;
 		_maxY = FLT_MAX;
 	}
 }
 
+spine::Polygon *SkeletonBounds::computePolygon(size_t index) {
+	spine::Polygon *polygonP = _polygons[index];
+	if (!polygonP->_dirty) return polygonP;
+	Polygon &polygon = *polygonP;
+	polygon._dirty = false;
+
+	Slot &slot = *_slots[index];
+	BoundingBoxAttachment *boundingBox = _boundingBoxes[index];
+
+	// The world vertices only depend on the bone transforms and the deform. They are compared with the ones the vertices
+	// were computed from while being stored in their place.
+	Vector<int> &bones = boundingBox->getBones();
+	Vector<float> &deform = slot.getDeform();
+	size_t count = boundingBox->getWorldVerticesLength();
+	size_t poseLength = (bones.size() == 0 ? 6 : (bones.size() - (count >> 1)) * 6) + deform.size();
+	Vector<float> &pose = polygon._pose;
+	bool changed = pose.size() != poseLength;
+	if (changed) pose.setSize(poseLength, 0);
+	float *posePtr = pose.buffer();
+	if (bones.size() == 0)
+		changed |= updatePose(slot.getBone(), posePtr);
+	else {
+		Vector<Bone *> &skeletonBones = _skeleton->getBones();
+		for (size_t i = 0, n = bones.size(); i < n;) {
+			size_t nn = bones[i++];
+			nn += i;
+			for (; i < nn; i++, posePtr += 6)
+				changed |= updatePose(*skeletonBones[bones[i]], posePtr);
+		}
+	}
+	for (size_t i = 0, n = deform.size(); i < n; i++) {
+		if (posePtr[i] != deform[i]) {
+			posePtr[i] = deform[i];
+			changed = true;
+		}
+	}
+	if (!changed) return polygonP;
+
+	polygon._count = (int) count;
+	if (polygon._vertices.size() < count) {
+		polygon._vertices.setSize(count, 0);
+	}
+	boundingBox->computeWorldVertices(slot, polygon._vertices);
+
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	Vector<float> &vertices = polygon._vertices;
+	for (size_t ii = 0; ii < count; ii += 2) {
+		float x = vertices[ii];
+		float y = vertices[ii + 1];
+		minX = MathUtil::min(minX, x);
+		minY = MathUtil::min(minY, y);
+		maxX = MathUtil::max(maxX, x);
+		maxY = MathUtil::max(maxY, y);
+	}
+	polygon._minX = minX;
+	polygon._minY = minY;
+	polygon._maxX = maxX;
+	polygon._maxY = maxY;
+	return polygonP;
+}
+
+void SkeletonBounds::computePolygons() {
+	for (size_t i = 0, n = _polygons.size(); i < n; ++i)
+		computePolygon(i);
+}
+
+bool SkeletonBounds::updatePose(Bone &bone, float *pose) {
+	bool changed = pose[0] != bone._a || pose[1] != bone._b || pose[2] != bone._c || pose[3] != bone._d ||
+				   pose[4] != bone._worldX || pose[5] != bone._worldY;
+	pose[0] = bone._a;
+	pose[1] = bone._b;
+	pose[2] = bone._c;
+	pose[3] = bone._d;
+	pose[4] = bone._worldX;
+	pose[5] = bone._worldY;
+	return changed;
+}
+
 bool SkeletonBounds::aabbcontainsPoint(float x, float y) {
+	if (_aabbDirty) aabbCompute();
 	return x >= _minX && x <= _maxX && y >= _minY && y <= _maxY;
 }
 
 bool SkeletonBounds::aabbintersectsSegment(float x1, float y1, float x2, float y2) {
+	if (_aabbDirty) aabbCompute();
 	float minX = _minX;
 	float minY = _minY;
 	float maxX = _maxX;
@@ -118,7 +199,9 @@ bool SkeletonBounds::aabbintersectsSegment(float x1, float y1, float x2, float y
 	return false;
 }
 
-bool SkeletonBounds::aabbIntersectsSkeleton(SkeletonBounds bounds) {
+bool SkeletonBounds::aabbIntersectsSkeleton(SkeletonBounds &bounds) {
+	if (_aabbDirty) aabbCompute();
+	if (bounds._aabbDirty) bounds.aabbCompute();
 	return _minX < bounds._maxX && _maxX > bounds._minX && _minY < bounds._maxY && _maxY > bounds._minY;
 }
 
@@ -143,17 +226,37 @@ bool SkeletonBounds::containsPoint(spine::Polygon *polygon, float x, float y) {
 }
 
 BoundingBoxAttachment *SkeletonBounds::containsPoint(float x, float y) {
-	for (size_t i = 0, n = _polygons.size(); i < n; ++i)
-		if (containsPoint(_polygons[i], x, y)) return _boundingBoxes[i];
+	for (size_t i = 0, n = _polygons.size(); i < n; ++i) {
+		spine::Polygon *polygon = computePolygon(i);
+		if (polygon->aabbContainsPoint(x, y) && containsPoint(polygon, x, y)) return _boundingBoxes[i];
+	}
 	return NULL;
 }
 
 BoundingBoxAttachment *SkeletonBounds::intersectsSegment(float x1, float y1, float x2, float y2) {
-	for (size_t i = 0, n = _polygons.size(); i < n; ++i)
-		if (intersectsSegment(_polygons[i], x1, y1, x2, y2)) return _boundingBoxes[i];
+	float minX = MathUtil::min(x1, x2), minY = MathUtil::min(y1, y2);
+	float maxX = MathUtil::max(x1, x2), maxY = MathUtil::max(y1, y2);
+	for (size_t i = 0, n = _polygons.size(); i < n; ++i) {
+		spine::Polygon *polygon = computePolygon(i);
+		if (maxX < polygon->_minX || minX > polygon->_maxX || maxY < polygon->_minY || minY > polygon->_maxY) continue;
+		if (intersectsSegment(polygon, x1, y1, x2, y2)) return _boundingBoxes[i];
+	}
 	return NULL;
 }
 
+int SkeletonBounds::containsPoints(Vector<float> &points, Vector<BoundingBoxAttachment *> &hits) {
+	size_t count = points.size() >> 1;
+	hits.setSize(count, NULL);
+	int hitCount = 0;
+	for (size_t i = 0, p = 0; i < count; i++, p += 2) {
+		float x = points[p], y = points[p + 1];
+		BoundingBoxAttachment *hit = aabbcontainsPoint(x, y) ? containsPoint(x, y) : NULL;
+		hits[i] = hit;
+		if (hit) hitCount++;
+	}
+	return hitCount;
+}
+
 bool SkeletonBounds::intersectsSegment(spine::Polygon *polygon, float x1, float y1, float x2, float y2) {
 	Vector<float> &vertices = polygon->_vertices;
 	size_t nn = polygon->_count;
@@ -182,7 +285,7 @@ bool SkeletonBounds::intersectsSegment(spine::Polygon *polygon, float x1, float
 
 spine::Polygon *SkeletonBounds::getPolygon(BoundingBoxAttachment *attachment) {
 	int index = _boundingBoxes.indexOf(attachment);
-	return index == -1 ? NULL : _polygons[index];
+	return index == -1 ? NULL : computePolygon(index);
 }
 
 BoundingBoxAttachment *SkeletonBounds::getBoundingBox(Polygon *polygon) {
@@ -191,6 +294,7 @@ BoundingBoxAttachment *SkeletonBounds::getBoundingBox(Polygon *polygon) {
 }
 
 Vector<spine::Polygon *> &SkeletonBounds::getPolygons() {
+	computePolygons();
 	return _polygons;
 }
 
@@ -199,33 +303,31 @@ Vector<BoundingBoxAttachment *> &SkeletonBounds::getBoundingBoxes() {
 }
 
 float SkeletonBounds::getWidth() {
+	if (_aabbDirty) aabbCompute();
 	return _maxX - _minX;
 }
 
 float SkeletonBounds::getHeight() {
+	if (_aabbDirty) aabbCompute();
 	return _maxY - _minY;
 }
 
 void SkeletonBounds::aabbCompute() {
 	float minX = FLT_MAX;
 	float minY = FLT_MAX;
-	float maxX = FLT_MIN;
-	float maxY = FLT_MIN;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
 
 	for (size_t i = 0, n = _polygons.size(); i < n; ++i) {
-		spine::Polygon *polygon = _polygons[i];
-		Vector<float> &vertices = polygon->_vertices;
-		for (int ii = 0, nn = polygon->_count; ii < nn; ii += 2) {
-			float x = vertices[ii];
-			float y = vertices[ii + 1];
-			minX = MathUtil::min(minX, x);
-			minY = MathUtil::min(minY, y);
-			maxX = MathUtil::max(maxX, x);
-			maxY = MathUtil::max(maxY, y);
-		}
+		spine::Polygon *polygon = computePolygon(i);
+		minX = MathUtil::min(minX, polygon->_minX);
+		minY = MathUtil::min(minY, polygon->_minY);
+		maxX = MathUtil::max(maxX, polygon->_maxX);
+		maxY = MathUtil::max(maxY, polygon->_maxY);
 	}
 	_minX = minX;
 	_minY = minY;
 	_maxX = maxX;
 	_maxY = maxY;
+	_aabbDirty = false;
 }
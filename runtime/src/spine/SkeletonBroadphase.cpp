@@ -0,0 +1,625 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SkeletonBroadphase.h>
+
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/BoundingBoxAttachment.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonBounds.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+#include <float.h>
+
+using namespace spine;
+
+namespace {
+	template<typename N>
+	inline float perimeter(const N &node) {
+		return (node.maxX - node.minX) + (node.maxY - node.minY);
+	}
+
+	template<typename N>
+	inline float combinedPerimeter(const N &a, const N &b) {
+		return (MathUtil::max(a.maxX, b.maxX) - MathUtil::min(a.minX, b.minX)) +
+			   (MathUtil::max(a.maxY, b.maxY) - MathUtil::min(a.minY, b.minY));
+	}
+
+	template<typename N>
+	inline void combine(N &node, const N &a, const N &b) {
+		node.minX = MathUtil::min(a.minX, b.minX);
+		node.minY = MathUtil::min(a.minY, b.minY);
+		node.maxX = MathUtil::max(a.maxX, b.maxX);
+		node.maxY = MathUtil::max(a.maxY, b.maxY);
+	}
+
+	bool segmentIntersectsAabb(float x1, float y1, float x2, float y2, float minX, float minY, float maxX, float maxY) {
+		float t1 = 0, t2 = 1;
+		float dx = x2 - x1, dy = y2 - y1;
+		if (dx == 0) {
+			if (x1 < minX || x1 > maxX) return false;
+		} else {
+			float near = (minX - x1) / dx, far = (maxX - x1) / dx;
+			if (near > far) {
+				float t = near;
+				near = far;
+				far = t;
+			}
+			t1 = MathUtil::max(t1, near);
+			t2 = MathUtil::min(t2, far);
+			if (t1 > t2) return false;
+		}
+		if (dy == 0) return y1 >= minY && y1 <= maxY;
+		float near = (minY - y1) / dy, far = (maxY - y1) / dy;
+		if (near > far) {
+			float t = near;
+			near = far;
+			far = t;
+		}
+		return MathUtil::max(t1, near) <= MathUtil::min(t2, far);
+	}
+}
+
+SkeletonBroadphase::SkeletonBroadphase() : _proxyCount(0), _root(-1), _freeNode(-1), _margin(0.1f) {
+}
+
+SkeletonBroadphase::~SkeletonBroadphase() {
+	for (size_t i = 0, n = _proxies.size(); i < n; i++) {
+		Proxy *proxy = _proxies[i];
+		if (proxy == NULL) continue;
+		if (proxy->_bounds) delete proxy->_bounds;
+		delete proxy;
+	}
+	ContainerUtil::cleanUpVectorOfPointers(_radii);
+}
+
+int SkeletonBroadphase::add(Skeleton *skeleton, void *userData) {
+	Proxy *proxy = new (__FILE__, __LINE__) Proxy();
+	proxy->_skeleton = skeleton;
+	proxy->_userData = userData;
+	proxy->_radii = getRadii(*skeleton->getData());
+	proxy->_a = 1;
+	proxy->_b = 0;
+	proxy->_c = 0;
+	proxy->_d = 1;
+	proxy->_worldX = 0;
+	proxy->_worldY = 0;
+	proxy->_node = -1;
+	proxy->_bounds = NULL;
+	proxy->_boundsDirty = true;
+
+	int id;
+	if (_freeProxies.size() > 0) {
+		id = _freeProxies[_freeProxies.size() - 1];
+		_freeProxies.removeAt(_freeProxies.size() - 1);
+		_proxies[id] = proxy;
+	} else {
+		id = (int) _proxies.size();
+		_proxies.add(proxy);
+	}
+	_proxyCount++;
+	update(id);
+	return id;
+}
+
+void SkeletonBroadphase::remove(int id) {
+	Proxy *proxy = _proxies[id];
+	if (proxy->_node != -1) {
+		removeLeaf(proxy->_node);
+		freeNode(proxy->_node);
+	}
+
+	// The radii are forgotten with the last proxy of the skeleton data, which may then be disposed.
+	int index = _radii.indexOf(proxy->_radii);
+	if (--_radiiReferences[index] == 0) {
+		delete _radii[index];
+		_radii.removeAt(index);
+		_radiiData.removeAt(index);
+		_radiiReferences.removeAt(index);
+	}
+
+	if (proxy->_bounds) delete proxy->_bounds;
+	delete proxy;
+	_proxies[id] = NULL;
+	_freeProxies.add(id);
+	_proxyCount--;
+}
+
+void SkeletonBroadphase::setTransform(int proxy, float a, float b, float c, float d, float worldX, float worldY) {
+	Proxy &p = *_proxies[proxy];
+	p._a = a;
+	p._b = b;
+	p._c = c;
+	p._d = d;
+	p._worldX = worldX;
+	p._worldY = worldY;
+}
+
+void SkeletonBroadphase::update(int id) {
+	Proxy &proxy = *_proxies[id];
+	proxy._boundsDirty = true;
+
+	float minX, minY, maxX, maxY;
+	if (!computeBounds(proxy, minX, minY, maxX, maxY)) {
+		// A skeleton without bounding boxes can't be hit.
+		if (proxy._node != -1) {
+			removeLeaf(proxy._node);
+			freeNode(proxy._node);
+			proxy._node = -1;
+		}
+		return;
+	}
+
+	float margin = _margin * MathUtil::max(maxX - minX, maxY - minY);
+	if (proxy._node != -1) {
+		Node &node = _nodes[proxy._node];
+		if (minX >= node.minX && minY >= node.minY && maxX <= node.maxX && maxY <= node.maxY) {
+			// Keep the enlarged bounds unless they became much larger than needed.
+			float limit = margin * 4;
+			if (node.minX >= minX - limit && node.minY >= minY - limit && node.maxX <= maxX + limit &&
+				node.maxY <= maxY + limit)
+				return;
+		}
+		removeLeaf(proxy._node);
+	} else {
+		proxy._node = allocateNode();
+		_nodes[proxy._node].proxy = id;
+	}
+
+	Node &node = _nodes[proxy._node];
+	node.minX = minX - margin;
+	node.minY = minY - margin;
+	node.maxX = maxX + margin;
+	node.maxY = maxY + margin;
+	insertLeaf(proxy._node);
+}
+
+void SkeletonBroadphase::updateAll() {
+	for (size_t i = 0, n = _proxies.size(); i < n; i++)
+		if (_proxies[i] != NULL) update((int) i);
+}
+
+Skeleton *SkeletonBroadphase::getSkeleton(int proxy) {
+	return _proxies[proxy]->_skeleton;
+}
+
+void *SkeletonBroadphase::getUserData(int proxy) {
+	return _proxies[proxy]->_userData;
+}
+
+void SkeletonBroadphase::queryPoint(float x, float y, Vector<int> &proxies) {
+	proxies.clear();
+	if (_root == -1) return;
+	_stack.clear();
+	_stack.add(_root);
+	while (_stack.size() > 0) {
+		Node &node = _nodes[_stack[_stack.size() - 1]];
+		_stack.removeAt(_stack.size() - 1);
+		if (x < node.minX || x > node.maxX || y < node.minY || y > node.maxY) continue;
+		if (node.child1 == -1)
+			proxies.add(node.proxy);
+		else {
+			_stack.add(node.child1);
+			_stack.add(node.child2);
+		}
+	}
+}
+
+void SkeletonBroadphase::queryAabb(float minX, float minY, float maxX, float maxY, Vector<int> &proxies) {
+	proxies.clear();
+	if (_root == -1) return;
+	_stack.clear();
+	_stack.add(_root);
+	while (_stack.size() > 0) {
+		Node &node = _nodes[_stack[_stack.size() - 1]];
+		_stack.removeAt(_stack.size() - 1);
+		if (maxX < node.minX || minX > node.maxX || maxY < node.minY || minY > node.maxY) continue;
+		if (node.child1 == -1)
+			proxies.add(node.proxy);
+		else {
+			_stack.add(node.child1);
+			_stack.add(node.child2);
+		}
+	}
+}
+
+void SkeletonBroadphase::querySegment(float x1, float y1, float x2, float y2, Vector<int> &proxies) {
+	proxies.clear();
+	if (_root == -1) return;
+	_stack.clear();
+	_stack.add(_root);
+	while (_stack.size() > 0) {
+		Node &node = _nodes[_stack[_stack.size() - 1]];
+		_stack.removeAt(_stack.size() - 1);
+		if (!segmentIntersectsAabb(x1, y1, x2, y2, node.minX, node.minY, node.maxX, node.maxY)) continue;
+		if (node.child1 == -1)
+			proxies.add(node.proxy);
+		else {
+			_stack.add(node.child1);
+			_stack.add(node.child2);
+		}
+	}
+}
+
+int SkeletonBroadphase::containsPoint(float x, float y, Vector<int> &proxies) {
+	queryPoint(x, y, _candidates);
+	proxies.clear();
+	for (size_t i = 0, n = _candidates.size(); i < n; i++)
+		if (containsPoint(_candidates[i], x, y)) proxies.add(_candidates[i]);
+	return (int) proxies.size();
+}
+
+int SkeletonBroadphase::intersectsSegment(float x1, float y1, float x2, float y2, Vector<int> &proxies) {
+	querySegment(x1, y1, x2, y2, _candidates);
+	proxies.clear();
+	for (size_t i = 0, n = _candidates.size(); i < n; i++)
+		if (intersectsSegment(_candidates[i], x1, y1, x2, y2)) proxies.add(_candidates[i]);
+	return (int) proxies.size();
+}
+
+BoundingBoxAttachment *SkeletonBroadphase::containsPoint(int id, float x, float y) {
+	Proxy &proxy = *_proxies[id];
+	float det = proxy._a * proxy._d - proxy._b * proxy._c;
+	if (det == 0) return NULL;
+	float invDet = 1 / det;
+	x -= proxy._worldX;
+	y -= proxy._worldY;
+	float skeletonX = (proxy._d * x - proxy._b * y) * invDet, skeletonY = (proxy._a * y - proxy._c * x) * invDet;
+
+	SkeletonBounds &bounds = getBounds(proxy);
+	if (!bounds.aabbcontainsPoint(skeletonX, skeletonY)) return NULL;
+	return bounds.containsPoint(skeletonX, skeletonY);
+}
+
+BoundingBoxAttachment *SkeletonBroadphase::intersectsSegment(int id, float x1, float y1, float x2, float y2) {
+	Proxy &proxy = *_proxies[id];
+	float det = proxy._a * proxy._d - proxy._b * proxy._c;
+	if (det == 0) return NULL;
+	float invDet = 1 / det;
+	x1 -= proxy._worldX;
+	y1 -= proxy._worldY;
+	x2 -= proxy._worldX;
+	y2 -= proxy._worldY;
+	float skeletonX1 = (proxy._d * x1 - proxy._b * y1) * invDet, skeletonY1 = (proxy._a * y1 - proxy._c * x1) * invDet;
+	float skeletonX2 = (proxy._d * x2 - proxy._b * y2) * invDet, skeletonY2 = (proxy._a * y2 - proxy._c * x2) * invDet;
+
+	SkeletonBounds &bounds = getBounds(proxy);
+	if (!bounds.aabbintersectsSegment(skeletonX1, skeletonY1, skeletonX2, skeletonY2)) return NULL;
+	return bounds.intersectsSegment(skeletonX1, skeletonY1, skeletonX2, skeletonY2);
+}
+
+int SkeletonBroadphase::getHeight() {
+	return _root == -1 ? 0 : _nodes[_root].height;
+}
+
+Vector<float> *SkeletonBroadphase::getRadii(SkeletonData &skeletonData) {
+	int index = _radiiData.indexOf(&skeletonData);
+	if (index != -1) {
+		_radiiReferences[index]++;
+		return _radii[index];
+	}
+
+	// For each bone, the distance of the farthest bounding box vertex it moves, or -1.
+	Vector<float> *radiiP = new (__FILE__, __LINE__) Vector<float>();
+	Vector<float> &radii = *radiiP;
+	radii.setSize(skeletonData.getBones().size(), -1);
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	for (size_t i = 0, n = skins.size(); i < n; i++) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			Attachment *attachment = entry._attachment;
+			if (!attachment->getRTTI().instanceOf(BoundingBoxAttachment::rtti)) continue;
+			BoundingBoxAttachment *boundingBox = static_cast<BoundingBoxAttachment *>(attachment);
+			Vector<int> &bones = boundingBox->getBones();
+			Vector<float> &vertices = boundingBox->getVertices();
+			if (bones.size() == 0) {
+				int bone = skeletonData.getSlots()[entry._slotIndex]->getBoneData().getIndex();
+				for (size_t v = 0, nn = vertices.size(); v < nn; v += 2) {
+					float radius = MathUtil::sqrt(vertices[v] * vertices[v] + vertices[v + 1] * vertices[v + 1]);
+					radii[bone] = MathUtil::max(radii[bone], radius);
+				}
+			} else {
+				for (size_t v = 0, b = 0, nn = bones.size(); v < nn;) {
+					size_t count = bones[v++];
+					count += v;
+					for (; v < count; v++, b += 3) {
+						int bone = bones[v];
+						float radius = MathUtil::sqrt(vertices[b] * vertices[b] + vertices[b + 1] * vertices[b + 1]);
+						radii[bone] = MathUtil::max(radii[bone], radius);
+					}
+				}
+			}
+		}
+	}
+	_radiiData.add(&skeletonData);
+	_radii.add(radiiP);
+	_radiiReferences.add(1);
+	return radiiP;
+}
+
+bool SkeletonBroadphase::computeBounds(Proxy &proxy, float &outMinX, float &outMinY, float &outMaxX, float &outMaxY) {
+	Skeleton &skeleton = *proxy._skeleton;
+	Vector<Bone *> &bones = skeleton.getBones();
+	Vector<float> &radii = *proxy._radii;
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, maxScale = 0;
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		float radius = radii[i];
+		if (radius < 0) continue;
+		Bone &bone = *bones[i];
+		if (!bone._active) continue;
+		// The Frobenius norm bounds how far the bone's transform can move a vertex at this radius.
+		float scale = MathUtil::sqrt(bone._a * bone._a + bone._b * bone._b + bone._c * bone._c + bone._d * bone._d);
+		float extent = radius * scale;
+		minX = MathUtil::min(minX, bone._worldX - extent);
+		minY = MathUtil::min(minY, bone._worldY - extent);
+		maxX = MathUtil::max(maxX, bone._worldX + extent);
+		maxY = MathUtil::max(maxY, bone._worldY + extent);
+		maxScale = MathUtil::max(maxScale, scale);
+	}
+	if (minX > maxX) return false;
+
+	// Deform moves the bounding box vertices away from their setup positions.
+	float deform = 0;
+	Vector<Slot *> &slots = skeleton.getSlots();
+	for (size_t i = 0, n = slots.size(); i < n; i++) {
+		Vector<float> &values = slots[i]->getDeform();
+		if (values.size() == 0) continue;
+		Attachment *attachment = slots[i]->getAttachment();
+		if (attachment == NULL || !attachment->getRTTI().instanceOf(BoundingBoxAttachment::rtti)) continue;
+		for (size_t v = 0, nn = values.size(); v < nn; v += 2)
+			deform = MathUtil::max(deform, values[v] * values[v] + values[v + 1] * values[v + 1]);
+	}
+	if (deform > 0) {
+		float extent = MathUtil::sqrt(deform) * maxScale;
+		minX -= extent;
+		minY -= extent;
+		maxX += extent;
+		maxY += extent;
+	}
+
+	// To the coordinates of the index.
+	float centerX = (minX + maxX) * 0.5f, centerY = (minY + maxY) * 0.5f;
+	float extentX = (maxX - minX) * 0.5f, extentY = (maxY - minY) * 0.5f;
+	float x = proxy._a * centerX + proxy._b * centerY + proxy._worldX;
+	float y = proxy._c * centerX + proxy._d * centerY + proxy._worldY;
+	float ex = MathUtil::abs(proxy._a) * extentX + MathUtil::abs(proxy._b) * extentY;
+	float ey = MathUtil::abs(proxy._c) * extentX + MathUtil::abs(proxy._d) * extentY;
+	outMinX = x - ex;
+	outMinY = y - ey;
+	outMaxX = x + ex;
+	outMaxY = y + ey;
+	return true;
+}
+
+SkeletonBounds &SkeletonBroadphase::getBounds(Proxy &proxy) {
+	if (proxy._bounds == NULL) proxy._bounds = new (__FILE__, __LINE__) SkeletonBounds();
+	if (proxy._boundsDirty) {
+		proxy._bounds->update(*proxy._skeleton, true);
+		proxy._boundsDirty = false;
+	}
+	return *proxy._bounds;
+}
+
+int SkeletonBroadphase::allocateNode() {
+	int index;
+	if (_freeNode == -1) {
+		Node node;
+		_nodes.add(node);
+		index = (int) _nodes.size() - 1;
+	} else {
+		index = _freeNode;
+		_freeNode = _nodes[index].parent;
+	}
+	Node &node = _nodes[index];
+	node.parent = -1;
+	node.child1 = -1;
+	node.child2 = -1;
+	node.height = 0;
+	node.proxy = -1;
+	return index;
+}
+
+void SkeletonBroadphase::freeNode(int index) {
+	Node &node = _nodes[index];
+	node.parent = _freeNode;
+	node.height = -1;
+	_freeNode = index;
+}
+
+void SkeletonBroadphase::insertLeaf(int leaf) {
+	if (_root == -1) {
+		_root = leaf;
+		_nodes[leaf].parent = -1;
+		return;
+	}
+
+	// Find the best sibling, the one that increases the perimeters of the tree the least.
+	int index = _root;
+	while (_nodes[index].child1 != -1) {
+		Node &node = _nodes[index], &leafNode = _nodes[leaf];
+		int child1 = node.child1, child2 = node.child2;
+		float combined = combinedPerimeter(node, leafNode);
+		float cost = 2 * combined;
+		float inheritanceCost = 2 * (combined - perimeter(node));
+
+		Node &node1 = _nodes[child1];
+		float cost1 = combinedPerimeter(leafNode, node1) + inheritanceCost;
+		if (node1.child1 != -1) cost1 -= perimeter(node1);
+
+		Node &node2 = _nodes[child2];
+		float cost2 = combinedPerimeter(leafNode, node2) + inheritanceCost;
+		if (node2.child1 != -1) cost2 -= perimeter(node2);
+
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int sibling = index;
+	int oldParent = _nodes[sibling].parent;
+	int newParent = allocateNode();
+	Node &parent = _nodes[newParent];
+	parent.parent = oldParent;
+	combine(parent, _nodes[leaf], _nodes[sibling]);
+	parent.height = _nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+	if (oldParent != -1) {
+		if (_nodes[oldParent].child1 == sibling)
+			_nodes[oldParent].child1 = newParent;
+		else
+			_nodes[oldParent].child2 = newParent;
+	} else
+		_root = newParent;
+	_nodes[sibling].parent = newParent;
+	_nodes[leaf].parent = newParent;
+
+	for (index = newParent; index != -1;) {
+		index = balance(index);
+		Node &node = _nodes[index];
+		node.height = 1 + MathUtil::max(_nodes[node.child1].height, _nodes[node.child2].height);
+		combine(node, _nodes[node.child1], _nodes[node.child2]);
+		index = node.parent;
+	}
+}
+
+void SkeletonBroadphase::removeLeaf(int leaf) {
+	if (leaf == _root) {
+		_root = -1;
+		return;
+	}
+
+	int parent = _nodes[leaf].parent;
+	int grandParent = _nodes[parent].parent;
+	int sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+	freeNode(parent);
+	if (grandParent == -1) {
+		_root = sibling;
+		_nodes[sibling].parent = -1;
+		return;
+	}
+
+	if (_nodes[grandParent].child1 == parent)
+		_nodes[grandParent].child1 = sibling;
+	else
+		_nodes[grandParent].child2 = sibling;
+	_nodes[sibling].parent = grandParent;
+
+	for (int index = grandParent; index != -1;) {
+		index = balance(index);
+		Node &node = _nodes[index];
+		node.height = 1 + MathUtil::max(_nodes[node.child1].height, _nodes[node.child2].height);
+		combine(node, _nodes[node.child1], _nodes[node.child2]);
+		index = node.parent;
+	}
+}
+
+int SkeletonBroadphase::balance(int iA) {
+	Node &a = _nodes[iA];
+	if (a.child1 == -1 || a.height < 2) return iA;
+
+	int iB = a.child1, iC = a.child2;
+	Node &b = _nodes[iB], &c = _nodes[iC];
+	int difference = c.height - b.height;
+
+	// Rotate C up.
+	if (difference > 1) {
+		int iF = c.child1, iG = c.child2;
+		Node &f = _nodes[iF], &g = _nodes[iG];
+		c.child1 = iA;
+		c.parent = a.parent;
+		a.parent = iC;
+		if (c.parent == -1)
+			_root = iC;
+		else if (_nodes[c.parent].child1 == iA)
+			_nodes[c.parent].child1 = iC;
+		else
+			_nodes[c.parent].child2 = iC;
+
+		if (f.height > g.height) {
+			c.child2 = iF;
+			a.child2 = iG;
+			g.parent = iA;
+			combine(a, b, g);
+			combine(c, a, f);
+			a.height = 1 + MathUtil::max(b.height, g.height);
+			c.height = 1 + MathUtil::max(a.height, f.height);
+		} else {
+			c.child2 = iG;
+			a.child2 = iF;
+			f.parent = iA;
+			combine(a, b, f);
+			combine(c, a, g);
+			a.height = 1 + MathUtil::max(b.height, f.height);
+			c.height = 1 + MathUtil::max(a.height, g.height);
+		}
+		return iC;
+	}
+
+	// Rotate B up.
+	if (difference < -1) {
+		int iD = b.child1, iE = b.child2;
+		Node &d = _nodes[iD], &e = _nodes[iE];
+		b.child1 = iA;
+		b.parent = a.parent;
+		a.parent = iB;
+		if (b.parent == -1)
+			_root = iB;
+		else if (_nodes[b.parent].child1 == iA)
+			_nodes[b.parent].child1 = iB;
+		else
+			_nodes[b.parent].child2 = iB;
+
+		if (d.height > e.height) {
+			b.child2 = iD;
+			a.child1 = iE;
+			e.parent = iA;
+			combine(a, c, e);
+			combine(b, a, d);
+			a.height = 1 + MathUtil::max(c.height, e.height);
+			b.height = 1 + MathUtil::max(a.height, d.height);
+		} else {
+			b.child2 = iE;
+			a.child1 = iD;
+			d.parent = iA;
+			combine(a, c, d);
+			combine(b, a, e);
+			a.height = 1 + MathUtil::max(c.height, d.height);
+			b.height = 1 + MathUtil::max(a.height, e.height);
+		}
+		return iB;
+	}
+	return iA;
+}
@@ -30,6 +30,7 @@
 #include <spine/SkeletonData.h>
 
 #include <spine/Animation.h>
+#include <spine/AttachmentTimeline.h>
 #include <spine/BoneData.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
@@ -42,6 +43,16 @@
 
 using namespace spine;
 
+namespace {
+	unsigned int hashAttachmentName(const String &name) {
+		unsigned int hash = 2166136261u;
+		const char *chars = name.buffer();
+		for (size_t i = 0, n = name.length(); i < n; ++i)
+			hash = (hash ^ (unsigned char) chars[i]) * 16777619u;
+		return hash;
+	}
+}
+
 SkeletonData::SkeletonData() : _name(),
 							   _defaultSkin(NULL),
 							   _x(0),
@@ -50,6 +61,7 @@ SkeletonData::SkeletonData() : _name(),
 							   _height(0),
 							   _version(),
 							   _hash(),
+							   _setupAttachmentsVersion(0),
 							   _fps(0),
 							   _imagesPath() {
 }
@@ -223,3 +235,63 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+void SkeletonData::internAttachmentNames() {
+	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+		SlotData &slot = *_slots[i];
+		slot._attachmentNameId = slot._attachmentName.isEmpty() ? -1 : internAttachmentName(slot._attachmentName);
+	}
+
+	for (size_t i = 0, n = _animations.size(); i < n; ++i) {
+		Vector<Timeline *> &timelines = _animations[i]->getTimelines();
+		for (size_t ii = 0, nn = timelines.size(); ii < nn; ++ii) {
+			if (!timelines[ii]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+			AttachmentTimeline &timeline = *static_cast<AttachmentTimeline *>(timelines[ii]);
+			Vector<String> &names = timeline._attachmentNames;
+			timeline._attachmentNameIds.setSize(names.size(), -1);
+			for (size_t frame = 0, frameCount = names.size(); frame < frameCount; ++frame)
+				timeline._attachmentNameIds[frame] = names[frame].isEmpty() ? -1 : internAttachmentName(names[frame]);
+			timeline._attachmentNameData = this;
+		}
+	}
+
+	for (size_t i = 0, n = _skins.size(); i < n; ++i) {
+		Skin::AttachmentMap::Entries entries = _skins[i]->getAttachments();
+		while (entries.hasNext()) internAttachmentName(entries.next()._name);
+	}
+
+	// Built now rather than when first used, so skeletons on several threads can share the loaded data.
+	for (size_t i = 0, n = _skins.size(); i < n; ++i)
+		_skins[i]->updateAttachmentIds(*this);
+}
+
+int SkeletonData::findAttachmentNameId(const String &attachmentName) {
+	if (_attachmentNameTable.size() == 0) return -1;
+	return _attachmentNameTable[findAttachmentNameIndex(attachmentName)];
+}
+
+int SkeletonData::internAttachmentName(const String &attachmentName) {
+	// The table is kept at most half full.
+	if ((_attachmentNames.size() + 1) * 2 > _attachmentNameTable.size()) {
+		size_t size = _attachmentNameTable.size() == 0 ? 64 : _attachmentNameTable.size() * 2;
+		_attachmentNameTable.clear();
+		_attachmentNameTable.setSize(size, -1);
+		for (size_t id = 0, n = _attachmentNames.size(); id < n; ++id)
+			_attachmentNameTable[findAttachmentNameIndex(_attachmentNames[id])] = (int) id;
+	}
+
+	int index = findAttachmentNameIndex(attachmentName);
+	if (_attachmentNameTable[index] == -1) {
+		_attachmentNameTable[index] = (int) _attachmentNames.size();
+		_attachmentNames.add(attachmentName);
+	}
+	return _attachmentNameTable[index];
+}
+
+int SkeletonData::findAttachmentNameIndex(const String &attachmentName) {
+	size_t mask = _attachmentNameTable.size() - 1;
+	for (size_t i = hashAttachmentName(attachmentName) & mask;; i = (i + 1) & mask) {
+		int id = _attachmentNameTable[i];
+		if (id == -1 || _attachmentNames[id] == attachmentName) return (int) i;
+	}
+}
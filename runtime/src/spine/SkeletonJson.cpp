@@ -235,6 +235,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			}
 
 			data = new (__FILE__, __LINE__) SlotData(i, Json::getString(slotMap, "name", 0), *boneData);
+			data->_skeletonData = skeletonData;
 
 			color = Json::getString(slotMap, "color", 0);
 			if (color) {
@@ -573,7 +574,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								color = Json::getString(attachmentMap, "color", 0);
 								if (color) toColor(region->getColor(), color, true);
 
-								if (region->_region != NULL) region->updateRegion();
+								if (region->_region != NULL || region->_sequence != NULL) region->updateRegion();
 								_attachmentLoader->configureAttachment(region);
 								break;
 							}
@@ -616,7 +617,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 									readVertices(attachmentMap, mesh, verticesLength);
 
-									if (mesh->_region != NULL) mesh->updateRegion();
+									if (mesh->_region != NULL || mesh->_sequence != NULL) mesh->updateRegion();
 
 									mesh->_hullLength = Json::getInt(attachmentMap, "hull", 0);
 
@@ -731,7 +732,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
 		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
-		if (linkedMesh->_mesh->_region != NULL) linkedMesh->_mesh->updateRegion();
+		if (linkedMesh->_mesh->_region != NULL || linkedMesh->_mesh->_sequence != NULL) linkedMesh->_mesh->updateRegion();
 		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
@@ -780,6 +781,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 	delete root;
 
+	skeletonData->internAttachmentNames();
 	return skeletonData;
 }
 
@@ -1468,6 +1470,7 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
+	attachment->updateSkinning();
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
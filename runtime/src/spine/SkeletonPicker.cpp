@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonPicker.h>
+
+#include <spine/MathUtil.h>
+
+#include <float.h>
+
+using namespace spine;
+
+namespace {
+	const int MAX_LEAF_TRIANGLES = 4;
+}
+
+SkeletonPicker::SkeletonPicker() : _dirty(false) {
+}
+
+void SkeletonPicker::clear() {
+	_positions.clear();
+	_triangles.clear();
+	_triangleSlots.clear();
+	_slots.clear();
+	_nodes.clear();
+	_dirty = false;
+}
+
+void SkeletonPicker::addTriangles(Slot *slot, const float *vertices, size_t vertexCount, size_t stride,
+								  const unsigned short *indices, size_t indexCount, int indexOffset) {
+	if (indexCount < 3) return;
+	int first = (int) (_positions.size() >> 1) - indexOffset;
+	size_t p = _positions.size();
+	_positions.setSizeUninitialized(p + vertexCount * 2);
+	float *positions = _positions.buffer() + p;
+	for (size_t i = 0; i < vertexCount; i++, vertices += stride) {
+		positions[i * 2] = vertices[0];
+		positions[i * 2 + 1] = vertices[1];
+	}
+
+	size_t t = _triangles.size();
+	_triangles.setSizeUninitialized(t + indexCount);
+	int *triangles = _triangles.buffer() + t;
+	for (size_t i = 0; i < indexCount; i++)
+		triangles[i] = first + indices[i];
+
+	int slotIndex = (int) _slots.size();
+	_slots.add(slot);
+	for (size_t i = 0, n = indexCount / 3; i < n; i++)
+		_triangleSlots.add(slotIndex);
+	_dirty = true;
+}
+
+Slot *SkeletonPicker::pick(float x, float y) {
+	if (_dirty) build();
+	if (_nodes.size() == 0) return NULL;
+
+	const float *positions = _positions.buffer();
+	const int *triangles = _triangles.buffer();
+	int best = -1;
+	_stack.clear();
+	_stack.add(0);
+	while (_stack.size() > 0) {
+		int index = _stack[_stack.size() - 1];
+		_stack.removeAt(_stack.size() - 1);
+		Node &node = _nodes[index];
+		// Triangles drawn before the best found so far are below it.
+		if (node.maxTriangle <= best) continue;
+		if (x < node.minX || x > node.maxX || y < node.minY || y > node.maxY) continue;
+		if (node.count == 0) {
+			// Visit the child with the last drawn triangles first, it is more likely to prune the other.
+			int child1 = index + 1, child2 = node.child2;
+			if (_nodes[child1].maxTriangle > _nodes[child2].maxTriangle) {
+				_stack.add(child2);
+				_stack.add(child1);
+			} else {
+				_stack.add(child1);
+				_stack.add(child2);
+			}
+			continue;
+		}
+		for (int i = node.start, n = node.start + node.count; i < n; i++) {
+			int triangle = _order[i];
+			if (triangle <= best) continue;
+			const int *v = triangles + triangle * 3;
+			float x1 = positions[v[0] << 1], y1 = positions[(v[0] << 1) + 1];
+			float x2 = positions[v[1] << 1], y2 = positions[(v[1] << 1) + 1];
+			float x3 = positions[v[2] << 1], y3 = positions[(v[2] << 1) + 1];
+			float d1 = (x2 - x1) * (y - y1) - (y2 - y1) * (x - x1);
+			float d2 = (x3 - x2) * (y - y2) - (y3 - y2) * (x - x2);
+			float d3 = (x1 - x3) * (y - y3) - (y1 - y3) * (x - x3);
+			// Inside or on an edge of a triangle with either winding.
+			if ((d1 >= 0 && d2 >= 0 && d3 >= 0) || (d1 <= 0 && d2 <= 0 && d3 <= 0)) best = triangle;
+		}
+	}
+	return best == -1 ? NULL : _slots[_triangleSlots[best]];
+}
+
+void SkeletonPicker::build() {
+	_dirty = false;
+	_nodes.clear();
+	int triangleCount = (int) _triangleSlots.size();
+	if (triangleCount == 0) return;
+
+	const float *positions = _positions.buffer();
+	const int *triangles = _triangles.buffer();
+	_order.setSizeUninitialized(triangleCount);
+	_centers.setSizeUninitialized(triangleCount * 2);
+	for (int i = 0; i < triangleCount; i++) {
+		const int *v = triangles + i * 3;
+		_order[i] = i;
+		_centers[i * 2] = (positions[v[0] << 1] + positions[v[1] << 1] + positions[v[2] << 1]) / 3;
+		_centers[i * 2 + 1] = (positions[(v[0] << 1) + 1] + positions[(v[1] << 1) + 1] + positions[(v[2] << 1) + 1]) / 3;
+	}
+	_nodes.ensureCapacity(triangleCount / MAX_LEAF_TRIANGLES * 2 + 1);
+	buildNode(0, triangleCount);
+}
+
+int SkeletonPicker::buildNode(int start, int end) {
+	const float *positions = _positions.buffer();
+	const int *triangles = _triangles.buffer();
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float centerMinX = FLT_MAX, centerMinY = FLT_MAX, centerMaxX = -FLT_MAX, centerMaxY = -FLT_MAX;
+	int maxTriangle = -1;
+	for (int i = start; i < end; i++) {
+		int triangle = _order[i];
+		const int *v = triangles + triangle * 3;
+		for (int ii = 0; ii < 3; ii++) {
+			float x = positions[v[ii] << 1], y = positions[(v[ii] << 1) + 1];
+			minX = MathUtil::min(minX, x);
+			minY = MathUtil::min(minY, y);
+			maxX = MathUtil::max(maxX, x);
+			maxY = MathUtil::max(maxY, y);
+		}
+		float centerX = _centers[triangle * 2], centerY = _centers[triangle * 2 + 1];
+		centerMinX = MathUtil::min(centerMinX, centerX);
+		centerMinY = MathUtil::min(centerMinY, centerY);
+		centerMaxX = MathUtil::max(centerMaxX, centerX);
+		centerMaxY = MathUtil::max(centerMaxY, centerY);
+		maxTriangle = MathUtil::max(maxTriangle, triangle);
+	}
+
+	int index = (int) _nodes.size();
+	Node node;
+	node.minX = minX;
+	node.minY = minY;
+	node.maxX = maxX;
+	node.maxY = maxY;
+	node.start = start;
+	node.count = end - start;
+	node.child2 = -1;
+	node.maxTriangle = maxTriangle;
+	_nodes.add(node);
+	if (end - start <= MAX_LEAF_TRIANGLES) return index;
+
+	// Split at the middle of the longer side of the triangle centers, or in half by count if that separates nothing.
+	int axis = centerMaxX - centerMinX >= centerMaxY - centerMinY ? 0 : 1;
+	float split = axis == 0 ? (centerMinX + centerMaxX) * 0.5f : (centerMinY + centerMaxY) * 0.5f;
+	int middle = start;
+	for (int i = start; i < end; i++) {
+		int triangle = _order[i];
+		if (_centers[triangle * 2 + axis] < split) {
+			_order[i] = _order[middle];
+			_order[middle++] = triangle;
+		}
+	}
+	if (middle == start || middle == end) middle = (start + end) >> 1;
+
+	buildNode(start, middle);
+	int child2 = buildNode(middle, end);
+	_nodes[index].count = 0;
+	_nodes[index].child2 = child2;
+	return index;
+}
@@ -32,11 +32,13 @@
 #include <spine/Attachment.h>
 #include <spine/MeshAttachment.h>
 #include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
 
 #include <spine/ConstraintData.h>
 #include <spine/Slot.h>
 
 #include <assert.h>
+#include <atomic>
 
 using namespace spine;
 
@@ -88,7 +90,9 @@ Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
 	return Skin::AttachmentMap::Entries(_buckets);
 }
 
-Skin::Skin(const String &name) : _name(name), _attachments() {
+Skin::Skin(const String &name) : _name(name), _attachments(), _version(nextVersion()), _cacheData(NULL), _cacheVersion(0),
+								 _cacheDefaultVersion(0), _cacheSetupVersion(0), _idTableData(NULL),
+								 _idTableNameCount(0) {
 	assert(_name.length() > 0);
 }
 
@@ -103,14 +107,50 @@ Skin::~Skin() {
 void Skin::setAttachment(size_t slotIndex, const String &name, Attachment *attachment) {
 	assert(attachment);
 	_attachments.put(slotIndex, name, attachment);
+	attachmentsChanged();
 }
 
 Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 	return _attachments.get(slotIndex, name);
 }
 
+Attachment *Skin::getAttachment(SkeletonData &skeletonData, size_t slotIndex, int attachmentNameId) {
+	// The table is only built when the attachments or the skeleton data's names change, never here, so skeletons on several
+	// threads can read it. Without a table for the skeleton data's current names, the name is looked up instead.
+	if (_idTableData != &skeletonData || _idTableNameCount != skeletonData._attachmentNames.size())
+		return _attachments.get(slotIndex, skeletonData._attachmentNames[attachmentNameId]);
+	if (slotIndex + 1 >= _idTableStarts.size()) return NULL;
+	// A slot has few attachments, so a linear search of its ids is faster than hashing.
+	const int *ids = _idTableIds.buffer();
+	for (size_t i = _idTableStarts[slotIndex], n = _idTableStarts[slotIndex + 1]; i < n; ++i)
+		if (ids[i] == attachmentNameId) return _idTableAttachments[i];
+	return NULL;
+}
+
+void Skin::updateAttachmentIds(SkeletonData &skeletonData) {
+	_idTableData = &skeletonData;
+	_idTableNameCount = skeletonData._attachmentNames.size();
+	_idTableStarts.clear();
+	_idTableIds.clear();
+	_idTableAttachments.clear();
+	Vector<Vector<AttachmentMap::Entry> > &buckets = _attachments._buckets;
+	for (size_t slotIndex = 0, n = buckets.size(); slotIndex < n; ++slotIndex) {
+		_idTableStarts.add(_idTableIds.size());
+		Vector<AttachmentMap::Entry> &bucket = buckets[slotIndex];
+		for (size_t i = 0, nn = bucket.size(); i < nn; ++i) {
+			// Names without an id can't be looked up by id.
+			int id = skeletonData.findAttachmentNameId(bucket[i]._name);
+			if (id == -1) continue;
+			_idTableIds.add(id);
+			_idTableAttachments.add(bucket[i]._attachment);
+		}
+	}
+	_idTableStarts.add(_idTableIds.size());
+}
+
 void Skin::removeAttachment(size_t slotIndex, const String &name) {
 	_attachments.remove(slotIndex, name);
+	attachmentsChanged();
 }
 
 void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
@@ -164,8 +204,9 @@ void Skin::addSkin(Skin *other) {
 	AttachmentMap::Entries entries = other->getAttachments();
 	while (entries.hasNext()) {
 		AttachmentMap::Entry &entry = entries.next();
-		setAttachment(entry._slotIndex, entry._name, entry._attachment);
+		_attachments.put(entry._slotIndex, entry._name, entry._attachment);
 	}
+	attachmentsChanged();
 }
 
 void Skin::copySkin(Skin *other) {
@@ -179,11 +220,12 @@ void Skin::copySkin(Skin *other) {
 	while (entries.hasNext()) {
 		AttachmentMap::Entry &entry = entries.next();
 		if (entry._attachment->getRTTI().isExactly(MeshAttachment::rtti))
-			setAttachment(entry._slotIndex, entry._name,
-						  static_cast<MeshAttachment *>(entry._attachment)->newLinkedMesh());
+			_attachments.put(entry._slotIndex, entry._name,
+							 static_cast<MeshAttachment *>(entry._attachment)->newLinkedMesh());
 		else
-			setAttachment(entry._slotIndex, entry._name, entry._attachment->copy());
+			_attachments.put(entry._slotIndex, entry._name, entry._attachment->copy());
 	}
+	attachmentsChanged();
 }
 
 Vector<ConstraintData *> &Skin::getConstraints() {
@@ -193,3 +235,18 @@ Vector<ConstraintData *> &Skin::getConstraints() {
 Vector<BoneData *> &Skin::getBones() {
 	return _bones;
 }
+
+void Skin::markChanged() {
+	_version = nextVersion();
+}
+
+void Skin::attachmentsChanged() {
+	markChanged();
+	if (_idTableData) updateAttachmentIds(*_idTableData);
+}
+
+unsigned int Skin::nextVersion() {
+	// Skins are created by loaders on other threads while the main thread changes skins, each must get its own version.
+	static std::atomic<unsigned int> nextVersion(0);
+	return ++nextVersion;
+}
@@ -0,0 +1,472 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SkinRepacker.h>
+
+#include <spine/Atlas.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Sequence.h>
+#include <spine/Skin.h>
+#include <spine/TextureLoader.h>
+
+#include <string.h>
+
+using namespace spine;
+
+namespace {
+	struct PackRect {
+		int region;
+		int width, height; // Including the padding.
+		int x, y;
+	};
+
+	/// Adds the regions an attachment draws from. Returns false if it is not a region or mesh attachment.
+	bool getRegions(Attachment *attachment, Vector<TextureRegion *> &regions) {
+		Sequence *sequence;
+		TextureRegion *region;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			sequence = static_cast<RegionAttachment *>(attachment)->getSequence();
+			region = static_cast<RegionAttachment *>(attachment)->getRegion();
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			sequence = static_cast<MeshAttachment *>(attachment)->getSequence();
+			region = static_cast<MeshAttachment *>(attachment)->getRegion();
+		} else
+			return false;
+		if (sequence)
+			regions.addAll(sequence->getRegions());
+		else if (region)
+			regions.add(region);
+		return true;
+	}
+
+	/// The size of the region in the page, which is rotated when the region is.
+	void getPackedSize(AtlasRegion &region, int &width, int &height) {
+		width = region.degrees == 90 ? region.height : region.width;
+		height = region.degrees == 90 ? region.width : region.height;
+	}
+
+	bool sameSettings(AtlasPage &a, AtlasPage &b) {
+		return a.minFilter == b.minFilter && a.magFilter == b.magFilter && a.uWrap == b.uWrap && a.vWrap == b.vWrap &&
+			   a.pma == b.pma;
+	}
+
+	int nextPowerOfTwo(int value) {
+		int power = 1;
+		while (power < value) power <<= 1;
+		return power;
+	}
+
+	/// Places the rects in rows, in order, until one doesn't fit. Returns the number placed and the size used.
+	int packShelves(Vector<PackRect> &rects, int width, int height, int &usedWidth, int &usedHeight) {
+		int x = 0, y = 0, shelfHeight = 0;
+		usedWidth = 0;
+		for (size_t i = 0, n = rects.size(); i < n; ++i) {
+			PackRect &rect = rects[i];
+			if (x + rect.width > width) {
+				y += shelfHeight;
+				x = 0;
+				shelfHeight = 0;
+			}
+			if (rect.width > width || y + rect.height > height) {
+				usedHeight = y + shelfHeight;
+				return (int) i;
+			}
+			rect.x = x;
+			rect.y = y;
+			x += rect.width;
+			if (x > usedWidth) usedWidth = x;
+			if (rect.height > shelfHeight) shelfHeight = rect.height;
+		}
+		usedHeight = y + shelfHeight;
+		return (int) rects.size();
+	}
+
+	/// Copies a rect of the source, extending its edge pixels into the padding around it.
+	void blit(const unsigned char *source, int sourceWidth, int sourceX, int sourceY, int width, int height,
+			  unsigned char *target, int targetWidth, int targetX, int targetY, int padding) {
+		for (int row = -padding; row < height + padding; ++row) {
+			int sourceRow = row < 0 ? 0 : (row >= height ? height - 1 : row);
+			const unsigned char *sourcePixels = source + ((size_t) (sourceY + sourceRow) * sourceWidth + sourceX) * 4;
+			unsigned char *targetPixels = target + ((size_t) (targetY + row) * targetWidth + targetX - padding) * 4;
+			if (padding > 0) {
+				for (int column = -padding; column < 0; ++column, targetPixels += 4)
+					memcpy(targetPixels, sourcePixels, 4);
+			}
+			memcpy(targetPixels, sourcePixels, (size_t) width * 4);
+			targetPixels += (size_t) width * 4;
+			for (int column = 0; column < padding; ++column, targetPixels += 4)
+				memcpy(targetPixels, sourcePixels + (size_t) (width - 1) * 4, 4);
+		}
+	}
+}
+
+SkinRepacker::SkinRepacker(TextureLoader *textureLoader) : _textureLoader(textureLoader), _maxPageSize(2048), _padding(2),
+														   _regionsPacked(0), _regionsSkipped(0), _sourcePages(0),
+														   _pagesCreated(0) {
+}
+
+SkinRepacker::~SkinRepacker() {
+	for (size_t i = 0, n = _skins.size(); i < n; ++i)
+		dispose(_skins[i]);
+}
+
+Skin *SkinRepacker::repack(Skin &skin) {
+	Repacked *repacked = new (__FILE__, __LINE__) Repacked();
+	repacked->skin = NULL;
+	repacked->references = 1;
+
+	// The attachments of each slot are sorted by name, so the order skins were combined in doesn't matter.
+	Skin::AttachmentMap::Entries entries = skin.getAttachments();
+	while (entries.hasNext()) {
+		Skin::AttachmentMap::Entry &entry = entries.next();
+		size_t i = repacked->slots.size();
+		repacked->slots.add(entry._slotIndex);
+		repacked->names.add(entry._name);
+		repacked->attachments.add(entry._attachment);
+		for (; i > 0 && repacked->slots[i - 1] == entry._slotIndex &&
+			   strcmp(repacked->names[i - 1].buffer(), entry._name.buffer()) > 0;
+			 --i) {
+			repacked->names[i] = repacked->names[i - 1];
+			repacked->attachments[i] = repacked->attachments[i - 1];
+		}
+		repacked->names[i] = entry._name;
+		repacked->attachments[i] = entry._attachment;
+	}
+	repacked->bones.addAll(skin.getBones());
+	repacked->constraints.addAll(skin.getConstraints());
+
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0, n = repacked->attachments.size(); i < n; ++i)
+		hash = (hash ^ (unsigned int) (size_t) repacked->attachments[i] ^ (unsigned int) repacked->slots[i]) * 16777619u;
+	for (size_t i = 0, n = repacked->bones.size(); i < n; ++i)
+		hash = (hash ^ (unsigned int) (size_t) repacked->bones[i]) * 16777619u;
+	for (size_t i = 0, n = repacked->constraints.size(); i < n; ++i)
+		hash = (hash ^ (unsigned int) (size_t) repacked->constraints[i]) * 16777619u;
+	repacked->hash = hash;
+
+	for (size_t i = 0, n = _skins.size(); i < n; ++i) {
+		Repacked &cached = *_skins[i];
+		if (cached.hash != hash || cached.attachments.size() != repacked->attachments.size() ||
+			cached.bones.size() != repacked->bones.size() || cached.constraints.size() != repacked->constraints.size())
+			continue;
+		bool same = true;
+		for (size_t ii = 0, nn = cached.attachments.size(); ii < nn && same; ++ii)
+			same = cached.attachments[ii] == repacked->attachments[ii] && cached.slots[ii] == repacked->slots[ii] &&
+				   cached.names[ii] == repacked->names[ii];
+		for (size_t ii = 0, nn = cached.bones.size(); ii < nn && same; ++ii)
+			same = cached.bones[ii] == repacked->bones[ii];
+		for (size_t ii = 0, nn = cached.constraints.size(); ii < nn && same; ++ii)
+			same = cached.constraints[ii] == repacked->constraints[ii];
+		if (same) {
+			delete repacked;
+			cached.references++;
+			return cached.skin;
+		}
+	}
+
+	// Referenced so an attachment can't be freed and another allocated at its address while this is cached.
+	for (size_t i = 0, n = repacked->attachments.size(); i < n; ++i)
+		repacked->attachments[i]->reference();
+	build(*repacked, skin);
+	_skins.add(repacked);
+	return repacked->skin;
+}
+
+void SkinRepacker::release(Skin *repackedSkin) {
+	for (size_t i = 0, n = _skins.size(); i < n; ++i) {
+		if (_skins[i]->skin != repackedSkin) continue;
+		if (--_skins[i]->references == 0) {
+			dispose(_skins[i]);
+			_skins.removeAt(i);
+		}
+		return;
+	}
+}
+
+void SkinRepacker::build(Repacked &repacked, Skin &skin) {
+	_regionsPacked = 0;
+	_regionsSkipped = 0;
+	_sourcePages = 0;
+	_pagesCreated = 0;
+
+	_sourceRegions.clear();
+	Vector<TextureRegion *> regions;
+	for (size_t i = 0, n = repacked.attachments.size(); i < n; ++i) {
+		regions.clear();
+		if (!getRegions(repacked.attachments[i], regions)) continue;
+		for (size_t ii = 0, nn = regions.size(); ii < nn; ++ii) {
+			// Attachments are given atlas regions by AtlasAttachmentLoader.
+			AtlasRegion *region = static_cast<AtlasRegion *>(regions[ii]);
+			if (!_sourceRegions.contains(region)) _sourceRegions.add(region);
+		}
+	}
+	_packedRegions.clear();
+	_packedRegions.setSize(_sourceRegions.size(), NULL);
+
+	// Read the pixels of the pages and find the regions that can be packed.
+	Vector<AtlasPage *> sourcePages;
+	Vector<Vector<unsigned char> *> sourcePixels;
+	Vector<int> packable;
+	for (size_t i = 0, n = _sourceRegions.size(); i < n; ++i) {
+		AtlasRegion &region = *_sourceRegions[i];
+		AtlasPage *page = region.page;
+		int width, height;
+		getPackedSize(region, width, height);
+		if (!page || page->uWrap != TextureWrap_ClampToEdge || page->vWrap != TextureWrap_ClampToEdge ||
+			width + _padding * 2 > _maxPageSize || height + _padding * 2 > _maxPageSize || width <= 0 || height <= 0 ||
+			region.x < 0 || region.y < 0 || region.x + width > page->width || region.y + height > page->height) {
+			_regionsSkipped++;
+			continue;
+		}
+		int pageIndex = sourcePages.indexOf(page);
+		if (pageIndex == -1) {
+			Vector<unsigned char> *pixels = new (__FILE__, __LINE__) Vector<unsigned char>();
+			if (!_textureLoader || !_textureLoader->readPixels(*page, *pixels) ||
+				pixels->size() != (size_t) page->width * page->height * 4) {
+				delete pixels;
+				pixels = NULL;
+			} else
+				_sourcePages++;
+			pageIndex = (int) sourcePages.size();
+			sourcePages.add(page);
+			sourcePixels.add(pixels);
+		}
+		if (!sourcePixels[pageIndex]) {
+			_regionsSkipped++;
+			continue;
+		}
+		packable.add((int) i);
+	}
+
+	// Regions of pages with different settings go to different pages.
+	Vector<int> group, rest;
+	while (packable.size() > 0) {
+		AtlasPage &settings = *_sourceRegions[packable[0]]->page;
+		group.clear();
+		rest.clear();
+		for (size_t i = 0, n = packable.size(); i < n; ++i)
+			(sameSettings(*_sourceRegions[packable[i]]->page, settings) ? group : rest).add(packable[i]);
+		pack(repacked, group, sourcePages, sourcePixels);
+		packable.clearAndAddAll(rest);
+	}
+	for (size_t i = 0, n = sourcePixels.size(); i < n; ++i)
+		if (sourcePixels[i]) delete sourcePixels[i];
+
+	Skin *result = new (__FILE__, __LINE__) Skin(skin.getName());
+	result->getBones().addAll(repacked.bones);
+	result->getConstraints().addAll(repacked.constraints);
+	for (size_t i = 0, n = repacked.attachments.size(); i < n; ++i) {
+		Attachment *attachment = repacked.attachments[i];
+		regions.clear();
+		bool packed = false;
+		if (getRegions(attachment, regions)) {
+			for (size_t ii = 0, nn = regions.size(); ii < nn && !packed; ++ii)
+				packed = _packedRegions[_sourceRegions.indexOf(static_cast<AtlasRegion *>(regions[ii]))] != NULL;
+		}
+		if (packed) {
+			Attachment *copy = attachment->copy();
+			if (copy->getRTTI().isExactly(MeshAttachment::rtti)) {
+				// Linked meshes are copied without their sequence.
+				MeshAttachment *mesh = static_cast<MeshAttachment *>(copy);
+				Sequence *sequence = static_cast<MeshAttachment *>(attachment)->getSequence();
+				if (sequence && !mesh->getSequence()) mesh->setSequence(sequence->copy());
+			}
+			replaceRegions(copy);
+			attachment = copy;
+		}
+		result->setAttachment(repacked.slots[i], repacked.names[i], attachment);
+	}
+	repacked.skin = result;
+}
+
+void SkinRepacker::pack(Repacked &repacked, Vector<int> &regionIndices, Vector<AtlasPage *> &sourcePages,
+						Vector<Vector<unsigned char> *> &sourcePixels) {
+	// Tallest first, so rows waste little height.
+	Vector<PackRect> rects;
+	for (size_t i = 0, n = regionIndices.size(); i < n; ++i) {
+		PackRect rect;
+		rect.region = regionIndices[i];
+		getPackedSize(*_sourceRegions[rect.region], rect.width, rect.height);
+		rect.width += _padding * 2;
+		rect.height += _padding * 2;
+		rect.x = 0;
+		rect.y = 0;
+		size_t ii = rects.size();
+		rects.add(rect);
+		for (; ii > 0 && (rects[ii - 1].height < rect.height ||
+						  (rects[ii - 1].height == rect.height && rects[ii - 1].width < rect.width));
+			 --ii)
+			rects[ii] = rects[ii - 1];
+		rects[ii] = rect;
+	}
+
+	AtlasPage &settings = *_sourceRegions[regionIndices[0]]->page;
+	Vector<unsigned char> pixels;
+	while (rects.size() > 0) {
+		// Start at the area of the rects and grow the page until they fit or it reaches the maximum size.
+		size_t area = 0;
+		for (size_t i = 0, n = rects.size(); i < n; ++i)
+			area += (size_t) rects[i].width * rects[i].height;
+		int width = 64, height = 64;
+		while ((size_t) width * height < area && (width < _maxPageSize || height < _maxPageSize)) {
+			if (width <= height && width < _maxPageSize)
+				width <<= 1;
+			else
+				height <<= 1;
+		}
+		int placed, usedWidth, usedHeight;
+		while (true) {
+			placed = packShelves(rects, width, height, usedWidth, usedHeight);
+			if (placed == (int) rects.size() || (width >= _maxPageSize && height >= _maxPageSize)) break;
+			if (width <= height && width < _maxPageSize)
+				width <<= 1;
+			else
+				height <<= 1;
+		}
+		width = nextPowerOfTwo(usedWidth);
+		height = nextPowerOfTwo(usedHeight);
+
+		pixels.clear();
+		pixels.setSize((size_t) width * height * 4, 0);
+		for (int i = 0; i < placed; ++i) {
+			PackRect &rect = rects[i];
+			AtlasRegion &region = *_sourceRegions[rect.region];
+			int pageIndex = sourcePages.indexOf(region.page);
+			blit(sourcePixels[pageIndex]->buffer(), region.page->width, region.x, region.y, rect.width - _padding * 2,
+				 rect.height - _padding * 2, pixels.buffer(), width, rect.x + _padding, rect.y + _padding, _padding);
+		}
+
+		AtlasPage *page = new (__FILE__, __LINE__) AtlasPage(settings.name);
+		page->minFilter = settings.minFilter;
+		page->magFilter = settings.magFilter;
+		page->uWrap = settings.uWrap;
+		page->vWrap = settings.vWrap;
+		page->pma = settings.pma;
+		page->width = width;
+		page->height = height;
+		page->index = (int) repacked.pages.size();
+		_textureLoader->loadPixels(*page, pixels.buffer(), settings);
+		if (!page->texture) {
+			delete page;
+			_regionsSkipped += placed;
+		} else {
+			repacked.pages.add(page);
+			_pagesCreated++;
+			_regionsPacked += placed;
+			for (int i = 0; i < placed; ++i) {
+				PackRect &rect = rects[i];
+				AtlasRegion &source = *_sourceRegions[rect.region];
+				AtlasRegion *region = new (__FILE__, __LINE__) AtlasRegion();
+				region->page = page;
+				region->rendererObject = source.rendererObject == &source ? region : page->texture;
+				region->name = source.name;
+				region->index = source.index;
+				region->degrees = source.degrees;
+				region->offsetX = source.offsetX;
+				region->offsetY = source.offsetY;
+				region->width = source.width;
+				region->height = source.height;
+				region->originalWidth = source.originalWidth;
+				region->originalHeight = source.originalHeight;
+				region->splits.clearAndAddAll(source.splits);
+				region->pads.clearAndAddAll(source.pads);
+				region->names.clearAndAddAll(source.names);
+				region->values.clearAndAddAll(source.values);
+				region->x = rect.x + _padding;
+				region->y = rect.y + _padding;
+				region->u = (float) region->x / width;
+				region->v = (float) region->y / height;
+				region->u2 = (float) (region->x + rect.width - _padding * 2) / width;
+				region->v2 = (float) (region->y + rect.height - _padding * 2) / height;
+				if (source.v > source.v2) {
+					// The atlas was flipped with Atlas::flipV().
+					float v = region->v;
+					region->v = region->v2;
+					region->v2 = v;
+				}
+				repacked.regions.add(region);
+				_packedRegions[rect.region] = region;
+			}
+		}
+
+		for (size_t i = placed, n = rects.size(); i < n; ++i)
+			rects[i - placed] = rects[i];
+		rects.setSize(rects.size() - placed, PackRect());
+		if (placed == 0) {
+			// Can't happen, regions larger than a page are skipped.
+			_regionsSkipped += rects.size();
+			break;
+		}
+	}
+}
+
+void SkinRepacker::replaceRegions(Attachment *attachment) {
+	Sequence *sequence;
+	if (attachment->getRTTI().isExactly(RegionAttachment::rtti))
+		sequence = static_cast<RegionAttachment *>(attachment)->getSequence();
+	else
+		sequence = static_cast<MeshAttachment *>(attachment)->getSequence();
+
+	if (sequence) {
+		Vector<TextureRegion *> &regions = sequence->getRegions();
+		for (size_t i = 0, n = regions.size(); i < n; ++i) {
+			AtlasRegion *packed = _packedRegions[_sourceRegions.indexOf(static_cast<AtlasRegion *>(regions[i]))];
+			if (packed) regions[i] = packed;
+		}
+	}
+
+	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+		if (!sequence) region->setRegion(_packedRegions[_sourceRegions.indexOf(static_cast<AtlasRegion *>(region->getRegion()))]);
+		region->updateRegion();
+	} else {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+		if (!sequence) mesh->setRegion(_packedRegions[_sourceRegions.indexOf(static_cast<AtlasRegion *>(mesh->getRegion()))]);
+		mesh->updateRegion();
+	}
+}
+
+void SkinRepacker::dispose(Repacked *repacked) {
+	// The skin frees the copied attachments, which use the regions.
+	delete repacked->skin;
+	for (size_t i = 0, n = repacked->attachments.size(); i < n; ++i) {
+		Attachment *attachment = repacked->attachments[i];
+		attachment->dereference();
+		if (attachment->getRefCount() == 0) delete attachment;
+	}
+	for (size_t i = 0, n = repacked->pages.size(); i < n; ++i) {
+		if (_textureLoader) _textureLoader->unload(repacked->pages[i]->texture);
+		delete repacked->pages[i];
+	}
+	for (size_t i = 0, n = repacked->regions.size(); i < n; ++i)
+		delete repacked->regions[i];
+	delete repacked;
+}
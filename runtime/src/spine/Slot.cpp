@@ -45,7 +45,8 @@ Slot::Slot(SlotData &data, Bone &bone) : _data(data),
 										 _hasDarkColor(data.hasDarkColor()),
 										 _attachment(NULL),
 										 _attachmentState(0),
-										 _sequenceIndex(0) {
+										 _sequenceIndex(0),
+										 _deformVersion(0) {
 	setToSetupPose();
 }
 
@@ -56,7 +57,7 @@ void Slot::setToSetupPose() {
 	const String &attachmentName = _data.getAttachmentName();
 	if (attachmentName.length() > 0) {
 		_attachment = NULL;
-		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName));
+		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName, _data.getAttachmentNameId()));
 	} else {
 		setAttachment(NULL);
 	}
@@ -102,10 +103,12 @@ void Slot::setAttachment(Attachment *inValue) {
 		static_cast<VertexAttachment *>(inValue)->getTimelineAttachment() !=
 				static_cast<VertexAttachment *>(_attachment)->getTimelineAttachment()) {
 		_deform.clear();
+		_deformVersion++;
 	}
 
 	_attachment = inValue;
 	_sequenceIndex = -1;
+	_skeleton.markPoseChanged();
 }
 
 int Slot::getAttachmentState() {
@@ -120,10 +123,21 @@ Vector<float> &Slot::getDeform() {
 	return _deform;
 }
 
+unsigned int Slot::getDeformVersion() {
+	return _deformVersion;
+}
+
+void Slot::markDeformChanged() {
+	_deformVersion++;
+	_skeleton.markPoseChanged();
+}
+
 int Slot::getSequenceIndex() {
 	return _sequenceIndex;
 }
 
 void Slot::setSequenceIndex(int index) {
+	if (_sequenceIndex == index) return;
 	_sequenceIndex = index;
+	_skeleton.markPoseChanged();
 }
@@ -29,6 +29,8 @@
 
 #include <spine/SlotData.h>
 
+#include <spine/SkeletonData.h>
+
 #include <assert.h>
 
 using namespace spine;
@@ -40,7 +42,9 @@ SlotData::SlotData(int index, const String &name, BoneData &boneData) : _index(i
 																		_darkColor(0, 0, 0, 0),
 																		_hasDarkColor(false),
 																		_attachmentName(),
-																		_blendMode(BlendMode_Normal) {
+																		_attachmentNameId(-2),
+																		_blendMode(BlendMode_Normal),
+																		_skeletonData(NULL) {
 	assert(_index >= 0);
 	assert(_name.length() > 0);
 }
@@ -79,6 +83,13 @@ const String &SlotData::getAttachmentName() {
 
 void SlotData::setAttachmentName(const String &inValue) {
 	_attachmentName = inValue;
+	_attachmentNameId = -2;
+	// Skins keep the setup attachments found by Skeleton::setSkin().
+	if (_skeletonData) _skeletonData->_setupAttachmentsVersion++;
+}
+
+int SlotData::getAttachmentNameId() {
+	return _attachmentNameId;
 }
 
 BlendMode SlotData::getBlendMode() {
@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #include <spine/TextureLoader.h>
+#include <spine/Extension.h>
 
 namespace spine {
 	TextureLoader::TextureLoader() {
@@ -35,4 +36,16 @@ namespace spine {
 
 	TextureLoader::~TextureLoader() {
 	}
+
+	bool TextureLoader::readPixels(AtlasPage &page, Vector<unsigned char> &pixels) {
+		SP_UNUSED(page);
+		SP_UNUSED(pixels);
+		return false;
+	}
+
+	void TextureLoader::loadPixels(AtlasPage &page, const unsigned char *pixels, AtlasPage &sourcePage) {
+		SP_UNUSED(page);
+		SP_UNUSED(pixels);
+		SP_UNUSED(sourcePage);
+	}
 }// namespace spine
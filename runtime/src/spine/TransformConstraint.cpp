@@ -41,6 +41,7 @@ RTTI_IMPL(TransformConstraint, Updatable)
 
 TransformConstraint::TransformConstraint(TransformConstraintData &data, Skeleton &skeleton) : Updatable(),
 																							  _data(data),
+																							  _skeleton(skeleton),
 																							  _target(skeleton.findBone(
 																									  data.getTarget()->getName())),
 																							  _mixRotate(
@@ -95,6 +96,7 @@ Bone *TransformConstraint::getTarget() {
 
 void TransformConstraint::setTarget(Bone *inValue) {
 	_target = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float TransformConstraint::getMixRotate() {
@@ -103,6 +105,7 @@ float TransformConstraint::getMixRotate() {
 
 void TransformConstraint::setMixRotate(float inValue) {
 	_mixRotate = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float TransformConstraint::getMixX() {
@@ -111,6 +114,7 @@ float TransformConstraint::getMixX() {
 
 void TransformConstraint::setMixX(float inValue) {
 	_mixX = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float TransformConstraint::getMixY() {
@@ -119,10 +123,12 @@ float TransformConstraint::getMixY() {
 
 void TransformConstraint::setMixY(float inValue) {
 	_mixY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 void TransformConstraint::setMixScaleX(float inValue) {
 	_mixScaleX = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float TransformConstraint::getMixScaleX() {
@@ -135,6 +141,7 @@ float TransformConstraint::getMixScaleY() {
 
 void TransformConstraint::setMixScaleY(float inValue) {
 	_mixScaleY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 float TransformConstraint::getMixShearY() {
@@ -143,6 +150,7 @@ float TransformConstraint::getMixShearY() {
 
 void TransformConstraint::setMixShearY(float inValue) {
 	_mixShearY = inValue;
+	_skeleton.markPoseChanged();
 }
 
 void TransformConstraint::applyAbsoluteWorld() {
@@ -32,10 +32,86 @@
 #include <spine/Slot.h>
 
 #include <spine/Bone.h>
+#include <spine/Float4.h>
 #include <spine/Skeleton.h>
 
 using namespace spine;
 
+namespace {
+	// Meshes bound to more bones than this use the scalar path, so the bone transforms fit on the stack.
+	const size_t MAX_SKINNING_BONES = 256;
+
+	enum {
+		TRANSFORM_A, TRANSFORM_B, TRANSFORM_X, TRANSFORM_C, TRANSFORM_D, TRANSFORM_Y, TRANSFORM_SIZE
+	};
+
+	/// Transforms one group of vertices that are all bound to the same number of bones. If mapped, deform indices are looked up
+	/// in deformMap first. Four vertices at a time use Float4, which is SSE2 or NEON as compiled, never AVX2 chosen at runtime.
+	template<bool deformed, bool mapped>
+	void skinGroup(int boneCount, int vertexCount, const unsigned short *bones, const float *vertices, const int *deformIndices,
+				   const float *deform, const int *deformMap, const float *transforms, const unsigned short *order, float *worldVertices,
+				   size_t offset, size_t stride) {
+		int i = 0;
+		for (; i + 4 <= vertexCount; i += 4) {
+			Float4 wx = splat4(0), wy = splat4(0);
+			for (int j = 0; j < boneCount; j++) {
+				const float *block = vertices + j * 3 * vertexCount;
+				const unsigned short *blockBones = bones + j * vertexCount + i;
+				Float4 vx = load4(block + i), vy = load4(block + vertexCount + i), weight = load4(block + 2 * vertexCount + i);
+				if (deformed) {
+					const int *f = deformIndices + j * vertexCount + i;
+					int f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3];
+					if (mapped) {
+						f0 = deformMap[f0];
+						f1 = deformMap[f1];
+						f2 = deformMap[f2];
+						f3 = deformMap[f3];
+					}
+					vx = vx + set4(deform[f0], deform[f1], deform[f2], deform[f3]);
+					vy = vy + set4(deform[f0 + 1], deform[f1 + 1], deform[f2 + 1], deform[f3 + 1]);
+				}
+				const float *t0 = transforms + blockBones[0] * TRANSFORM_SIZE, *t1 = transforms + blockBones[1] * TRANSFORM_SIZE;
+				const float *t2 = transforms + blockBones[2] * TRANSFORM_SIZE, *t3 = transforms + blockBones[3] * TRANSFORM_SIZE;
+				Float4 a = set4(t0[TRANSFORM_A], t1[TRANSFORM_A], t2[TRANSFORM_A], t3[TRANSFORM_A]);
+				Float4 b = set4(t0[TRANSFORM_B], t1[TRANSFORM_B], t2[TRANSFORM_B], t3[TRANSFORM_B]);
+				Float4 x = set4(t0[TRANSFORM_X], t1[TRANSFORM_X], t2[TRANSFORM_X], t3[TRANSFORM_X]);
+				Float4 c = set4(t0[TRANSFORM_C], t1[TRANSFORM_C], t2[TRANSFORM_C], t3[TRANSFORM_C]);
+				Float4 d = set4(t0[TRANSFORM_D], t1[TRANSFORM_D], t2[TRANSFORM_D], t3[TRANSFORM_D]);
+				Float4 y = set4(t0[TRANSFORM_Y], t1[TRANSFORM_Y], t2[TRANSFORM_Y], t3[TRANSFORM_Y]);
+				wx = wx + (vx * a + vy * b + x) * weight;
+				wy = wy + (vx * c + vy * d + y) * weight;
+			}
+			float result[8];
+			store4(result, wx);
+			store4(result + 4, wy);
+			for (int l = 0; l < 4; l++) {
+				size_t w = offset + order[i + l] * stride;
+				worldVertices[w] = result[l];
+				worldVertices[w + 1] = result[4 + l];
+			}
+		}
+		for (; i < vertexCount; i++) {
+			float wx = 0, wy = 0;
+			for (int j = 0; j < boneCount; j++) {
+				const float *block = vertices + j * 3 * vertexCount;
+				float vx = block[i], vy = block[vertexCount + i], weight = block[2 * vertexCount + i];
+				if (deformed) {
+					int f = deformIndices[j * vertexCount + i];
+					if (mapped) f = deformMap[f];
+					vx += deform[f];
+					vy += deform[f + 1];
+				}
+				const float *t = transforms + bones[j * vertexCount + i] * TRANSFORM_SIZE;
+				wx += (vx * t[TRANSFORM_A] + vy * t[TRANSFORM_B] + t[TRANSFORM_X]) * weight;
+				wy += (vx * t[TRANSFORM_C] + vy * t[TRANSFORM_D] + t[TRANSFORM_Y]) * weight;
+			}
+			size_t w = offset + order[i] * stride;
+			worldVertices[w] = wx;
+			worldVertices[w + 1] = wy;
+		}
+	}
+}
+
 RTTI_IMPL(VertexAttachment, Attachment)
 
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0),
@@ -60,9 +136,15 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 
 void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 											size_t stride) {
+	transformVertices(slot, slot.getDeform(), NULL, start, count, worldVertices, offset, stride);
+}
+
+void VertexAttachment::transformVertices(Slot &slot, Vector<float> &deform, const int *deformMap, size_t start,
+										 size_t count, float *worldVertices, size_t offset, size_t stride) {
+	bool allVertices = start == 0 && count == _worldVerticesLength;
 	count = offset + (count >> 1) * stride;
 	Skeleton &skeleton = slot._bone._skeleton;
-	Vector<float> *deformArray = &slot.getDeform();
+	Vector<float> *deformArray = &deform;
 	Vector<float> *vertices = &_vertices;
 	Vector<int> &bones = _bones;
 	if (bones.size() == 0) {
@@ -72,15 +154,57 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		float x = bone._worldX;
 		float y = bone._worldY;
 		float a = bone._a, b = bone._b, c = bone._c, d = bone._d;
+		const bool mapped = deformMap && vertices == deformArray;
 		for (size_t vv = start, w = offset; w < count; vv += 2, w += stride) {
-			float vx = (*vertices)[vv];
-			float vy = (*vertices)[vv + 1];
+			size_t i = mapped ? deformMap[vv] : vv;
+			float vx = (*vertices)[i];
+			float vy = (*vertices)[i + 1];
 			worldVertices[w] = vx * a + vy * b + x;
 			worldVertices[w + 1] = vx * c + vy * d + y;
 		}
 		return;
 	}
 
+	Vector<Bone *> &skeletonBones = skeleton.getBones();
+	size_t boneCount = _skinningBoneMap.size();
+	if (allVertices && (_skinningOrder.size() << 1) == _worldVerticesLength && boneCount > 0 &&
+		boneCount <= MAX_SKINNING_BONES) {
+		float transforms[MAX_SKINNING_BONES * TRANSFORM_SIZE];
+		for (size_t i = 0; i < boneCount; i++) {
+			Bone &bone = *skeletonBones[_skinningBoneMap[i]];
+			float *transform = transforms + i * TRANSFORM_SIZE;
+			transform[TRANSFORM_A] = bone._a;
+			transform[TRANSFORM_B] = bone._b;
+			transform[TRANSFORM_X] = bone._worldX;
+			transform[TRANSFORM_C] = bone._c;
+			transform[TRANSFORM_D] = bone._d;
+			transform[TRANSFORM_Y] = bone._worldY;
+		}
+		const unsigned short *order = _skinningOrder.buffer();
+		const unsigned short *influenceBones = _skinningBones.buffer();
+		const int *deformIndices = _skinningDeform.buffer();
+		const float *influenceVertices = _skinningVertices.buffer();
+		bool deformed = deformArray->size() > 0;
+		for (size_t i = 0, n = _skinningGroups.size(); i < n; i += 2) {
+			int groupBones = _skinningGroups[i], groupVertices = _skinningGroups[i + 1];
+			if (deformed && deformMap)
+				skinGroup<true, true>(groupBones, groupVertices, influenceBones, influenceVertices, deformIndices,
+									  deformArray->buffer(), deformMap, transforms, order, worldVertices, offset, stride);
+			else if (deformed)
+				skinGroup<true, false>(groupBones, groupVertices, influenceBones, influenceVertices, deformIndices,
+									   deformArray->buffer(), NULL, transforms, order, worldVertices, offset, stride);
+			else
+				skinGroup<false, false>(groupBones, groupVertices, influenceBones, influenceVertices, deformIndices, NULL,
+										NULL, transforms, order, worldVertices, offset, stride);
+			int influences = groupBones * groupVertices;
+			order += groupVertices;
+			influenceBones += influences;
+			deformIndices += influences;
+			influenceVertices += influences * 3;
+		}
+		return;
+	}
+
 	int v = 0, skip = 0;
 	for (size_t i = 0; i < start; i += 2) {
 		int n = (int) bones[v];
@@ -88,7 +212,6 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		skip += n;
 	}
 
-	Vector<Bone *> &skeletonBones = skeleton.getBones();
 	if (deformArray->size() == 0) {
 		for (size_t w = offset, b = skip * 3; w < count; w += stride) {
 			float wx = 0, wy = 0;
@@ -114,8 +237,9 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 			for (; v < n; v++, b += 3, f += 2) {
 				Bone *boneP = skeletonBones[bones[v]];
 				Bone &bone = *boneP;
-				float vx = (*vertices)[b] + (*deformArray)[f];
-				float vy = (*vertices)[b + 1] + (*deformArray)[f + 1];
+				size_t i = deformMap ? deformMap[f] : f;
+				float vx = (*vertices)[b] + (*deformArray)[i];
+				float vy = (*vertices)[b + 1] + (*deformArray)[i + 1];
 				float weight = (*vertices)[b + 2];
 				wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
 				wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
@@ -146,6 +270,24 @@ void VertexAttachment::setWorldVerticesLength(size_t inValue) {
 	_worldVerticesLength = inValue;
 }
 
+unsigned int VertexAttachment::getBonesVersion(Slot &slot) {
+	if (_bones.size() == 0) return slot.getBone().getWorldVersion();
+
+	Vector<Bone *> &skeletonBones = slot.getSkeleton().getBones();
+	unsigned int version = 0;
+	if (_skinningBoneMap.size() > 0) {
+		for (size_t i = 0, n = _skinningBoneMap.size(); i < n; i++)
+			version += skeletonBones[_skinningBoneMap[i]]->getWorldVersion();
+		return version;
+	}
+	for (size_t v = 0, n = _bones.size(); v < n;) {
+		int boneCount = _bones[v++];
+		for (size_t end = v + boneCount; v < end; v++)
+			version += skeletonBones[_bones[v]]->getWorldVersion();
+	}
+	return version;
+}
+
 Attachment *VertexAttachment::getTimelineAttachment() {
 	return _timelineAttachment;
 }
@@ -164,4 +306,65 @@ void VertexAttachment::copyTo(VertexAttachment *other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_timelineAttachment = this->_timelineAttachment;
+	other->updateSkinning();
+}
+
+void VertexAttachment::updateSkinning() {
+	_skinningGroups.clear();
+	_skinningOrder.clear();
+	_skinningBoneMap.clear();
+	_skinningBones.clear();
+	_skinningDeform.clear();
+	_skinningVertices.clear();
+	if (_bones.size() == 0) return;
+
+	// Position of each vertex in the bones array and the largest number of bones per vertex.
+	Vector<int> vertexStarts;
+	int maxBones = 0;
+	for (size_t v = 0, n = _bones.size(); v < n; v += _bones[v] + 1) {
+		vertexStarts.add((int) v);
+		if (_bones[v] > maxBones) maxBones = _bones[v];
+	}
+	if (vertexStarts.size() > 65536) return;
+
+	// Influence index of the first bone of each vertex, which locates its vertex values and deform offsets.
+	Vector<int> influenceStarts;
+	influenceStarts.setSize(vertexStarts.size(), 0);
+	for (size_t i = 1, n = vertexStarts.size(); i < n; i++)
+		influenceStarts[i] = influenceStarts[i - 1] + _bones[vertexStarts[i - 1]];
+
+	Vector<int> localBones;
+	for (int boneCount = 1; boneCount <= maxBones; boneCount++) {
+		int groupVertices = 0;
+		for (size_t i = 0, n = vertexStarts.size(); i < n; i++) {
+			if (_bones[vertexStarts[i]] != boneCount) continue;
+			_skinningOrder.add((unsigned short) i);
+			groupVertices++;
+		}
+		if (groupVertices == 0) continue;
+		_skinningGroups.add(boneCount);
+		_skinningGroups.add(groupVertices);
+
+		size_t groupStart = _skinningOrder.size() - groupVertices;
+		for (int j = 0; j < boneCount; j++) {
+			size_t blockStart = _skinningVertices.size();
+			_skinningVertices.setSize(blockStart + groupVertices * 3, 0);
+			for (int i = 0; i < groupVertices; i++) {
+				int vertex = _skinningOrder[groupStart + i];
+				int boneIndex = _bones[vertexStarts[vertex] + 1 + j];
+				int local = localBones.indexOf(boneIndex);
+				if (local < 0) {
+					local = (int) localBones.size();
+					localBones.add(boneIndex);
+				}
+				int influence = influenceStarts[vertex] + j;
+				_skinningBones.add((unsigned short) local);
+				_skinningDeform.add(influence << 1);
+				_skinningVertices[blockStart + i] = _vertices[influence * 3];
+				_skinningVertices[blockStart + groupVertices + i] = _vertices[influence * 3 + 1];
+				_skinningVertices[blockStart + groupVertices * 2 + i] = _vertices[influence * 3 + 2];
+			}
+		}
+	}
+	_skinningBoneMap.addAll(localBones);
 }
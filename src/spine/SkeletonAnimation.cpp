@@ -107,6 +107,37 @@ namespace spine {
 		return node;
 	}
 
+	SkeletonAnimation *SkeletonAnimation::createWithAsset(const std::shared_ptr<SkeletonAsset> &asset) {
+		SkeletonAnimation *node = new SkeletonAnimation();
+		node->initWithAsset(asset);
+		node->autorelease();
+		return node;
+	}
+
+	SkeletonAnimation *SkeletonAnimation::createWithPrototype(SkeletonAnimation *prototype) {
+		SkeletonAnimation *node = new SkeletonAnimation();
+		node->initWithPrototype(prototype);
+		node->autorelease();
+		return node;
+	}
+
+	static SkeletonAssetCallback createNodeCallback(const SkeletonAnimationCreatedCallback &callback) {
+		return [callback](const SkeletonAssetPtr &asset, const std::string &error) {
+			if (!asset) log("Spine: %s", error.c_str());
+			SkeletonAnimation *node = asset ? SkeletonAnimation::createWithAsset(asset) : nullptr;
+			if (callback) callback(node);
+		};
+	}
+
+	unsigned int SkeletonAnimation::createWithJsonFileAsync(const std::string &skeletonJsonFile, const std::string &atlasFile, float scale,
+															const SkeletonAnimationCreatedCallback &callback, const SkeletonLoadProgressCallback &progress) {
+		return SkeletonAsyncLoader::getInstance()->loadJsonAsync(skeletonJsonFile, atlasFile, scale, createNodeCallback(callback), progress);
+	}
+
+	unsigned int SkeletonAnimation::createWithBinaryFileAsync(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale,
+															  const SkeletonAnimationCreatedCallback &callback, const SkeletonLoadProgressCallback &progress) {
+		return SkeletonAsyncLoader::getInstance()->loadBinaryAsync(skeletonBinaryFile, atlasFile, scale, createNodeCallback(callback), progress);
+	}
 
 	void SkeletonAnimation::initialize() {
 		super::initialize();
@@ -120,6 +151,41 @@ namespace spine {
 		_firstDraw = true;
 	}
 
+	void SkeletonAnimation::initWithPrototype(SkeletonAnimation *prototype) {
+		super::initWithPrototype(prototype);
+
+		_ownsAnimationStateData = false;
+		_updateOnlyIfVisible = prototype->_updateOnlyIfVisible;
+		_state = new (__FILE__, __LINE__) AnimationState(prototype->_state->getData());
+		_state->setTimeScale(prototype->_state->getTimeScale());
+		_state->setRendererObject(this);
+		_state->setListener(animationCallback);
+
+		_firstDraw = true;
+	}
+
+	void SkeletonAnimation::cloneFrom(SkeletonRenderer *prototype) {
+		super::cloneFrom(prototype);
+
+		_startListener = nullptr;
+		_interruptListener = nullptr;
+		_endListener = nullptr;
+		_disposeListener = nullptr;
+		_completeListener = nullptr;
+		_eventListener = nullptr;
+		_preUpdateListener = nullptr;
+		_postUpdateListener = nullptr;
+		_state->clearTracks();
+
+		SkeletonAnimation *animation = dynamic_cast<SkeletonAnimation *>(prototype);
+		if (animation) {
+			_updateOnlyIfVisible = animation->_updateOnlyIfVisible;
+			_state->setTimeScale(animation->_state->getTimeScale());
+		}
+		_appliedPoseVersion = 0;
+		_firstDraw = true;
+	}
+
 	SkeletonAnimation::SkeletonAnimation()
 		: SkeletonRenderer() {
 	}
@@ -137,8 +203,13 @@ namespace spine {
 		deltaTime *= _timeScale;
 		if (_preUpdateListener) _preUpdateListener(this);
 		_state->update(deltaTime);
-		_state->apply(*_skeleton);
-		_skeleton->updateWorldTransform();
+		// Nothing changes while the state did not advance and the pose was not changed, for example when paused.
+		if (_state->getVersion() != _appliedStateVersion || _skeleton->getPoseVersion() != _appliedPoseVersion) {
+			_appliedStateVersion = _state->getVersion();
+			_state->apply(*_skeleton);
+			_skeleton->updateWorldTransform();
+			_appliedPoseVersion = _skeleton->getPoseVersion();
+		}
 		if (_postUpdateListener) _postUpdateListener(this);
 	}
 
@@ -160,6 +231,7 @@ namespace spine {
 		_state = new (__FILE__, __LINE__) AnimationState(stateData);
 		_state->setRendererObject(this);
 		_state->setListener(animationCallback);
+		_appliedPoseVersion = 0;
 	}
 
 	void SkeletonAnimation::setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration) {
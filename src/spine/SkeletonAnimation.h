@@ -31,6 +31,7 @@
 #define SPINE_SKELETONANIMATION_H_
 
 #include <spine/spine-axmol.h>
+#include <spine/SkeletonAsyncLoader.h>
 #include <spine/spine.h>
 
 namespace spine {
@@ -44,6 +45,8 @@ namespace spine {
 	typedef std::function<void(TrackEntry *entry)> CompleteListener;
 	typedef std::function<void(TrackEntry *entry, Event *event)> EventListener;
 	typedef std::function<void(SkeletonAnimation *node)> UpdateWorldTransformsListener;
+	/* The node is null if loading failed. */
+	typedef std::function<void(SkeletonAnimation *node)> SkeletonAnimationCreatedCallback;
 
 	/** Draws an animated skeleton, providing an AnimationState for applying one or more animations and queuing animations to be
   * played later. */
@@ -54,6 +57,15 @@ namespace spine {
 		static SkeletonAnimation *createWithJsonFile(const std::string &skeletonJsonFile, const std::string &atlasFile, float scale = 1);
 		static SkeletonAnimation *createWithBinaryFile(const std::string &skeletonBinaryFile, Atlas *atlas, float scale = 1);
 		static SkeletonAnimation *createWithBinaryFile(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale = 1);
+		static SkeletonAnimation *createWithAsset(const std::shared_ptr<SkeletonAsset> &asset);
+		static SkeletonAnimation *createWithPrototype(SkeletonAnimation *prototype);
+
+		/* Loads the atlas and skeleton data on a worker thread and calls back on the main thread with an autoreleased node.
+		 * Returns a request id that can be passed to SkeletonAsyncLoader::cancel(). */
+		static unsigned int createWithJsonFileAsync(const std::string &skeletonJsonFile, const std::string &atlasFile, float scale,
+													const SkeletonAnimationCreatedCallback &callback, const SkeletonLoadProgressCallback &progress = nullptr);
+		static unsigned int createWithBinaryFileAsync(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale,
+													  const SkeletonAnimationCreatedCallback &callback, const SkeletonLoadProgressCallback &progress = nullptr);
 
 		// Use createWithJsonFile instead
 		AX_DEPRECATED_ATTRIBUTE static SkeletonAnimation *createWithFile(const std::string &skeletonJsonFile, Atlas *atlas, float scale = 1) {
@@ -106,12 +118,22 @@ namespace spine {
 		virtual ~SkeletonAnimation();
 		virtual void initialize() override;
 
+		/* Copies the prototype as SkeletonRenderer::initWithPrototype() does and shares its AnimationStateData. The tracks and
+		 * listeners are not copied. */
+		void initWithPrototype(SkeletonAnimation *prototype);
+
+		/* Also removes the listeners set on the node, then clears the tracks, and copies the prototype's animation state time
+		 * scale. */
+		virtual void cloneFrom(SkeletonRenderer *prototype) override;
+
 	protected:
 		AnimationState *_state;
 
 		bool _ownsAnimationStateData;
 		bool _updateOnlyIfVisible;
 		bool _firstDraw;
+		unsigned int _appliedStateVersion = 0;
+		unsigned int _appliedPoseVersion = 0;
 
 		StartListener _startListener;
 		InterruptListener _interruptListener;
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonAnimationPool.h>
+
+USING_NS_AX;
+
+namespace spine {
+
+	SkeletonAnimationPool::SkeletonAnimationPool(SkeletonAnimation *prototype, int maxFree)
+		: _prototype(prototype), _maxFree(maxFree) {
+		AXASSERT(prototype, "prototype cannot be null.");
+		_prototype->retain();
+	}
+
+	SkeletonAnimationPool::~SkeletonAnimationPool() {
+		_free.clear();
+		_prototype->release();
+	}
+
+	SkeletonAnimation *SkeletonAnimationPool::obtain() {
+		if (_free.empty()) return SkeletonAnimation::createWithPrototype(_prototype);
+
+		// Popping releases the pool's reference, autorelease hands the node out like the create functions do.
+		SkeletonAnimation *node = _free.back();
+		node->retain();
+		node->autorelease();
+		_free.popBack();
+		return node;
+	}
+
+	void SkeletonAnimationPool::free(SkeletonAnimation *node) {
+		AXASSERT(node, "node cannot be null.");
+		AXASSERT(!_free.contains(node), "node is already free.");
+		if ((int) _free.size() >= _maxFree) {
+			node->removeFromParent();
+			return;
+		}
+
+		// Added first so removing it from its parent does not destroy it.
+		_free.pushBack(node);
+		node->removeFromParent();
+		// Removing cleans up only a node that had a parent, a node that was never added may still have actions or callbacks.
+		node->stopAllActions();
+		node->unscheduleAllCallbacks();
+		node->cloneFrom(_prototype);
+		node->setTag(Node::INVALID_TAG);
+		node->setName("");
+		node->setPosition(Vec2::ZERO);
+		node->setScale(1);
+		node->setRotation(0);
+		node->setColor(Color3B::WHITE);
+		node->setOpacity(255);
+		node->setVisible(true);
+	}
+
+	void SkeletonAnimationPool::reserve(int count) {
+		while ((int) _free.size() < count)
+			_free.pushBack(SkeletonAnimation::createWithPrototype(_prototype));
+	}
+
+	void SkeletonAnimationPool::clear() {
+		_free.clear();
+	}
+
+	int SkeletonAnimationPool::getFreeCount() const {
+		return (int) _free.size();
+	}
+
+	void SkeletonAnimationPool::setMaxFree(int maxFree) {
+		_maxFree = maxFree;
+		while ((int) _free.size() > _maxFree)
+			_free.popBack();
+	}
+
+	int SkeletonAnimationPool::getMaxFree() const {
+		return _maxFree;
+	}
+
+	SkeletonAnimation *SkeletonAnimationPool::getPrototype() const {
+		return _prototype;
+	}
+
+}// namespace spine
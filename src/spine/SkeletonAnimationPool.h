@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONANIMATIONPOOL_H_
+#define SPINE_SKELETONANIMATIONPOOL_H_
+
+#include <spine/SkeletonAnimation.h>
+
+namespace spine {
+
+	/* Recycles SkeletonAnimation nodes created from a prototype, so spawning short-lived actors neither allocates a node nor
+	 * sets up a new skeleton. Freed nodes are reset to the prototype with SkeletonAnimation::cloneFrom(). The prototype is
+	 * retained by the pool and should not be changed while nodes are in use. */
+	class SP_API SkeletonAnimationPool {
+	public:
+		explicit SkeletonAnimationPool(SkeletonAnimation *prototype, int maxFree = 64);
+		~SkeletonAnimationPool();
+
+		/* Returns an autoreleased node, a free one if there is one, otherwise one created from the prototype. */
+		SkeletonAnimation *obtain();
+
+		/* Removes the node from its parent and keeps it for obtain(), reset to the prototype with the default position, scale,
+		 * rotation, color, opacity, tag and name, visible, and with no running actions or scheduled callbacks. Beyond the maximum free count the node is only removed from its parent. Must
+		 * not be called from one of the node's listeners, as resetting the node removes them. */
+		void free(SkeletonAnimation *node);
+
+		/* Creates nodes until count nodes are free, e.g. while loading a level. */
+		void reserve(int count);
+
+		/* Releases the free nodes. */
+		void clear();
+
+		int getFreeCount() const;
+
+		/* The maximum number of free nodes kept. Default is 64. */
+		void setMaxFree(int maxFree);
+		int getMaxFree() const;
+
+		SkeletonAnimation *getPrototype() const;
+
+	private:
+		SkeletonAnimationPool(const SkeletonAnimationPool &) = delete;
+		SkeletonAnimationPool &operator=(const SkeletonAnimationPool &) = delete;
+
+		SkeletonAnimation *_prototype;
+		axmol::Vector<SkeletonAnimation *> _free;
+		int _maxFree;
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONANIMATIONPOOL_H_ */
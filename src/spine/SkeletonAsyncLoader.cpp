@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/spine-axmol.h>
+
+#include <algorithm>
+#include <chrono>
+#include <spine/Extension.h>
+
+USING_NS_AX;
+
+namespace spine {
+
+	namespace {
+		AxmolTextureLoader textureLoader;
+	}
+
+	struct SkeletonAsyncLoader::Request {
+		unsigned int id;
+		std::string skeletonFile;
+		std::string atlasFile;
+		float scale;
+		bool binary;
+		SkeletonAssetCallback callback;
+		SkeletonLoadProgressCallback progress;
+		std::atomic<bool> cancelled;
+
+		SkeletonAsset *asset;
+		std::vector<Image *> images;
+		std::string error;
+
+		Request() : id(0), scale(1), binary(false), cancelled(false), asset(nullptr) {}
+
+		// finish() takes the images and the asset on the main thread. Only requests never finished, dropped with the loader on
+		// the main thread, still hold them here.
+		~Request() {
+			for (Image *image : images)
+				AX_SAFE_RELEASE(image);
+			delete asset;
+		}
+	};
+
+	SkeletonAsset::SkeletonAsset() : _atlas(nullptr), _attachmentLoader(nullptr), _skeletonData(nullptr) {
+	}
+
+	SkeletonAsset::~SkeletonAsset() {
+		delete _skeletonData;
+		delete _attachmentLoader;
+		delete _atlas;
+	}
+
+	static SkeletonAsyncLoader *instance = nullptr;
+
+	SkeletonAsyncLoader *SkeletonAsyncLoader::getInstance() {
+		if (!instance) instance = new SkeletonAsyncLoader();
+		return instance;
+	}
+
+	void SkeletonAsyncLoader::destroyInstance() {
+		if (instance) {
+			delete instance;
+			instance = nullptr;
+		}
+	}
+
+	SkeletonAsyncLoader::SkeletonAsyncLoader() : _quit(false), _nextRequestId(1), _lastMainThreadTime(0) {
+		// Make sure the extension exists before the worker can race to create it.
+		SpineExtension::getInstance();
+		_worker = std::thread(&SkeletonAsyncLoader::workerLoop, this);
+	}
+
+	SkeletonAsyncLoader::~SkeletonAsyncLoader() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+			for (auto &request : _pending)
+				request->cancelled = true;
+		}
+		_condition.notify_all();
+		if (_worker.joinable()) _worker.join();
+	}
+
+	unsigned int SkeletonAsyncLoader::loadJsonAsync(const std::string &skeletonJsonFile, const std::string &atlasFile, float scale,
+													const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress) {
+		return enqueue(skeletonJsonFile, atlasFile, scale, false, callback, progress);
+	}
+
+	unsigned int SkeletonAsyncLoader::loadBinaryAsync(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale,
+													  const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress) {
+		return enqueue(skeletonBinaryFile, atlasFile, scale, true, callback, progress);
+	}
+
+	unsigned int SkeletonAsyncLoader::enqueue(const std::string &skeletonFile, const std::string &atlasFile, float scale, bool binary,
+											  const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress) {
+		RequestPtr request = std::make_shared<Request>();
+		request->skeletonFile = FileUtils::getInstance()->fullPathForFilename(skeletonFile);
+		request->atlasFile = FileUtils::getInstance()->fullPathForFilename(atlasFile);
+		request->scale = scale;
+		request->binary = binary;
+		request->callback = callback;
+		request->progress = progress;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			request->id = _nextRequestId++;
+			_requests.push_back(request);
+			_pending.push_back(request);
+		}
+		_condition.notify_one();
+		return request->id;
+	}
+
+	void SkeletonAsyncLoader::cancel(unsigned int requestId) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto &request : _pending) {
+			if (request->id == requestId) {
+				request->cancelled = true;
+				break;
+			}
+		}
+	}
+
+	void SkeletonAsyncLoader::cancelAll() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto &request : _pending)
+			request->cancelled = true;
+	}
+
+	void SkeletonAsyncLoader::workerLoop() {
+		while (true) {
+			RequestPtr request;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_condition.wait(lock, [this] { return _quit || !_requests.empty(); });
+				if (_quit) return;
+				request = _requests.front();
+				_requests.pop_front();
+			}
+			if (!request->cancelled) load(request);
+
+			// The request is moved into the callback, so the worker never holds the last reference and the request is never
+			// destroyed on this thread. The loader may have been destroyed by the time the main thread gets to this.
+			Director::getInstance()->getScheduler()->runOnAxmolThread([request = std::move(request)]() {
+				if (instance) instance->finish(request);
+			});
+		}
+	}
+
+	void SkeletonAsyncLoader::load(const RequestPtr &request) {
+		SkeletonAsset *asset = request->asset = new SkeletonAsset();
+
+		// The textures are created later on the main thread, so the atlas only records the page paths.
+		asset->_atlas = new (__FILE__, __LINE__) Atlas(request->atlasFile.c_str(), &textureLoader, false);
+		Vector<AtlasPage *> &pages = asset->_atlas->getPages();
+		if (pages.size() == 0) {
+			request->error = "Error reading atlas file: " + request->atlasFile;
+			return;
+		}
+
+		// Steps: atlas, one per page image, skeleton data, texture creation.
+		const int totalSteps = (int) pages.size() + 3;
+		int completedSteps = 1;
+		reportProgress(request, completedSteps, totalSteps);
+
+		for (size_t i = 0, n = pages.size(); i < n; ++i) {
+			if (request->cancelled) return;
+			Image *image = new Image();
+			if (!image->initWithImageFile(pages[i]->texturePath.buffer())) {
+				AX_SAFE_RELEASE(image);
+				request->error = std::string("Invalid image: ") + pages[i]->texturePath.buffer();
+				return;
+			}
+			request->images.push_back(image);
+			reportProgress(request, ++completedSteps, totalSteps);
+		}
+
+		if (request->cancelled) return;
+		asset->_attachmentLoader = new (__FILE__, __LINE__) AxmolAtlasAttachmentLoader(asset->_atlas);
+		if (request->binary) {
+			SkeletonBinary binary(asset->_attachmentLoader);
+			binary.setScale(request->scale);
+			asset->_skeletonData = binary.readSkeletonDataFile(request->skeletonFile.c_str());
+			if (!asset->_skeletonData) request->error = binary.getError().buffer() ? binary.getError().buffer() : "Error reading skeleton data.";
+		} else {
+			SkeletonJson json(asset->_attachmentLoader);
+			json.setScale(request->scale);
+			asset->_skeletonData = json.readSkeletonDataFile(request->skeletonFile.c_str());
+			if (!asset->_skeletonData) request->error = json.getError().buffer() ? json.getError().buffer() : "Error reading skeleton data.";
+		}
+		if (asset->_skeletonData) reportProgress(request, ++completedSteps, totalSteps);
+	}
+
+	void SkeletonAsyncLoader::reportProgress(const RequestPtr &request, int completedSteps, int totalSteps) {
+		if (!request->progress) return;
+		const float progress = (float) completedSteps / totalSteps;
+		Director::getInstance()->getScheduler()->runOnAxmolThread([request, progress]() {
+			if (!request->cancelled) request->progress(progress);
+		});
+	}
+
+	void SkeletonAsyncLoader::finish(const RequestPtr &request) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pending.erase(std::remove(_pending.begin(), _pending.end(), request), _pending.end());
+		}
+
+		// Take what the worker created, so it is released here on the main thread rather than by whichever thread drops the
+		// last reference to the request.
+		SkeletonAssetPtr asset(request->asset);
+		request->asset = nullptr;
+		std::vector<Image *> images;
+		images.swap(request->images);
+
+		if (request->cancelled || !request->error.empty() || !asset || !asset->_skeletonData) asset.reset();
+		if (asset) {
+			auto start = std::chrono::steady_clock::now();
+
+			Atlas *atlas = asset->_atlas;
+			Vector<AtlasPage *> &pages = atlas->getPages();
+			TextureCache *textureCache = Director::getInstance()->getTextureCache();
+			for (size_t i = 0, n = pages.size(); i < n; ++i) {
+				AtlasPage &page = *pages[i];
+				textureLoader.load(page, textureCache->addImage(images[i], page.texturePath.buffer()));
+			}
+			Vector<AtlasRegion *> &regions = atlas->getRegions();
+			for (size_t i = 0, n = regions.size(); i < n; ++i) {
+				if (!regions[i]->rendererObject) regions[i]->rendererObject = regions[i]->page->texture;
+			}
+
+			_lastMainThreadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (request->progress) request->progress(1);
+		}
+		// The texture cache keeps its own reference to the images it made textures from.
+		for (Image *image : images)
+			AX_SAFE_RELEASE(image);
+
+		if (request->cancelled) return;
+		if (request->callback) request->callback(asset, asset ? std::string() : request->error);
+	}
+
+}// namespace spine
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONASYNCLOADER_H_
+#define SPINE_SKELETONASYNCLOADER_H_
+
+#include "axmol.h"
+#include <spine/spine.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace spine {
+
+	/* Skeleton data loaded by SkeletonAsyncLoader, together with the atlas and attachment loader it references. Nodes created
+	 * from an asset keep it alive, so one asset can be shared by any number of skeletons. Must be released on the main thread
+	 * as destroying it releases the atlas textures. */
+	class SP_API SkeletonAsset {
+	public:
+		SkeletonAsset();
+		~SkeletonAsset();
+
+		Atlas *getAtlas() const { return _atlas; }
+		SkeletonData *getSkeletonData() const { return _skeletonData; }
+
+	private:
+		friend class SkeletonAsyncLoader;
+
+		Atlas *_atlas;
+		AttachmentLoader *_attachmentLoader;
+		SkeletonData *_skeletonData;
+	};
+
+	typedef std::shared_ptr<SkeletonAsset> SkeletonAssetPtr;
+
+	/* Called on the main thread. The asset is null if loading failed, in which case error describes why. */
+	typedef std::function<void(const SkeletonAssetPtr &asset, const std::string &error)> SkeletonAssetCallback;
+	/* Called on the main thread with the fraction of the request completed so far, in [0, 1]. */
+	typedef std::function<void(float progress)> SkeletonLoadProgressCallback;
+
+	/* Loads skeleton data without blocking the main thread. Reading the atlas, decoding the page images and parsing the
+	 * skeleton happen on a worker thread; only the creation of the GPU textures is marshalled back to the main thread.
+	 * Requests are processed one at a time in the order they were queued. */
+	class SP_API SkeletonAsyncLoader {
+	public:
+		static SkeletonAsyncLoader *getInstance();
+
+		static void destroyInstance();
+
+		/* Returns a request id that can be passed to cancel(). */
+		unsigned int loadJsonAsync(const std::string &skeletonJsonFile, const std::string &atlasFile, float scale,
+								   const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress = nullptr);
+		unsigned int loadBinaryAsync(const std::string &skeletonBinaryFile, const std::string &atlasFile, float scale,
+									 const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress = nullptr);
+
+		/* Cancels a pending request. Its callbacks are not invoked and any partially loaded data is discarded. */
+		void cancel(unsigned int requestId);
+		void cancelAll();
+
+		/* Time in milliseconds the main thread spent finishing the last completed request, i.e. creating its textures. */
+		float getLastMainThreadTime() const { return _lastMainThreadTime; }
+
+	protected:
+		struct Request;
+		typedef std::shared_ptr<Request> RequestPtr;
+
+		SkeletonAsyncLoader();
+		virtual ~SkeletonAsyncLoader();
+
+		unsigned int enqueue(const std::string &skeletonFile, const std::string &atlasFile, float scale, bool binary,
+							 const SkeletonAssetCallback &callback, const SkeletonLoadProgressCallback &progress);
+		void workerLoop();
+		void load(const RequestPtr &request);
+		void reportProgress(const RequestPtr &request, int completedSteps, int totalSteps);
+		void finish(const RequestPtr &request);
+
+		std::thread _worker;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<RequestPtr> _requests;
+		std::vector<RequestPtr> _pending;
+		bool _quit;
+		unsigned int _nextRequestId;
+		float _lastMainThreadTime;
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONASYNCLOADER_H_ */
@@ -35,7 +35,8 @@
 USING_NS_AX;
 #define EVENT_AFTER_DRAW_RESET_POSITION "director_after_draw"
 using std::max;
-#define INITIAL_SIZE (10000)
+// Pools twice as large as the most used in this many frames are trimmed to it.
+#define TRIM_INTERVAL (600)
 
 #include "renderer/backend/DriverBase.h"
 #include "renderer/Shaders.h"
@@ -44,6 +45,11 @@ using std::max;
 namespace spine {
 
 	static SkeletonBatch *instance = nullptr;
+	static uint32_t initialCapacity = 64;
+
+	void SkeletonBatch::setInitialCapacity(uint32_t commands) {
+		initialCapacity = commands;
+	}
 
 	SkeletonBatch *SkeletonBatch::getInstance() {
 		if (!instance) instance = new SkeletonBatch();
@@ -61,7 +67,9 @@ namespace spine {
 
 		auto program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
 		_programState = new backend::ProgramState(program);// new default program state
-		for (unsigned int i = 0; i < INITIAL_SIZE; i++) {
+		_initialCapacity = initialCapacity;
+		_commandsPool.reserve(_initialCapacity);
+		for (unsigned int i = 0; i < _initialCapacity; i++) {
 			_commandsPool.push_back(newCommand());
 		}
 		reset();
@@ -76,8 +84,7 @@ namespace spine {
 		Director::getInstance()->getEventDispatcher()->removeCustomEventListeners(EVENT_AFTER_DRAW_RESET_POSITION);
 
 		for (unsigned int i = 0; i < _commandsPool.size(); i++) {
-			AX_SAFE_RELEASE(_commandsPool[i]->getPipelineDescriptor().programState);
-			delete _commandsPool[i];
+			deleteCommand(_commandsPool[i]);
 			_commandsPool[i] = nullptr;
 		}
 
@@ -99,6 +106,7 @@ namespace spine {
 		
 			command->_locMVP     = currentState->getUniformLocation(backend::UNIFORM_NAME_MVP_MATRIX);
 	        command->_locTexture = currentState->getUniformLocation(backend::UNIFORM_NAME_TEXTURE);
+			command->_boundTexture = nullptr;
 		}
 		return currentState;
 	}
@@ -165,8 +173,18 @@ namespace spine {
 
 		auto pipelinePS = updateCommandPipelinePS(command, programState);
 
-		pipelinePS->setUniform(command->_locMVP, projectionMat.m, sizeof(projectionMat.m));
-		pipelinePS->setTexture(command->_locTexture, 0, texture->getBackendTexture());
+		// The pooled command keeps its program state from frame to frame, usually with the same projection and texture.
+		backend::TextureBackend *backendTexture = texture->getBackendTexture();
+		if (command->_boundTexture == nullptr || memcmp(command->_boundProjection.m, projectionMat.m, sizeof(projectionMat.m)) != 0) {
+			pipelinePS->setUniform(command->_locMVP, projectionMat.m, sizeof(projectionMat.m));
+			command->_boundProjection = projectionMat;
+			_numUniformUpdates++;
+		}
+		if (command->_boundTexture != backendTexture) {
+			pipelinePS->setTexture(command->_locTexture, 0, backendTexture);
+			command->_boundTexture = backendTexture;
+			_numUniformUpdates++;
+		}
 
 		command->init(globalOrder, texture, blendType, triangles, mv, flags);
 		renderer->addCommand(command);
@@ -174,18 +192,20 @@ namespace spine {
 	}
 
 	void SkeletonBatch::reset() {
+		_commandsHighWater = max(_commandsHighWater, _nextFreeCommand);
+		_verticesHighWater = max(_verticesHighWater, _numVertices);
+		if (++_framesSinceTrim >= TRIM_INTERVAL) trim();
+		_lastNumCommands = _nextFreeCommand;
+		_lastNumUniformUpdates = _numUniformUpdates;
+		_numUniformUpdates = 0;
 		_nextFreeCommand = 0;
 		_numVertices = 0;
 		_indices.setSize(0, 0);
 	}
 
 	SkeletonCommand *SkeletonBatch::nextFreeCommand() {
-		if (_commandsPool.size() <= (int)_nextFreeCommand) {
-			unsigned int newSize = (int)_commandsPool.size() * 2 + 1;
-			for (int i = _commandsPool.size(); i < newSize; i++) {
-				_commandsPool.push_back(newCommand());
-			}
-		}
+		// Commands are only created when needed, the pool keeps them for the next frames.
+		if (_commandsPool.size() <= _nextFreeCommand) _commandsPool.push_back(newCommand());
 		auto *command = _commandsPool[_nextFreeCommand++];
 		return command;
 	}
@@ -194,5 +214,28 @@ namespace spine {
 		auto *command = new SkeletonCommand();
 		return command;
 	}
+
+	void SkeletonBatch::deleteCommand(SkeletonCommand *command) {
+		AX_SAFE_RELEASE(command->getPipelineDescriptor().programState);
+		delete command;
+	}
+
+	void SkeletonBatch::trim() {
+		// Called between frames, when no command is in use.
+		const uint32_t keepCommands = max(_commandsHighWater, _initialCapacity);
+		if (_commandsPool.size() > keepCommands * 2) {
+			for (size_t i = keepCommands; i < _commandsPool.size(); i++)
+				deleteCommand(_commandsPool[i]);
+			_commandsPool.resize(keepCommands);
+			_commandsPool.shrink_to_fit();
+		}
+		if (_vertices.size() > _verticesHighWater * 2) {
+			_vertices.resize(_verticesHighWater);
+			_vertices.shrink_to_fit();
+		}
+		_commandsHighWater = 0;
+		_verticesHighWater = 0;
+		_framesSinceTrim = 0;
+	}
 }// namespace spine
 
@@ -40,6 +40,9 @@ namespace spine {
 	struct SkeletonCommand : public axmol::TrianglesCommand {
 		axmol::backend::UniformLocation _locMVP;
 		axmol::backend::UniformLocation _locTexture;
+		/* What the program state was last given, so unchanged uniforms are not set again when the command is reused. */
+		axmol::backend::TextureBackend *_boundTexture = nullptr;
+		axmol::Mat4 _boundProjection;
 	};
 	class SP_API SkeletonBatch {
 	public:
@@ -47,6 +50,11 @@ namespace spine {
 
 		static void destroyInstance();
 
+		/* The number of commands created with the instance, which must not exist yet. More are created one at a time when a
+		 * frame needs them. Every 600 frames, a pool more than twice the most used since the last trim is cut back to that
+		 * number, or to this one if larger. Default is 64. */
+		static void setInitialCapacity(uint32_t commands);
+
 		void update(float delta);
 
 		axmol::V3F_C4B_T2F *allocateVertices(uint32_t numVertices);
@@ -57,6 +65,15 @@ namespace spine {
 
 		axmol::backend::ProgramState* updateCommandPipelinePS(SkeletonCommand* command, axmol::backend::ProgramState* programState);
 
+		/* The number of commands added in the last frame drawn. SkeletonRenderer adds one per run of slots with the same
+		 * texture and blend function, not one per slot. */
+		uint32_t getNumCommands() { return _lastNumCommands; }
+		/* The number of uniforms set in the last frame drawn. A reused command only sets the projection and texture when they
+		 * differ from what it had. */
+		uint32_t getNumUniformUpdates() { return _lastNumUniformUpdates; }
+		/* The number of commands in the pool. */
+		uint32_t getCommandCapacity() { return (uint32_t) _commandsPool.size(); }
+
 	protected:
 		SkeletonBatch();
 		virtual ~SkeletonBatch();
@@ -66,19 +83,32 @@ namespace spine {
 		SkeletonCommand* nextFreeCommand ();
 
 		SkeletonCommand* newCommand();
+		void deleteCommand(SkeletonCommand *command);
+
+		/* Shrinks the pools to the most used since the last trim, if they are more than twice as large. */
+		void trim();
 
 		ax::backend::ProgramState*                     _programState; // The default program state
 
 		// pool of commands
 		std::vector<SkeletonCommand *> _commandsPool;
-		uint32_t _nextFreeCommand;
+		uint32_t _nextFreeCommand = 0;
 
 		// pool of vertices
 		std::vector<axmol::V3F_C4B_T2F> _vertices;
-		uint32_t _numVertices;
+		uint32_t _numVertices = 0;
 
 		// pool of indices
 		Vector<unsigned short> _indices;
+
+		uint32_t _numUniformUpdates = 0;
+		uint32_t _lastNumCommands = 0;
+		uint32_t _lastNumUniformUpdates = 0;
+
+		uint32_t _initialCapacity;
+		uint32_t _commandsHighWater = 0;
+		uint32_t _verticesHighWater = 0;
+		uint32_t _framesSinceTrim = 0;
 	};
 
 }// namespace spine
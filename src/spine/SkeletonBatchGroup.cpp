@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/spine-axmol.h>
+
+USING_NS_AX;
+
+namespace spine {
+
+	void SkeletonBatchGroup::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) {
+		if (!_visible) return;
+
+		uint32_t flags = processParentFlags(parentTransform, parentFlags);
+		_director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+		_director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+
+		// Children are visited in order once, so each one only checks the last command of the children drawn before it.
+		sortAllChildren();
+		_pendingCommand = nullptr;
+		_visiting = true;
+		for (ssize_t i = 0, n = _children.size(); i < n; ++i) {
+			Node *child = _children.at(i);
+			if (!child->isVisible()) continue;
+			if (_pendingCommand && !continuesBatch(child)) flushPending(renderer);
+			child->visit(renderer, _modelViewTransform, flags);
+		}
+		flushPending(renderer);
+		_visiting = false;
+
+		_director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+	}
+
+	bool SkeletonBatchGroup::continuesBatch(Node *child) const {
+		SkeletonRenderer *skeleton = dynamic_cast<SkeletonRenderer *>(child);
+		return skeleton && skeleton->isTwoColorTint() && skeleton->getChildrenCount() == 0 &&
+			   skeleton->getGlobalZOrder() == _pendingCommand->getGlobalOrder();
+	}
+
+	void SkeletonBatchGroup::flushPending(Renderer *renderer) {
+		if (_pendingCommand) SkeletonTwoColorBatch::getInstance()->flush(renderer);
+		_pendingCommand = nullptr;
+	}
+
+}// namespace spine
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef SPINE_SKELETONBATCHGROUP_H_
+#define SPINE_SKELETONBATCHGROUP_H_
+
+#include "axmol.h"
+
+namespace spine {
+
+	class TwoColorTrianglesCommand;
+
+	/* A container node whose two color tinted skeleton children are drawn with one command per run of the same texture,
+	 * blend function and program state, across skeletons, in draw order. SkeletonTwoColorBatch appends the triangles of a run into
+	 * one vertex and index buffer, uploaded once when the run ends. Other children, skeletons with children of their own or
+	 * debug drawing, and a change of global z order end a run. Skeletons outside a group are never batched with each other.
+	 * The group draws nothing itself. SkeletonTwoColorBatch::getNumBatches() gives the commands of the last frame. */
+	class SP_API SkeletonBatchGroup : public axmol::Node {
+	public:
+		CREATE_FUNC(SkeletonBatchGroup);
+
+		void visit(axmol::Renderer *renderer, const axmol::Mat4 &parentTransform, uint32_t parentFlags) override;
+
+	protected:
+		friend class SkeletonRenderer;
+
+		/* Whether the child's triangles may be appended to the pending command. */
+		bool continuesBatch(axmol::Node *child) const;
+		void flushPending(axmol::Renderer *renderer);
+
+		/* The open run's command after the last child drawn, flushed once a child that doesn't continue it is reached. */
+		TwoColorTrianglesCommand *_pendingCommand = nullptr;
+		/* Children drawn outside of the group's visit, e.g. into a render texture, flush their own commands. */
+		bool _visiting = false;
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONBATCHGROUP_H_ */
@@ -28,6 +28,8 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <spine/Extension.h>
 #include <spine/spine-axmol.h>
 
@@ -38,13 +40,9 @@ namespace spine {
 	namespace {
 		AxmolTextureLoader textureLoader;
 
-		int computeTotalCoordCount(Skeleton &skeleton, int startSlotIndex, int endSlotIndex);
-		axmol::Rect computeBoundingRect(const float *coords, int vertexCount);
-		void interleaveCoordinates(float *dst, const float *src, int vertexCount, int dstStride);
 		BlendFunc makeBlendFunc(BlendMode blendMode, bool premultipliedAlpha);
-		void transformWorldVertices(float *dstCoord, int coordCount, Skeleton &skeleton, int startSlotIndex, int endSlotIndex);
+		float computeLodError(const Mat4 &transform, Skeleton &skeleton, float tolerance);
 		bool cullRectangle(Renderer *renderer, const Mat4 &transform, const axmol::Rect &rect);
-		Color4B ColorToColor4B(const Color &color);
 		bool slotIsOutRange(Slot &slot, int startSlotIndex, int endSlotIndex);
 		bool nothingToDraw(Slot &slot, int startSlotIndex, int endSlotIndex);
 	}// namespace
@@ -86,8 +84,22 @@ namespace spine {
 		return node;
 	}
 
+	SkeletonRenderer *SkeletonRenderer::createWithAsset(const std::shared_ptr<SkeletonAsset> &asset) {
+		SkeletonRenderer *node = new SkeletonRenderer();
+		node->initWithAsset(asset);
+		node->autorelease();
+		return node;
+	}
+
+	SkeletonRenderer *SkeletonRenderer::createWithPrototype(SkeletonRenderer *prototype) {
+		SkeletonRenderer *node = new SkeletonRenderer();
+		node->initWithPrototype(prototype);
+		node->autorelease();
+		return node;
+	}
+
 	void SkeletonRenderer::initialize() {
-		_clipper = new (__FILE__, __LINE__) SkeletonClipping();
+		_renderBuilder = new (__FILE__, __LINE__) RenderCommandBuilder();
 
 		_blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
 		setOpacityModifyRGB(true);
@@ -135,7 +147,8 @@ namespace spine {
 		if (_ownsSkeleton) delete _skeleton;
 		if (_ownsAtlas && _atlas) delete _atlas;
 		if (_attachmentLoader) delete _attachmentLoader;
-		delete _clipper;
+		delete _renderBuilder;
+		if (_picker) delete _picker;
 	}
 
 	void SkeletonRenderer::initWithSkeleton(Skeleton *skeleton, bool ownsSkeleton, bool ownsSkeletonData, bool ownsAtlas) {
@@ -216,301 +229,231 @@ namespace spine {
 		initialize();
 	}
 
+	void SkeletonRenderer::initWithAsset(const std::shared_ptr<SkeletonAsset> &asset) {
+		AXASSERT(asset, "asset cannot be null.");
+		_asset = asset;
+		_atlas = asset->getAtlas();
+
+		_ownsSkeleton = true;
+		setSkeletonData(asset->getSkeletonData(), false);
+
+		initialize();
+	}
+
+	void SkeletonRenderer::initWithPrototype(SkeletonRenderer *prototype) {
+		AXASSERT(prototype, "prototype cannot be null.");
+		_asset = prototype->_asset;
+		_atlas = prototype->_atlas;
+
+		_ownsSkeleton = true;
+		_ownsSkeletonData = false;
+		_skeleton = prototype->_skeleton->copy();
+
+		_renderBuilder = new (__FILE__, __LINE__) RenderCommandBuilder();
+		copySettings(prototype);
+	}
+
+	void SkeletonRenderer::cloneFrom(SkeletonRenderer *prototype) {
+		AXASSERT(prototype, "prototype cannot be null.");
+		_skeleton->copyFrom(*prototype->_skeleton);
+		copySettings(prototype);
+	}
+
+	void SkeletonRenderer::copySettings(SkeletonRenderer *prototype) {
+		_blendFunc = prototype->_blendFunc;
+		setOpacityModifyRGB(prototype->_premultipliedAlpha);
+		setTwoColorTint(prototype->_twoColorTint);
+		_timeScale = prototype->_timeScale;
+		_debugSlots = prototype->_debugSlots;
+		_debugBones = prototype->_debugBones;
+		_debugMeshes = prototype->_debugMeshes;
+		_debugBoundingRect = prototype->_debugBoundingRect;
+		_startSlotIndex = prototype->_startSlotIndex;
+		_endSlotIndex = prototype->_endSlotIndex;
+		_lodTolerance = prototype->_lodTolerance;
+		setPickingEnabled(prototype->isPickingEnabled());
+		_worldCoordsVersion = 0;
+	}
 
 	void SkeletonRenderer::update(float deltaTime) {
 		Node::update(deltaTime);
 	}
 
 	void SkeletonRenderer::draw(Renderer *renderer, const Mat4 &transform, uint32_t transformFlags) {
+		if (_picker) _picker->clear();
+
 		// Early exit if the skeleton is invisible.
 		if (getDisplayedOpacity() == 0 || _skeleton->getColor().a == 0) {
 			return;
 		}
 
-		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
-		if (coordCount == 0) {
+		const float lodError = computeLodError(transform, *_skeleton, _lodTolerance);
+		updateWorldCoords(lodError);
+		if (_worldCoords.size() == 0) {
 			return;
 		}
-		assert(coordCount % 2 == 0);
-
-		VLA(float, worldCoords, coordCount);
-		transformWorldVertices(worldCoords, coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
 
 #if AX_USE_CULLING
-		const axmol::Rect bb = computeBoundingRect(worldCoords, coordCount / 2);
-
-		if (cullRectangle(renderer, transform, bb)) {
-			VLA_FREE(worldCoords);
+		if (cullRectangle(renderer, transform, SkeletonRenderer::getBoundingBox())) {
 			return;
 		}
 #endif
 
-		const float *worldCoordPtr = worldCoords;
 		SkeletonBatch *batch = SkeletonBatch::getInstance();
 		SkeletonTwoColorBatch *twoColorBatch = SkeletonTwoColorBatch::getInstance();
 		const bool hasSingleTint = (isTwoColorTint() == false);
 
 		const Color3B displayedColor = getDisplayedColor();
-		Color nodeColor;
-		nodeColor.r = displayedColor.r / 255.f;
-		nodeColor.g = displayedColor.g / 255.f;
-		nodeColor.b = displayedColor.b / 255.f;
-		nodeColor.a = getDisplayedOpacity() / 255.f;
-
-		Color color;
-		Color darkColor;
-		const float darkPremultipliedAlpha = _premultipliedAlpha ? 1.f : 0;
+		_renderBuilder->getColor().set(displayedColor.r / 255.f, displayedColor.g / 255.f, displayedColor.b / 255.f, getDisplayedOpacity() / 255.f);
+		_renderBuilder->setPremultipliedAlpha(_premultipliedAlpha);
+		_renderBuilder->setDarkColors(!hasSingleTint);
+		_renderBuilder->setSlotsRange(_startSlotIndex, _endSlotIndex);
+		// SkeletonTwoColorBatch holds fewer than 64000 vertices and indices at a time.
+		const int maxBatchSize = hasSingleTint ? 65535 : 63999;
+		_renderBuilder->setMaxBatchSize(maxBatchSize, maxBatchSize);
+		_renderBuffer.clear();
+		_renderBuilder->build(*_skeleton, _renderBuffer, lodError, _worldCoords.buffer(), _slotCoordOffsets.buffer());
+
+		const float *positions = _renderBuffer.positions.buffer();
+		const float *uvs = _renderBuffer.uvs.buffer();
+		const unsigned int *colors = _renderBuffer.colors.buffer();
+		const unsigned int *darkColors = _renderBuffer.darkColors.buffer();
 		TwoColorTrianglesCommand *lastTwoColorTrianglesCommand = nullptr;
-		for (int i = 0, n = (int)_skeleton->getSlots().size(); i < n; ++i) {
-			Slot *slot = _skeleton->getDrawOrder()[i];
-
-			if (nothingToDraw(*slot, _startSlotIndex, _endSlotIndex)) {
-				_clipper->clipEnd(*slot);
-				continue;
-			}
-
-			axmol::TrianglesCommand::Triangles triangles;
-			TwoColorTriangles trianglesTwoColor;
-            static unsigned short quadIndices[6] = {0, 1, 2, 2, 3, 0};
-            Texture2D *texture = nullptr;
-
-			if (slot->getAttachment()->getRTTI().isExactly(RegionAttachment::rtti)) {
-				RegionAttachment *attachment = static_cast<RegionAttachment *>(slot->getAttachment());
-				texture = (Texture2D*)((AtlasRegion*)attachment->getRegion())->page->texture;
-
-				float *dstTriangleVertices = nullptr;
-				int dstStride = 0;// in floats
-				if (hasSingleTint) {
-					triangles.indices = quadIndices;
-					triangles.indexCount = 6;
-					triangles.verts = batch->allocateVertices(4);
-					triangles.vertCount = 4;
-					assert(triangles.vertCount == 4);
-                    for (int v = 0, i = 0; v < triangles.vertCount; v++, i += 2) {
-                        auto &texCoords = triangles.verts[v].texCoords;
-                        texCoords.u = attachment->getUVs()[i];
-                        texCoords.v = attachment->getUVs()[i + 1];
-                    }
-					dstStride = sizeof(V3F_C4B_T2F) / sizeof(float);
-					dstTriangleVertices = reinterpret_cast<float *>(triangles.verts);
-				} else {
-					trianglesTwoColor.indices = quadIndices;
-					trianglesTwoColor.indexCount = 6;
-					trianglesTwoColor.verts = twoColorBatch->allocateVertices(4);
-					trianglesTwoColor.vertCount = 4;
-					assert(trianglesTwoColor.vertCount == 4);
-                    for (int v = 0, i = 0; v < trianglesTwoColor.vertCount; v++, i += 2) {
-                        auto &texCoords = trianglesTwoColor.verts[v].texCoords;
-                        texCoords.u = attachment->getUVs()[i];
-                        texCoords.v = attachment->getUVs()[i + 1];
-                    }
-					dstTriangleVertices = reinterpret_cast<float *>(trianglesTwoColor.verts);
-					dstStride = sizeof(V3F_C4B_C4B_T2F) / sizeof(float);
-				}
-				// Copy world vertices to triangle vertices.
-				interleaveCoordinates(dstTriangleVertices, worldCoordPtr, 4, dstStride);
-				worldCoordPtr += 8;
-
-				color = attachment->getColor();
-			} else if (slot->getAttachment()->getRTTI().isExactly(MeshAttachment::rtti)) {
-				MeshAttachment *attachment = (MeshAttachment *) slot->getAttachment();
-				texture = (Texture2D*)((AtlasRegion*)attachment->getRegion())->page->texture;
-
-				float *dstTriangleVertices = nullptr;
-				int dstStride = 0;// in floats
-				int dstVertexCount = 0;
-				if (hasSingleTint) {
-					triangles.indices = attachment->getTriangles().buffer();
-					triangles.indexCount = (unsigned short)attachment->getTriangles().size();
-					triangles.verts = batch->allocateVertices((int)attachment->getWorldVerticesLength() / 2);
-					triangles.vertCount = (int)attachment->getWorldVerticesLength() / 2;
-                    for (int v = 0, i = 0; v < triangles.vertCount; v++, i += 2) {
-                        auto &texCoords = triangles.verts[v].texCoords;
-                        texCoords.u = attachment->getUVs()[i];
-                        texCoords.v = attachment->getUVs()[i + 1];
-                    }
-					dstTriangleVertices = (float *) triangles.verts;
-					dstStride = sizeof(V3F_C4B_T2F) / sizeof(float);
-					dstVertexCount = triangles.vertCount;
-				} else {
-					trianglesTwoColor.indices = attachment->getTriangles().buffer();
-					trianglesTwoColor.indexCount = (unsigned short)attachment->getTriangles().size();
-					trianglesTwoColor.verts = twoColorBatch->allocateVertices((int)attachment->getWorldVerticesLength() / 2);
-					trianglesTwoColor.vertCount = (int)attachment->getWorldVerticesLength() / 2;
-                    for (int v = 0, i = 0; v < trianglesTwoColor.vertCount; v++, i += 2) {
-                        auto &texCoords = trianglesTwoColor.verts[v].texCoords;
-                        texCoords.u = attachment->getUVs()[i];
-                        texCoords.v = attachment->getUVs()[i + 1];
-                    }
-					dstTriangleVertices = (float *) trianglesTwoColor.verts;
-					dstStride = sizeof(V3F_C4B_C4B_T2F) / sizeof(float);
-					dstVertexCount = trianglesTwoColor.vertCount;
-				}
-
-				// Copy world vertices to triangle vertices.
-				//assert(dstVertexCount * 2 == attachment->super.worldVerticesLength);
-				interleaveCoordinates(dstTriangleVertices, worldCoordPtr, dstVertexCount, dstStride);
-				worldCoordPtr += dstVertexCount * 2;
-
-				color = attachment->getColor();
-			} else if (slot->getAttachment()->getRTTI().isExactly(ClippingAttachment::rtti)) {
-				ClippingAttachment *clip = (ClippingAttachment *) slot->getAttachment();
-				_clipper->clipStart(*slot, clip);
-				continue;
-			} else {
-				_clipper->clipEnd(*slot);
-				continue;
-			}
-
-			if (slot->hasDarkColor()) {
-				darkColor = slot->getDarkColor();
-			} else {
-				darkColor.r = 0;
-				darkColor.g = 0;
-				darkColor.b = 0;
-			}
-			darkColor.a = darkPremultipliedAlpha;
-
-			color.a *= nodeColor.a * _skeleton->getColor().a * slot->getColor().a;
-			if (color.a == 0) {
-				_clipper->clipEnd(*slot);
-				continue;
-			}
-			color.r *= nodeColor.r * _skeleton->getColor().r * slot->getColor().r;
-			color.g *= nodeColor.g * _skeleton->getColor().g * slot->getColor().g;
-			color.b *= nodeColor.b * _skeleton->getColor().b * slot->getColor().b;
-			if (_premultipliedAlpha) {
-				color.r *= color.a;
-				color.g *= color.a;
-				color.b *= color.a;
-			}
-
-			const axmol::Color4B color4B = ColorToColor4B(color);
-			const axmol::Color4B darkColor4B = ColorToColor4B(darkColor);
-			const BlendFunc blendFunc = makeBlendFunc(slot->getData().getBlendMode(), texture->hasPremultipliedAlpha());
+		for (size_t i = 0, n = _renderBuffer.batches.size(); i < n; ++i) {
+			const RenderBatch &renderBatch = _renderBuffer.batches[i];
+			Texture2D *texture = (Texture2D *) renderBatch.texture;
+			const BlendFunc blendFunc = makeBlendFunc(renderBatch.blendMode, texture->hasPremultipliedAlpha());
 			_blendFunc = blendFunc;
 
+			const int first = renderBatch.vertexStart;
 			if (hasSingleTint) {
-				if (_clipper->isClipping()) {
-					_clipper->clipTriangles((float *) &triangles.verts[0].vertices, triangles.indices, triangles.indexCount, (float *) &triangles.verts[0].texCoords, sizeof(axmol::V3F_C4B_T2F) / 4);
-					batch->deallocateVertices(triangles.vertCount);
-
-					if (_clipper->getClippedTriangles().size() == 0) {
-						_clipper->clipEnd(*slot);
-						continue;
-					}
-
-					triangles.vertCount = (int)_clipper->getClippedVertices().size() / 2;
-					triangles.verts = batch->allocateVertices(triangles.vertCount);
-					triangles.indexCount = (int)_clipper->getClippedTriangles().size();
-					triangles.indices = batch->allocateIndices(triangles.indexCount);
-					memcpy(triangles.indices, _clipper->getClippedTriangles().buffer(), sizeof(unsigned short) * _clipper->getClippedTriangles().size());
-
-					axmol::TrianglesCommand *batchedTriangles = batch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, triangles, transform, transformFlags);
-
-					const float *verts = _clipper->getClippedVertices().buffer();
-					const float *uvs = _clipper->getClippedUVs().buffer();
-                    V3F_C4B_T2F *vertex = batchedTriangles->getTriangles().verts;
-                    for (int v = 0, vn = batchedTriangles->getTriangles().vertCount, vv = 0; v < vn; ++v, vv += 2, ++vertex) {
-                        vertex->vertices.x = verts[vv];
-                        vertex->vertices.y = verts[vv + 1];
-                        vertex->texCoords.u = uvs[vv];
-                        vertex->texCoords.v = uvs[vv + 1];
-                        vertex->colors = color4B;
-                    }
-				} else {
-					// Not clipping.
-					axmol::TrianglesCommand *batchedTriangles = batch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, triangles, transform, transformFlags);
-                    V3F_C4B_T2F *vertex = batchedTriangles->getTriangles().verts;
-                    for (int v = 0, vn = batchedTriangles->getTriangles().vertCount; v < vn; ++v, ++vertex) {
-                        vertex->colors = color4B;
-                    }
+				axmol::TrianglesCommand::Triangles triangles;
+				triangles.vertCount = renderBatch.vertexCount;
+				triangles.verts = batch->allocateVertices(triangles.vertCount);
+				triangles.indexCount = renderBatch.indexCount;
+				triangles.indices = batch->allocateIndices(triangles.indexCount);
+				memcpy(triangles.indices, _renderBuffer.indices.buffer() + renderBatch.indexStart, sizeof(unsigned short) * triangles.indexCount);
+				V3F_C4B_T2F *vertex = triangles.verts;
+				for (int v = first, vn = first + triangles.vertCount; v < vn; ++v, ++vertex) {
+					vertex->vertices.x = positions[v * 2];
+					vertex->vertices.y = positions[v * 2 + 1];
+					vertex->texCoords.u = uvs[v * 2];
+					vertex->texCoords.v = uvs[v * 2 + 1];
+					memcpy(&vertex->colors, colors + v, sizeof(Color4B));
 				}
+				batch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, triangles, transform, transformFlags);
 			} else {
-				// Two color tinting.
-
-				if (_clipper->isClipping()) {
-					_clipper->clipTriangles((float *) &trianglesTwoColor.verts[0].position, trianglesTwoColor.indices, trianglesTwoColor.indexCount, (float *) &trianglesTwoColor.verts[0].texCoords, sizeof(V3F_C4B_C4B_T2F) / 4);
-					twoColorBatch->deallocateVertices(trianglesTwoColor.vertCount);
-
-					if (_clipper->getClippedTriangles().size() == 0) {
-						_clipper->clipEnd(*slot);
-						continue;
-					}
-
-					trianglesTwoColor.vertCount = (int)_clipper->getClippedVertices().size() / 2;
-					trianglesTwoColor.verts = twoColorBatch->allocateVertices(trianglesTwoColor.vertCount);
-					trianglesTwoColor.indexCount = (int)_clipper->getClippedTriangles().size();
-					trianglesTwoColor.indices = twoColorBatch->allocateIndices(trianglesTwoColor.indexCount);
-					memcpy(trianglesTwoColor.indices, _clipper->getClippedTriangles().buffer(), sizeof(unsigned short) * _clipper->getClippedTriangles().size());
-
-					TwoColorTrianglesCommand *batchedTriangles = lastTwoColorTrianglesCommand = twoColorBatch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, trianglesTwoColor, transform, transformFlags);
-
-					const float *verts = _clipper->getClippedVertices().buffer();
-					const float *uvs = _clipper->getClippedUVs().buffer();
-
-                    V3F_C4B_C4B_T2F *vertex = batchedTriangles->getTriangles().verts;
-                    for (int v = 0, vn = batchedTriangles->getTriangles().vertCount, vv = 0; v < vn; ++v, vv += 2, ++vertex) {
-                        vertex->position.x = verts[vv];
-                        vertex->position.y = verts[vv + 1];
-                        vertex->texCoords.u = uvs[vv];
-                        vertex->texCoords.v = uvs[vv + 1];
-                        vertex->color = color4B;
-                        vertex->color2 = darkColor4B;
-                    }
-				} else {
-					TwoColorTrianglesCommand *batchedTriangles = lastTwoColorTrianglesCommand = twoColorBatch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, trianglesTwoColor, transform, transformFlags);
-
-                    V3F_C4B_C4B_T2F *vertex = batchedTriangles->getTriangles().verts;
-                    for (int v = 0, vn = batchedTriangles->getTriangles().vertCount; v < vn; ++v, ++vertex) {
-                        vertex->color = color4B;
-                        vertex->color2 = darkColor4B;
-                    }
+				TwoColorTriangles trianglesTwoColor;
+				trianglesTwoColor.vertCount = renderBatch.vertexCount;
+				trianglesTwoColor.verts = twoColorBatch->allocateVertices(trianglesTwoColor.vertCount);
+				trianglesTwoColor.indexCount = renderBatch.indexCount;
+				trianglesTwoColor.indices = twoColorBatch->allocateIndices(trianglesTwoColor.indexCount);
+				memcpy(trianglesTwoColor.indices, _renderBuffer.indices.buffer() + renderBatch.indexStart, sizeof(unsigned short) * trianglesTwoColor.indexCount);
+				// Two color vertices are transformed by the node here, so SkeletonTwoColorBatch can append them to a command of
+				// another node, drawn with only the projection.
+				const float *m = transform.m;
+				V3F_C4B_C4B_T2F *vertex = trianglesTwoColor.verts;
+				for (int v = first, vn = first + trianglesTwoColor.vertCount; v < vn; ++v, ++vertex) {
+					const float x = positions[v * 2], y = positions[v * 2 + 1];
+					vertex->position.x = m[0] * x + m[4] * y + m[12];
+					vertex->position.y = m[1] * x + m[5] * y + m[13];
+					vertex->position.z = m[2] * x + m[6] * y + m[14];
+					vertex->texCoords.u = uvs[v * 2];
+					vertex->texCoords.v = uvs[v * 2 + 1];
+					memcpy(&vertex->color, colors + v, sizeof(Color4B));
+					memcpy(&vertex->color2, darkColors + v, sizeof(Color4B));
 				}
+				lastTwoColorTrianglesCommand = twoColorBatch->addCommand(renderer, _globalZOrder, texture, _programState, blendFunc, trianglesTwoColor, transform, transformFlags);
 			}
-			_clipper->clipEnd(*slot);
 		}
-		_clipper->clipEnd();
 
-		if (lastTwoColorTrianglesCommand) {
-			Node *parent = this->getParent();
-
-			// We need to decide if we can postpone flushing the current batch. We can postpone if the next sibling node is a two color
-			// tinted skeleton with the same global-z.
-			// The parent->getChildrenCount() > 100 check is a hack as checking for a sibling is an O(n) operation, and if all children
-			// of this nodes parent are skeletons, we are in O(n2) territory.
-			if (!parent || parent->getChildrenCount() > 100 || getChildrenCount() != 0) {
-				lastTwoColorTrianglesCommand->setForceFlush(true);
-			} else {
-				const axmol::Vector<Node *> &children = parent->getChildren();
-				Node *sibling = nullptr;
-				for (ssize_t i = 0; i < children.size(); i++) {
-					if (children.at(i) == this) {
-						if (i < children.size() - 1) {
-							sibling = children.at(i + 1);
-							break;
-						}
-					}
-				}
-				if (!sibling) {
-					lastTwoColorTrianglesCommand->setForceFlush(true);
-				} else {
-					SkeletonRenderer *siblingSkeleton = dynamic_cast<SkeletonRenderer *>(sibling);
-					if (!siblingSkeleton ||                                               // flush is next sibling isn't a SkeletonRenderer
-						!siblingSkeleton->isTwoColorTint() ||                             // flush if next sibling isn't two color tinted
-						!siblingSkeleton->isVisible() ||                                  // flush if next sibling is two color tinted but not visible
-						(siblingSkeleton->getGlobalZOrder() != this->getGlobalZOrder())) {// flush if next sibling is two color tinted but z-order differs
-						lastTwoColorTrianglesCommand->setForceFlush(true);
-					}
-				}
+		// The builder's vertices are clipped and in node coordinates.
+		if (_picker) {
+			for (size_t i = 0, n = _renderBuffer.slots.size(); i < n; ++i) {
+				const RenderSlot &renderSlot = _renderBuffer.slots[i];
+				_picker->addTriangles(renderSlot.slot, positions + renderSlot.vertexStart * 2, renderSlot.vertexCount, 2,
+									  _renderBuffer.indices.buffer() + renderSlot.indexStart, renderSlot.indexCount,
+									  renderSlot.vertexStart - _renderBuffer.batches[renderSlot.batch].vertexStart);
 			}
 		}
 
-		if (_debugBoundingRect || _debugSlots || _debugBones || _debugMeshes) {
+		const bool drawsDebug = _debugBoundingRect || _debugSlots || _debugBones || _debugMeshes;
+		if (lastTwoColorTrianglesCommand) {
+			// In a SkeletonBatchGroup the next child's triangles may be appended to the run, the group flushes it when they
+			// can't. Commands of this node's children or of debug drawing come next, so they end it.
+			SkeletonBatchGroup *group = getChildrenCount() == 0 && !drawsDebug ? dynamic_cast<SkeletonBatchGroup *>(getParent()) : nullptr;
+			if (group && group->_visiting)
+				group->_pendingCommand = lastTwoColorTrianglesCommand;
+			else
+				twoColorBatch->flush(renderer);
+		}
+
+		if (drawsDebug) {
 			drawDebug(renderer, transform, transformFlags);
 		}
+	}
+
+	void SkeletonRenderer::updateWorldCoords(float lodError) const {
+		if (_worldCoordsVersion == _skeleton->getPoseVersion() && _worldCoordsLodError == lodError) return;
+		_worldCoordsVersion = _skeleton->getPoseVersion();
+		_worldCoordsLodError = lodError;
+		_boundingRectValid = false;
 
-		VLA_FREE(worldCoords);
+		// Slots get vertices whatever their color, so a color change doesn't invalidate the offsets.
+		Vector<Slot *> &slots = _skeleton->getSlots();
+		_slotCoordOffsets.setSize(slots.size(), -1);
+		int coordCount = 0;
+		for (size_t i = 0, n = slots.size(); i < n; ++i) {
+			Slot &slot = *slots[i];
+			Attachment *attachment = slot.getAttachment();
+			_slotCoordOffsets[i] = -1;
+			if (!attachment || slotIsOutRange(slot, _startSlotIndex, _endSlotIndex) || !slot.getBone().isActive()) continue;
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+				_slotCoordOffsets[i] = coordCount;
+				coordCount += 8;
+			} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				_slotCoordOffsets[i] = coordCount;
+				coordCount += (int) static_cast<MeshAttachment *>(attachment)->getLod(lodError)->getWorldVerticesLength();
+			}
+		}
+
+		// Growing keeps the values, so slots whose bones, deform and attachment did not change keep their vertices.
+		_worldCoords.setSizeUninitialized(coordCount);
+		_slotCoordKeys.setSize(slots.size(), SlotCoordsKey());
+		for (size_t i = 0, n = slots.size(); i < n; ++i) {
+			SlotCoordsKey &key = _slotCoordKeys[i];
+			const int offset = _slotCoordOffsets[i];
+			if (offset == -1) {
+				key.attachment = nullptr;
+				continue;
+			}
+			Slot &slot = *slots[i];
+			float *coords = _worldCoords.buffer() + offset;
+			Attachment *attachment = slot.getAttachment();
+			unsigned int bonesVersion, deformVersion = 0;
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti))
+				bonesVersion = slot.getBone().getWorldVersion();
+			else {
+				attachment = static_cast<MeshAttachment *>(attachment)->getLod(lodError);
+				bonesVersion = static_cast<MeshAttachment *>(attachment)->getBonesVersion(slot);
+				deformVersion = slot.getDeformVersion();
+			}
+			if (key.attachment == attachment && key.offset == offset && key.sequenceIndex == slot.getSequenceIndex() &&
+				key.bonesVersion == bonesVersion && key.deformVersion == deformVersion)
+				continue;
+			key.attachment = attachment;
+			key.offset = offset;
+			key.sequenceIndex = slot.getSequenceIndex();
+			key.bonesVersion = bonesVersion;
+			key.deformVersion = deformVersion;
+
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti))
+				static_cast<RegionAttachment *>(attachment)->computeWorldVertices(slot, coords, 0, 2);
+			else {
+				MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+				mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), coords, 0, 2);
+			}
+		}
 	}
 
 
@@ -619,13 +562,40 @@ namespace spine {
 	}
 
 	axmol::Rect SkeletonRenderer::getBoundingBox() const {
-		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
-		if (coordCount == 0) return {0, 0, 0, 0};
-		VLA(float, worldCoords, coordCount);
-		transformWorldVertices(worldCoords, coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
-		const axmol::Rect bb = computeBoundingRect(worldCoords, coordCount / 2);
-		VLA_FREE(worldCoords);
-		return bb;
+		updateWorldCoords(_worldCoordsLodError);
+
+		// Slot and attachment colors are written directly, without changing the pose version, so which slots are visible is
+		// checked on every call. This is much cheaper than going through their vertices again.
+		Vector<Slot *> &slots = _skeleton->getSlots();
+		_boundingRectVisible.setSize(slots.size(), false);
+		for (size_t i = 0, n = slots.size(); i < n; ++i) {
+			bool visible = _slotCoordOffsets[i] != -1 && !nothingToDraw(*slots[i], _startSlotIndex, _endSlotIndex);
+			if (_boundingRectVisible[i] == visible) continue;
+			_boundingRectVisible[i] = visible;
+			_boundingRectValid = false;
+		}
+		if (_boundingRectValid) return _boundingRect;
+		_boundingRectValid = true;
+
+		float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+		for (size_t i = 0, n = slots.size(); i < n; ++i) {
+			Slot &slot = *slots[i];
+			if (!_boundingRectVisible[i]) continue;
+			Attachment *attachment = slot.getAttachment();
+			const float *coords = _worldCoords.buffer() + _slotCoordOffsets[i];
+			const float *end = coords + (attachment->getRTTI().isExactly(RegionAttachment::rtti) ? 8 : static_cast<MeshAttachment *>(attachment)->getLod(_worldCoordsLodError)->getWorldVerticesLength());
+			for (; coords < end; coords += 2) {
+				minX = std::min(minX, coords[0]);
+				minY = std::min(minY, coords[1]);
+				maxX = std::max(maxX, coords[0]);
+				maxY = std::max(maxY, coords[1]);
+			}
+		}
+		if (minX > maxX)
+			_boundingRect = {0, 0, 0, 0};
+		else
+			_boundingRect = {minX, minY, maxX - minX, maxY - minY};
+		return _boundingRect;
 	}
 
 	// --- Convenience methods for Skeleton_* functions.
@@ -682,9 +652,36 @@ namespace spine {
 		return _twoColorTint;
 	}
 
+	void SkeletonRenderer::setLodTolerance(float pixels) {
+		_lodTolerance = pixels;
+	}
+
+	float SkeletonRenderer::getLodTolerance() const {
+		return _lodTolerance;
+	}
+
+	void SkeletonRenderer::setPickingEnabled(bool enabled) {
+		if (enabled && !_picker)
+			_picker = new (__FILE__, __LINE__) SkeletonPicker();
+		else if (!enabled && _picker) {
+			delete _picker;
+			_picker = nullptr;
+		}
+	}
+
+	bool SkeletonRenderer::isPickingEnabled() const {
+		return _picker != nullptr;
+	}
+
+	Slot *SkeletonRenderer::pickSlot(const Vec2 &point) {
+		if (!_picker || !isVisible()) return nullptr;
+		return _picker->pick(point.x, point.y);
+	}
+
 	void SkeletonRenderer::setSlotsRange(int startSlotIndex, int endSlotIndex) {
 		_startSlotIndex = startSlotIndex == -1 ? 0 : startSlotIndex;
 		_endSlotIndex = endSlotIndex == -1 ? std::numeric_limits<int>::max() : endSlotIndex;
+		_worldCoordsVersion = 0;
 	}
 
 	Skeleton *SkeletonRenderer::getSkeleton() const {
@@ -756,27 +753,6 @@ namespace spine {
 	}
 
 	namespace {
-		axmol::Rect computeBoundingRect(const float *coords, int vertexCount) {
-			assert(coords);
-			assert(vertexCount > 0);
-
-			const float *v = coords;
-			float minX = v[0];
-			float minY = v[1];
-			float maxX = minX;
-			float maxY = minY;
-			for (int i = 1; i < vertexCount; ++i) {
-				v += 2;
-				float x = v[0];
-				float y = v[1];
-				minX = std::min(minX, x);
-				minY = std::min(minY, y);
-				maxX = std::max(maxX, x);
-				maxY = std::max(maxY, y);
-			}
-			return {minX, minY, maxX - minX, maxY - minY};
-		}
-
 		bool slotIsOutRange(Slot &slot, int startSlotIndex, int endSlotIndex) {
 			const int index = slot.getData().getIndex();
 			return startSlotIndex > index || endSlotIndex < index;
@@ -803,62 +779,12 @@ namespace spine {
 			return false;
 		}
 
-		int computeTotalCoordCount(Skeleton &skeleton, int startSlotIndex, int endSlotIndex) {
-			int coordCount = 0;
-			for (size_t i = 0; i < skeleton.getSlots().size(); ++i) {
-				Slot &slot = *skeleton.getSlots()[i];
-				if (nothingToDraw(slot, startSlotIndex, endSlotIndex)) {
-					continue;
-				}
-				Attachment *const attachment = slot.getAttachment();
-				if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
-					coordCount += 8;
-				} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
-					MeshAttachment *const mesh = static_cast<MeshAttachment *>(attachment);
-					coordCount += mesh->getWorldVerticesLength();
-				}
-			}
-			return coordCount;
-		}
-
-
-		void transformWorldVertices(float *dstCoord, int coordCount, Skeleton &skeleton, int startSlotIndex, int endSlotIndex) {
-			float *dstPtr = dstCoord;
-#ifndef NDEBUG
-			float *const dstEnd = dstCoord + coordCount;
-#endif
-			for (size_t i = 0; i < skeleton.getSlots().size(); ++i) {
-				/*const*/ Slot &slot = *skeleton.getDrawOrder()[i];// match the draw order of SkeletonRenderer::Draw
-				if (nothingToDraw(slot, startSlotIndex, endSlotIndex)) {
-					continue;
-				}
-				Attachment *const attachment = slot.getAttachment();
-				if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
-					RegionAttachment *const regionAttachment = static_cast<RegionAttachment *>(attachment);
-					assert(dstPtr + 8 <= dstEnd);
-					regionAttachment->computeWorldVertices(slot, dstPtr, 0, 2);
-					dstPtr += 8;
-				} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
-					MeshAttachment *const mesh = static_cast<MeshAttachment *>(attachment);
-					assert(dstPtr + mesh->getWorldVerticesLength() <= dstEnd);
-					mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), dstPtr, 0, 2);
-					dstPtr += mesh->getWorldVerticesLength();
-				}
-			}
-			assert(dstPtr == dstEnd);
-		}
-
-		void interleaveCoordinates(float *dst, const float *src, int count, int dstStride) {
-			if (dstStride == 2) {
-				memcpy(dst, src, sizeof(float) * count * 2);
-			} else {
-				for (int i = 0; i < count; ++i) {
-					dst[0] = src[0];
-					dst[1] = src[1];
-					dst += dstStride;
-					src += 2;
-				}
-			}
+		// The largest error in skeleton units that stays within the tolerance in pixels once drawn with the transform.
+		float computeLodError(const Mat4 &transform, Skeleton &skeleton, float tolerance) {
+			if (tolerance <= 0) return 0;
+			const float scale = std::sqrt(std::abs((transform.m[0] * transform.m[5] - transform.m[1] * transform.m[4]) *
+												   skeleton.getScaleX() * skeleton.getScaleY()));
+			return scale > 0 ? tolerance / scale : 0;
 		}
 
 		BlendFunc makeBlendFunc(BlendMode blendMode, bool premultipliedAlpha) {
@@ -914,11 +840,6 @@ namespace spine {
 			visibleRect.size.height += wshh * 2;
 			return !visibleRect.containsPoint(v2p);
 		}
-
-
-		Color4B ColorToColor4B(const Color &color) {
-			return {(uint8_t) (color.r * 255.f), (uint8_t) (color.g * 255.f), (uint8_t) (color.b * 255.f), (uint8_t) (color.a * 255.f)};
-		}
 	}// namespace
 
 }// namespace spine
@@ -35,6 +35,8 @@
 
 namespace spine {
 
+	class SkeletonAsset;
+
 	/* Draws a skeleton. */
 	class SP_API SkeletonRenderer : public axmol::Node, public axmol::BlendProtocol {
 	public:
@@ -43,6 +45,8 @@ namespace spine {
 		static SkeletonRenderer *createWithData(SkeletonData *skeletonData, bool ownsSkeletonData = false);
 		static SkeletonRenderer *createWithFile(const std::string &skeletonDataFile, Atlas *atlas, float scale = 1);
 		static SkeletonRenderer *createWithFile(const std::string &skeletonDataFile, const std::string &atlasFile, float scale = 1);
+		static SkeletonRenderer *createWithAsset(const std::shared_ptr<SkeletonAsset> &asset);
+		static SkeletonRenderer *createWithPrototype(SkeletonRenderer *prototype);
 
 		void update(float deltaTime) override;
 		void draw(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags) override;
@@ -103,6 +107,20 @@ namespace spine {
 		/* Sets the range of slots that should be rendered. Use -1, -1 to clear the range */
 		void setSlotsRange(int startSlotIndex, int endSlotIndex);
 
+		/* Sets the largest error on screen, in pixels, of a mesh level of detail drawn instead of the full mesh. Levels of
+		 * detail are generated by MeshOptimizer. 0 always draws the full meshes. Default is 1. */
+		void setLodTolerance(float pixels);
+		float getLodTolerance() const;
+
+		/* Enables keeping the triangles drawn each frame so pickSlot() can find the slot under a point. Default is false. */
+		void setPickingEnabled(bool enabled);
+		bool isPickingEnabled() const;
+
+		/* Returns the topmost slot drawn in the last frame that covers the point, in node coordinates. Draw order, clipping
+		 * and the slots range are respected because the drawn triangles are used. Returns 0 if picking is disabled, the
+		 * node is not visible or no slot covers the point. */
+		Slot *pickSlot(const axmol::Vec2 &point);
+
 		// --- BlendProtocol
 		void setBlendFunc(const axmol::BlendFunc &blendFunc) override;
 		const axmol::BlendFunc &getBlendFunc() const override;
@@ -123,19 +141,33 @@ namespace spine {
 		void initWithJsonFile(const std::string &skeletonDataFile, const std::string &atlasFile, float scale = 1);
 		void initWithBinaryFile(const std::string &skeletonDataFile, Atlas *atlas, float scale = 1);
 		void initWithBinaryFile(const std::string &skeletonDataFile, const std::string &atlasFile, float scale = 1);
+		/* The node shares the asset, which stays alive until every node created from it is destroyed. */
+		void initWithAsset(const std::shared_ptr<SkeletonAsset> &asset);
+		/* Copies the prototype's skeleton, with its skin, pose and update cache, and its renderer settings instead of setting up
+		 * a new skeleton. The node shares the prototype's skeleton data and atlas, so the prototype, or the asset it was created
+		 * from, must outlive the node. */
+		void initWithPrototype(SkeletonRenderer *prototype);
+
+		/* Resets the skeleton and the renderer settings to those of the prototype, which must have the same skeleton data. Used to
+		 * recycle nodes, see SkeletonAnimationPool. */
+		virtual void cloneFrom(SkeletonRenderer *prototype);
 
 		virtual void initialize();
 
 	protected:
 		void setSkeletonData(SkeletonData *skeletonData, bool ownsSkeletonData);
 		void setupGLProgramState(bool twoColorTintEnabled);
+		void copySettings(SkeletonRenderer *prototype);
 		virtual void drawDebug(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags);
+		/* Computes the world vertices of the slots unless the skeleton's pose version and the level of detail are unchanged. */
+		void updateWorldCoords(float lodError) const;
 
 		bool _ownsSkeletonData;
 		bool _ownsSkeleton;
 		bool _ownsAtlas = false;
 		Atlas *_atlas;
 		AttachmentLoader *_attachmentLoader;
+		std::shared_ptr<SkeletonAsset> _asset;
 		axmol::CustomCommand _debugCommand;
 		axmol::BlendFunc _blendFunc;
 		bool _premultipliedAlpha;
@@ -145,12 +177,36 @@ namespace spine {
 		bool _debugBones;
 		bool _debugMeshes;
 		bool _debugBoundingRect;
-		SkeletonClipping *_clipper;		
-		axmol::Rect _boundingRect;
+		RenderCommandBuilder *_renderBuilder;
+		RenderBuffer _renderBuffer;
+
+		/* What the world vertices of a slot were computed from. They are not recomputed while it is unchanged. */
+		struct SlotCoordsKey {
+			Attachment *attachment;
+			int offset;
+			int sequenceIndex;
+			unsigned int bonesVersion;
+			unsigned int deformVersion;
+		};
+
+		/* The world vertices of every region and mesh that may be drawn and the bounds of the visible ones, reused while
+		 * Skeleton::getPoseVersion() is unchanged. When the pose changes only the slots whose key changed are recomputed.
+		 * The bounds are also recomputed when the slots that are visible change. This costs 8 bytes per vertex plus 29 bytes
+		 * per slot for each instance. */
+		mutable Vector<float> _worldCoords;
+		mutable Vector<int> _slotCoordOffsets;
+		mutable Vector<SlotCoordsKey> _slotCoordKeys;
+		mutable unsigned int _worldCoordsVersion = 0;
+		mutable float _worldCoordsLodError = 0;
+		mutable axmol::Rect _boundingRect;
+		mutable Vector<bool> _boundingRectVisible;
+		mutable bool _boundingRectValid = false;
 
 		int _startSlotIndex;
 		int _endSlotIndex;
 		bool _twoColorTint;
+		float _lodTolerance = 1;
+		SkeletonPicker *_picker = nullptr;
 	};
 
 }// namespace spine
@@ -42,7 +42,8 @@
 USING_NS_AX;
 #define EVENT_AFTER_DRAW_RESET_POSITION "director_after_draw"
 using std::max;
-#define INITIAL_SIZE (10000)
+// Pools twice as large as the most used in this many frames are trimmed to it.
+#define TRIM_INTERVAL (600)
 #define MAX_VERTICES 64000
 #define MAX_INDICES 64000
 
@@ -96,11 +97,9 @@ namespace spine {
 	void TwoColorTrianglesCommand::init(float globalOrder, axmol::Texture2D *texture, axmol::backend::ProgramState *programState, BlendFunc blendType, const TwoColorTriangles &triangles, const Mat4 &mv, uint32_t flags) {
 
 		updateCommandPipelineDescriptor(programState);
+		// The vertices are already transformed by mv, so triangles of other nodes appended to this command share the matrix.
 		const axmol::Mat4 &projectionMat = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
-
-		auto finalMatrix = projectionMat * mv;
-
-		_programState->setUniform(_locPMatrix, finalMatrix.m, sizeof(finalMatrix.m));
+		_programState->setUniform(_locPMatrix, projectionMat.m, sizeof(projectionMat.m));
 		_programState->setTexture(_locTexture, 0, texture->getBackendTexture());
 
 
@@ -138,6 +137,7 @@ namespace spine {
 			initTwoColorProgramState();
 		}
 
+		_nodeProgramState = programState;
 		bool needsUpdateStateLayout = false;
 		auto &pipelinePS = _pipelineDescriptor.programState;
 		if (programState != nullptr) {
@@ -192,10 +192,6 @@ namespace spine {
 	}
 
 
-	void TwoColorTrianglesCommand::draw(Renderer *r) {
-		SkeletonTwoColorBatch::getInstance()->batch(r, this);
-	}
-
 	void TwoColorTrianglesCommand::updateVertexAndIndexBuffer(Renderer *r, V3F_C4B_C4B_T2F *vertices, int verticesSize, uint16_t *indices, int indicesSize) {
 		if (verticesSize != _vertexCapacity)
 			createVertexBuffer(sizeof(V3F_C4B_C4B_T2F), verticesSize, CustomCommand::BufferUsage::DYNAMIC);
@@ -208,6 +204,11 @@ namespace spine {
 
 
 	static SkeletonTwoColorBatch *instance = nullptr;
+	static uint32_t initialCapacity = 64;
+
+	void SkeletonTwoColorBatch::setInitialCapacity(uint32_t commands) {
+		initialCapacity = commands;
+	}
 
 	SkeletonTwoColorBatch *SkeletonTwoColorBatch::getInstance() {
 		if (!instance) instance = new SkeletonTwoColorBatch();
@@ -222,8 +223,9 @@ namespace spine {
 	}
 
 	SkeletonTwoColorBatch::SkeletonTwoColorBatch() : _vertexBuffer(0), _indexBuffer(0) {
-		_commandsPool.reserve(INITIAL_SIZE);
-		for (unsigned int i = 0; i < INITIAL_SIZE; i++) {
+		_initialCapacity = initialCapacity;
+		_commandsPool.reserve(_initialCapacity);
+		for (unsigned int i = 0; i < _initialCapacity; i++) {
 			_commandsPool.push_back(new TwoColorTrianglesCommand());
 		}
 
@@ -300,76 +302,104 @@ namespace spine {
 	}
 
 	TwoColorTrianglesCommand *SkeletonTwoColorBatch::addCommand(axmol::Renderer *renderer, float globalOrder, axmol::Texture2D *texture, backend::ProgramState *programState, axmol::BlendFunc blendType, const TwoColorTriangles &triangles, const axmol::Mat4 &mv, uint32_t flags) {
+		if (_runCommand) {
+			const TwoColorTriangles &run = _runCommand->getTriangles();
+			const int runVertices = _numVerticesBuffer ? (int) _numVerticesBuffer : run.vertCount;
+			const int runIndices = _numIndicesBuffer ? (int) _numIndicesBuffer : run.indexCount;
+			// The merged triangles are drawn with the run's uniforms. Nodes with their own program state may set different
+			// uniforms on the same program, so they only merge with commands of the same program state, and nodes without one
+			// with each other, as the default program state's uniforms are the same for all. 3D commands are sorted by depth,
+			// so they are never merged.
+			const bool merge = _runCommand->getGlobalOrder() == globalOrder && !_runCommand->is3D() && !(flags & Node::FLAGS_RENDER_AS_3D) &&
+							   _runCommand->getTexture() == texture->getBackendTexture() && _runCommand->getBlendType() == blendType &&
+							   _runCommand->getNodeProgramState() == programState &&
+							   runVertices + triangles.vertCount < MAX_VERTICES && runIndices + triangles.indexCount < MAX_INDICES;
+			if (merge) {
+				// Allocated by the first merge rather than with the instance.
+				if (!_vertexBuffer) {
+					_vertexBuffer = new V3F_C4B_C4B_T2F[MAX_VERTICES];
+					_indexBuffer = new unsigned short[MAX_INDICES];
+				}
+				if (!_numVerticesBuffer) append(run);
+				append(triangles);
+				return _runCommand;
+			}
+			flush(renderer);
+		}
+
 		TwoColorTrianglesCommand *command = nextFreeCommand();
 		command->init(globalOrder, texture, programState, blendType, triangles, mv, flags);
-		command->updateVertexAndIndexBuffer(renderer, triangles.verts, triangles.vertCount, triangles.indices, triangles.indexCount);
 		renderer->addCommand(command);
+		_runCommand = command;
+		_numBatches++;
 		return command;
 	}
 
-	void SkeletonTwoColorBatch::batch(axmol::Renderer *renderer, TwoColorTrianglesCommand *command) {
-		if (_numVerticesBuffer + command->getTriangles().vertCount >= MAX_VERTICES || _numIndicesBuffer + command->getTriangles().indexCount >= MAX_INDICES) {
-			flush(renderer, _lastCommand);
-		}
-
-		uint32_t materialID = command->getMaterialID();
-		if (_lastCommand && _lastCommand->getMaterialID() != materialID) {
-			flush(renderer, _lastCommand);
-		}
-
-		memcpy(_vertexBuffer + _numVerticesBuffer, command->getTriangles().verts, sizeof(V3F_C4B_C4B_T2F) * command->getTriangles().vertCount);
-		const Mat4 &modelView = command->getModelView();
-		for (int i = _numVerticesBuffer; i < _numVerticesBuffer + command->getTriangles().vertCount; i++) {
-			modelView.transformPoint(&_vertexBuffer[i].position);
-		}
+	void SkeletonTwoColorBatch::append(const TwoColorTriangles &triangles) {
+		memcpy(_vertexBuffer + _numVerticesBuffer, triangles.verts, sizeof(V3F_C4B_C4B_T2F) * triangles.vertCount);
 
 		unsigned short vertexOffset = (unsigned short) _numVerticesBuffer;
-		unsigned short *indices = command->getTriangles().indices;
-		for (int i = 0, j = _numIndicesBuffer; i < command->getTriangles().indexCount; i++, j++) {
+		unsigned short *indices = triangles.indices;
+		for (int i = 0, j = _numIndicesBuffer; i < triangles.indexCount; i++, j++) {
 			_indexBuffer[j] = indices[i] + vertexOffset;
 		}
 
-		_numVerticesBuffer += command->getTriangles().vertCount;
-		_numIndicesBuffer += command->getTriangles().indexCount;
-
-		if (command->isForceFlush()) {
-			flush(renderer, command);
-		}
-		_lastCommand = command;
+		_numVerticesBuffer += triangles.vertCount;
+		_numIndicesBuffer += triangles.indexCount;
 	}
 
-	void SkeletonTwoColorBatch::flush(axmol::Renderer *renderer, TwoColorTrianglesCommand *materialCommand) {
-		if (!materialCommand)
+	void SkeletonTwoColorBatch::flush(axmol::Renderer *renderer) {
+		if (!_runCommand)
 			return;
 
-		materialCommand->updateVertexAndIndexBuffer(renderer, _vertexBuffer, _numVerticesBuffer, _indexBuffer, _numIndicesBuffer);
-
-		renderer->addCommand(materialCommand);
+		// A run of a single command is uploaded from its own triangles, without copying them.
+		if (_numVerticesBuffer) {
+			_runCommand->updateVertexAndIndexBuffer(renderer, _vertexBuffer, _numVerticesBuffer, _indexBuffer, _numIndicesBuffer);
+		} else {
+			const TwoColorTriangles &triangles = _runCommand->getTriangles();
+			_runCommand->updateVertexAndIndexBuffer(renderer, triangles.verts, triangles.vertCount, triangles.indices, triangles.indexCount);
+		}
 
+		_runCommand = nullptr;
 		_numVerticesBuffer = 0;
 		_numIndicesBuffer = 0;
-		_numBatches++;
 	}
 
 	void SkeletonTwoColorBatch::reset() {
+		_commandsHighWater = max(_commandsHighWater, _nextFreeCommand);
+		_verticesHighWater = max(_verticesHighWater, _numVertices);
+		if (++_framesSinceTrim >= TRIM_INTERVAL) trim();
 		_nextFreeCommand = 0;
 		_numVertices = 0;
 		_indices.setSize(0, 0);
 		_numVerticesBuffer = 0;
 		_numIndicesBuffer = 0;
-		_lastCommand = nullptr;
+		_runCommand = nullptr;
+		_numBatchesLastFrame = _numBatches;
 		_numBatches = 0;
 	}
 
 	TwoColorTrianglesCommand *SkeletonTwoColorBatch::nextFreeCommand() {
-		if (_commandsPool.size() <= _nextFreeCommand) {
-			unsigned int newSize = (int)_commandsPool.size() * 2 + 1;
-			for (int i = (int)_commandsPool.size(); i < newSize; i++) {
-				_commandsPool.push_back(new TwoColorTrianglesCommand());
-			}
+		// Commands are only created when needed, the pool keeps them for the next frames.
+		if (_commandsPool.size() <= _nextFreeCommand) _commandsPool.push_back(new TwoColorTrianglesCommand());
+		return _commandsPool[_nextFreeCommand++];
+	}
+
+	void SkeletonTwoColorBatch::trim() {
+		// Called between frames, when no command is in use.
+		const uint32_t keepCommands = max(_commandsHighWater, _initialCapacity);
+		if (_commandsPool.size() > keepCommands * 2) {
+			for (size_t i = keepCommands; i < _commandsPool.size(); i++)
+				delete _commandsPool[i];
+			_commandsPool.resize(keepCommands);
+			_commandsPool.shrink_to_fit();
 		}
-		TwoColorTrianglesCommand *command = _commandsPool[_nextFreeCommand++];
-		command->setForceFlush(false);
-		return command;
+		if (_vertices.size() > _verticesHighWater * 2) {
+			_vertices.resize(_verticesHighWater);
+			_vertices.shrink_to_fit();
+		}
+		_commandsHighWater = 0;
+		_verticesHighWater = 0;
+		_framesSinceTrim = 0;
 	}
 }// namespace spine
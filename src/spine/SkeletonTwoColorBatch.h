@@ -62,8 +62,6 @@ namespace spine {
 
 		inline axmol::backend::TextureBackend *getTexture() const { return _texture; }
 
-		void draw(axmol::Renderer *renderer);
-
 		void updateVertexAndIndexBuffer(axmol::Renderer *renderer, V3F_C4B_C4B_T2F *vertices, int verticesSize, uint16_t *indices, int indicesSize);
 
 		inline uint32_t getMaterialID() const { return _materialID; }
@@ -82,9 +80,8 @@ namespace spine {
 
 		inline const axmol::Mat4 &getModelView() const { return _mv; }
 
-		void setForceFlush(bool forceFlush) { _forceFlush = forceFlush; }
-
-		bool isForceFlush() { return _forceFlush; };
+		/* The program state passed to init(), null when the command uses a clone of the default two color program state. */
+		inline axmol::backend::ProgramState *getNodeProgramState() const { return _nodeProgramState; }
 
 	protected:
 		void generateMaterialID();
@@ -94,13 +91,13 @@ namespace spine {
 		void *_prog = nullptr;
 		axmol::backend::TextureBackend *_texture = nullptr;
 		axmol::backend::ProgramState *_programState = nullptr;
+		axmol::backend::ProgramState *_nodeProgramState = nullptr;
 		axmol::backend::UniformLocation _locPMatrix;
 		axmol::backend::UniformLocation _locTexture;
 
 		axmol::BlendFunc _blendType;
 		TwoColorTriangles _triangles;
 		axmol::Mat4 _mv;
-		bool _forceFlush;
 	};
 
 	class SP_API SkeletonTwoColorBatch {
@@ -109,6 +106,11 @@ namespace spine {
 
 		static void destroyInstance();
 
+		/* The number of commands created with the instance, which must not exist yet. More are created one at a time when a
+		 * frame needs them. Every 600 frames, a pool more than twice the most used since the last trim is cut back to that
+		 * number, or to this one if larger. Default is 64. */
+		static void setInitialCapacity(uint32_t commands);
+
 		void update(float delta);
 
 		V3F_C4B_C4B_T2F *allocateVertices(uint32_t numVertices);
@@ -117,13 +119,20 @@ namespace spine {
 		unsigned short *allocateIndices(uint32_t numIndices);
 		void deallocateIndices(uint32_t numIndices);
 
+		/* The vertices must be transformed by mv already, so triangles of different nodes can share a command. mv is kept for
+		 * sorting. The triangles are appended to the open run when it has the same material and global order and room for
+		 * them, otherwise the run is flushed and a new command starts the next one. Returns the command drawing them. */
 		TwoColorTrianglesCommand *addCommand(axmol::Renderer *renderer, float globalOrder, axmol::Texture2D *texture, axmol::backend::ProgramState *programState, axmol::BlendFunc blendType, const TwoColorTriangles &triangles, const axmol::Mat4 &mv, uint32_t flags);
 
-		void batch(axmol::Renderer *renderer, TwoColorTrianglesCommand *command);
+		/* Uploads the vertices and indices of the open run to its command and closes the run. Must be called before the
+		 * renderer draws the command, and before anything else is drawn that must not be ordered behind later triangles. */
+		void flush(axmol::Renderer *renderer);
 
-		void flush(axmol::Renderer *renderer, TwoColorTrianglesCommand *materialCommand);
+		/* The number of commands, each one draw call, submitted in the last frame. */
+		uint32_t getNumBatches() { return _numBatchesLastFrame; };
 
-		uint32_t getNumBatches() { return _numBatches; };
+		/* The number of commands in the pool. */
+		uint32_t getCommandCapacity() { return (uint32_t) _commandsPool.size(); }
 
 	protected:
 		SkeletonTwoColorBatch();
@@ -133,29 +142,41 @@ namespace spine {
 
 		TwoColorTrianglesCommand *nextFreeCommand();
 
+		/* Copies triangles behind the open run's vertices and indices, rebasing the indices. */
+		void append(const TwoColorTriangles &triangles);
+
+		/* Shrinks the pools to the most used since the last trim, if they are more than twice as large. */
+		void trim();
+
 		// pool of commands
 		std::vector<TwoColorTrianglesCommand *> _commandsPool;
-		uint32_t _nextFreeCommand;
+		uint32_t _nextFreeCommand = 0;
 
 		// pool of vertices
 		std::vector<V3F_C4B_C4B_T2F> _vertices;
-		uint32_t _numVertices;
+		uint32_t _numVertices = 0;
 
 		// pool of indices
 		Vector<unsigned short> _indices;
 
 
-		// VBO handles & attribute locations
+		// vertices and indices of the open run once it merges more than one command
 		V3F_C4B_C4B_T2F *_vertexBuffer;
 		uint32_t _numVerticesBuffer;
 		uint32_t _numIndicesBuffer;
 		unsigned short *_indexBuffer;
 
-		// last batched command, needed for flushing to set material
-		TwoColorTrianglesCommand *_lastCommand = nullptr;
+		// command of the open run, its triangles are uploaded when the run is flushed
+		TwoColorTrianglesCommand *_runCommand = nullptr;
+
+		// number of commands submitted in this frame and the last one
+		uint32_t _numBatches = 0;
+		uint32_t _numBatchesLastFrame = 0;
 
-		// number of batches in the last frame
-		uint32_t _numBatches;
+		uint32_t _initialCapacity;
+		uint32_t _commandsHighWater = 0;
+		uint32_t _verticesHighWater = 0;
+		uint32_t _framesSinceTrim = 0;
 	};
 }// namespace spine
 
@@ -73,6 +73,10 @@ AxmolTextureLoader::~AxmolTextureLoader() {}
 void AxmolTextureLoader::load(AtlasPage &page, const spine::String &path) {
 	Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(path.buffer());
 	AXASSERT(texture != nullptr, "Invalid image");
+	load(page, texture);
+}
+
+void AxmolTextureLoader::load(AtlasPage &page, Texture2D *texture) {
 	if (texture) {
 		texture->retain();
 		Texture2D::TexParams textureParams(filter(page.minFilter), filter(page.magFilter), wrap(page.uWrap), wrap(page.vWrap));
@@ -90,6 +94,52 @@ void AxmolTextureLoader::unload(void *texture) {
 	}
 }
 
+bool AxmolTextureLoader::readPixels(AtlasPage &page, spine::Vector<unsigned char> &pixels) {
+	if (page.texturePath.isEmpty()) return false;
+	Image *image = new Image();
+	bool read = image->initWithImageFile(page.texturePath.buffer()) && image->getWidth() == page.width &&
+				image->getHeight() == page.height;
+	if (read) {
+		const unsigned char *data = image->getData();
+		size_t count = (size_t) page.width * page.height;
+		pixels.setSize(count * 4, 0);
+		unsigned char *rgba = pixels.buffer();
+		switch (image->getPixelFormat()) {
+			case backend::PixelFormat::RGBA8:
+				memcpy(rgba, data, count * 4);
+				break;
+			case backend::PixelFormat::RGB8:
+				for (size_t i = 0; i < count; ++i, rgba += 4, data += 3) {
+					rgba[0] = data[0];
+					rgba[1] = data[1];
+					rgba[2] = data[2];
+					rgba[3] = 255;
+				}
+				break;
+			default:
+				read = false;
+		}
+	}
+	image->release();
+	return read;
+}
+
+void AxmolTextureLoader::loadPixels(AtlasPage &page, const unsigned char *pixels, AtlasPage &sourcePage) {
+	// The pixels are premultiplied if the image decoder premultiplied the source page's image.
+	bool premultiplied = sourcePage.texture ? ((Texture2D *) sourcePage.texture)->hasPremultipliedAlpha() : page.pma;
+	Image *image = new Image();
+	Texture2D *texture = nullptr;
+	if (image->initWithRawData(pixels, (ssize_t) page.width * page.height * 4, page.width, page.height, 8, premultiplied)) {
+		texture = new Texture2D();
+		if (!texture->initWithImage(image)) AX_SAFE_RELEASE_NULL(texture);
+	}
+	image->release();
+	if (texture) {
+		load(page, texture);
+		texture->release();
+	}
+}
+
 
 AxmolExtension::AxmolExtension() : DefaultSpineExtension() {}
 
@@ -36,8 +36,11 @@
 #include <spine/SkeletonRenderer.h>
 #include <spine/SkeletonBatch.h>
 #include <spine/SkeletonTwoColorBatch.h>
+#include <spine/SkeletonBatchGroup.h>
 
+#include <spine/SkeletonAsyncLoader.h>
 #include <spine/SkeletonAnimation.h>
+#include <spine/SkeletonAnimationPool.h>
 
 #define AX_SPINE_VERSION 0x040100
 
@@ -57,7 +60,16 @@ namespace spine {
 
 		virtual void load(AtlasPage &page, const String &path);
 
+		/* Binds an already created texture to the page, e.g. one built from an image decoded off the main thread. */
+		void load(AtlasPage &page, axmol::Texture2D *texture);
+
 		virtual void unload(void *texture);
+
+		/* Decodes the page's image file again, as the texture cache did. */
+		virtual bool readPixels(AtlasPage &page, spine::Vector<unsigned char> &pixels);
+
+		/* Must be called on the main thread. */
+		virtual void loadPixels(AtlasPage &page, const unsigned char *pixels, AtlasPage &sourcePage);
 	};
 
 	class SP_API AxmolExtension : public DefaultSpineExtension {
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "Generator.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace spine;
+
+namespace {
+	const int REGION_SIZE = 32;
+
+	void appendf(String &out, const char *format, float a, float b = 0, float c = 0, float d = 0) {
+		char buffer[128];
+		snprintf(buffer, sizeof(buffer), format, a, b, c, d);
+		out.append(buffer);
+	}
+
+	void appendName(String &out, const char *prefix, int index) {
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "\"%s%d\"", prefix, index);
+		out.append(buffer);
+	}
+
+	/* A 3x3 grid of vertices with a hull of 8, in the bone's coordinates, or weighted to this and the following bones. */
+	void appendMesh(String &out, int region, float x, float y, int bone, int bones, int weights) {
+		out.append("{\"type\":\"mesh\",\"path\":");
+		appendName(out, "r", region);
+		out.append(",\"uvs\":[0,0,0.5,0,1,0,1,0.5,1,1,0.5,1,0,1,0,0.5,0.5,0.5],"
+				   "\"triangles\":[0,1,8,1,2,8,2,3,8,3,4,8,4,5,8,5,6,8,6,7,8,7,0,8],\"vertices\":[");
+		static const float grid[] = {0, 0, 1, 0, 2, 0, 2, 1, 2, 2, 1, 2, 0, 2, 0, 1, 1, 1};
+		for (int i = 0; i < 18; i += 2) {
+			float vx = x + grid[i] * REGION_SIZE / 2, vy = y + grid[i + 1] * REGION_SIZE / 2;
+			if (weights == 0) {
+				appendf(out, i ? ",%g,%g" : "%g,%g", vx, vy);
+				continue;
+			}
+			// Vertices at different grid points start at different bones, so groups of four mix bones.
+			appendf(out, i ? ",%g" : "%g", (float) weights);
+			for (int w = 0; w < weights; w++)
+				appendf(out, ",%g,%g,%g,%g", (float) ((bone + i / 2 + w) % bones), vx, vy, 1.f / weights);
+		}
+		appendf(out, "],\"hull\":8,\"width\":%g,\"height\":%g}", REGION_SIZE, REGION_SIZE);
+	}
+}
+
+Atlas *SkeletonGenerator::createAtlas(int pages, int regionsPerPage) {
+	String text;
+	int region = 0, columns = (int) ceilf(sqrtf((float) regionsPerPage)), size = columns * REGION_SIZE;
+	for (int page = 0; page < pages; page++) {
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%sp%d.png\nsize: %d,%d\n", page ? "\n" : "", page, size, size);
+		text.append(buffer);
+		for (int i = 0; i < regionsPerPage; i++, region++) {
+			snprintf(buffer, sizeof(buffer), "r%d\nbounds: %d,%d,%d,%d\n", region, i % columns * REGION_SIZE,
+					 i / columns * REGION_SIZE, REGION_SIZE, REGION_SIZE);
+			text.append(buffer);
+		}
+	}
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(text.buffer(), (int) text.length(), "", NULL, false);
+	Vector<AtlasPage *> &atlasPages = atlas->getPages();
+	for (size_t i = 0; i < atlasPages.size(); i++)
+		atlasPages[i]->texture = atlasPages[i];
+	return atlas;
+}
+
+SkeletonData *SkeletonGenerator::createSkeletonData(Atlas &atlas, const Shape &shape) {
+	int regions = (int) atlas.getRegions().size();
+	String json("{\"skeleton\":{\"spine\":\"4.1.24\"},\"bones\":[{\"name\":\"b0\"}");
+	for (int i = 1; i < shape.bones; i++) {
+		// Three children per bone keeps the tree shallow, as in most characters.
+		json.append(",{\"name\":");
+		appendName(json, "b", i);
+		json.append(",\"parent\":");
+		appendName(json, "b", (i - 1) / 3);
+		appendf(json, ",\"length\":%g,\"x\":%g,\"rotation\":%g}", 20, 20, (float) ((i % 3) * 40 - 40));
+	}
+
+	json.append("],\"slots\":[");
+	int boundingBoxes = shape.boundingBoxEvery > 0 ? (shape.bones + shape.boundingBoxEvery - 1) / shape.boundingBoxEvery : 0;
+	for (int i = 0; i < shape.slots + boundingBoxes; i++) {
+		bool boundingBox = i >= shape.slots;
+		int bone = boundingBox ? (i - shape.slots) * shape.boundingBoxEvery : i % shape.bones;
+		json.append(i ? ",{\"name\":" : "{\"name\":");
+		appendName(json, "s", i);
+		json.append(",\"bone\":");
+		appendName(json, "b", bone);
+		json.append(",\"attachment\":");
+		appendName(json, "a", i);
+		json.append("}");
+	}
+
+	json.append("],\"ik\":[");
+	for (int i = 0, constraints = 0; constraints < shape.ikConstraints && i < shape.bones; i++) {
+		int parent = i + 1, child = parent * 3 + 1, target = shape.bones - 1 - i;
+		if (child >= shape.bones) break;
+		// The target must not be moved by the constrained bones.
+		int ancestor = target;
+		while (ancestor > parent) ancestor = (ancestor - 1) / 3;
+		if (ancestor == parent) continue;
+		json.append(constraints ? ",{\"name\":" : "{\"name\":");
+		appendName(json, "ik", constraints);
+		appendf(json, ",\"order\":%g,\"bones\":[", (float) constraints);
+		appendName(json, "b", parent);
+		json.append(",");
+		appendName(json, "b", child);
+		json.append("],\"target\":");
+		appendName(json, "b", target);
+		json.append("}");
+		constraints++;
+	}
+
+	json.append("],\"skins\":[");
+	for (int skin = 0; skin <= shape.skins; skin++) {
+		if (skin) {
+			json.append("}},{\"name\":");
+			appendName(json, "skin", skin);
+			json.append(",\"attachments\":{");
+		} else
+			json.append("{\"name\":\"default\",\"attachments\":{");
+		// Skins other than the default replace the drawing attachments only.
+		for (int i = 0, n = skin ? shape.slots : shape.slots + boundingBoxes; i < n; i++) {
+			if (i) json.append(",");
+			appendName(json, "s", i);
+			json.append(":{");
+			appendName(json, "a", i);
+			json.append(":");
+			// Offset the attachments of slots sharing a bone, so they do not all overlap.
+			float x = (float) (i / shape.bones % 4) * 8, y = (float) (i / shape.bones / 4) * 8;
+			int region = (i + skin) % regions;
+			if (i >= shape.slots)
+				json.append("{\"type\":\"boundingbox\",\"vertexCount\":4,\"vertices\":[0,-16,32,-16,32,16,0,16]}");
+			else if (shape.meshEvery > 0 && i % shape.meshEvery == shape.meshEvery - 1)
+				appendMesh(json, region, x, y, i % shape.bones, shape.bones, shape.weights);
+			else {
+				json.append("{\"path\":");
+				appendName(json, "r", region);
+				appendf(json, ",\"x\":%g,\"y\":%g,\"width\":%g,\"height\":%g}", x + REGION_SIZE / 2, y, REGION_SIZE,
+						REGION_SIZE);
+			}
+			json.append("}");
+		}
+	}
+
+	json.append("}}],\"animations\":{\"idle\":{\"bones\":{");
+	for (int i = 0; i < shape.bones; i++) {
+		if (i) json.append(",");
+		appendName(json, "b", i);
+		float angle = (float) (10 + i % 7 * 5);
+		appendf(json, ":{\"rotate\":[{\"value\":0},{\"time\":0.5,\"value\":%g},{\"time\":1,\"value\":-%g},{\"time\":1.5}]",
+				angle, angle);
+		json.append(i ? "}" : ",\"translate\":[{},{\"time\":0.75,\"x\":30,\"y\":10},{\"time\":1.5}]}");
+	}
+	json.append("}}}}");
+
+	AtlasAttachmentLoader attachmentLoader(&atlas);
+	SkeletonJson reader(&attachmentLoader, false);
+	SkeletonData *skeletonData = reader.readSkeletonData(json.buffer());
+	if (!skeletonData) fprintf(stderr, "Error generating skeleton data: %s\n", reader.getError().buffer());
+	return skeletonData;
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef SPINE_SKELETONGENERATOR_H_
+#define SPINE_SKELETONGENERATOR_H_
+
+#include <spine/spine.h>
+
+namespace spine {
+
+	/* Builds atlases and skeleton data in memory, so the benchmarks need no files and measure the same work everywhere. */
+	class SkeletonGenerator {
+	public:
+		struct Shape {
+			int bones;
+			/* Slots drawing a region or mesh attachment. */
+			int slots;
+			/* Every this many slots draws a mesh instead of a region, 0 for no meshes. */
+			int meshEvery;
+			/* Every this many bones gets an extra slot with a bounding box, 0 for no bounding boxes. */
+			int boundingBoxEvery;
+			/* Bones each mesh vertex is weighted to, 0 for meshes moved by their slot's bone only. */
+			int weights;
+			/* IK constraints, each bending a bone and its first child toward a bone of another branch. */
+			int ikConstraints;
+			/* Skins named skin1, skin2, ... besides the default skin, each replacing every slot's region or mesh with one
+			 * using another region. */
+			int skins;
+		};
+
+		/* Creates an atlas with regions named r0, r1, ... spread over the pages. No textures are loaded, each page's texture
+		 * is set to the page itself so batches still break where the page changes. */
+		static Atlas *createAtlas(int pages, int regionsPerPage);
+
+		/* Creates skeleton data with the bones in a tree, the attachments cycling through the atlas regions and an animation
+		 * named "idle" rotating every bone. */
+		static SkeletonData *createSkeletonData(Atlas &atlas, const Shape &shape);
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONGENERATOR_H_ */
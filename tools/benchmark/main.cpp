@@ -0,0 +1,866 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "Generator.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using namespace spine;
+
+spine::SpineExtension *spine::getDefaultExtension() {
+	return new DefaultSpineExtension();
+}
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	struct Options {
+		int actors = 2000;
+		int queries = 2000;
+		int frames = 10;
+		int skeletons = 100;
+		int crowd = 1000;
+	};
+
+	double elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	/* A fixed sequence, so every run measures the same poses and queries. */
+	unsigned int seed = 1;
+
+	float randomFloat(float min, float max) {
+		seed = seed * 1664525 + 1013904223;
+		return min + (max - min) * (float) (seed >> 8) / (float) (1 << 24);
+	}
+
+	struct Actor {
+		Skeleton *skeleton;
+		SkeletonBounds bounds;
+		float time;
+		int proxy;
+	};
+
+	struct BuildShape {
+		const char *name;
+		int pages;
+		SkeletonGenerator::Shape shape;
+	};
+
+	bool runBuild(const Options &options) {
+		static const BuildShape shapes[] = {
+				{"small", 1, {10, 20, 0, 0}},
+				{"medium", 2, {30, 100, 4, 0}},
+				{"large", 4, {60, 400, 3, 0}},
+		};
+		printf("build: %d skeletons of each size per frame\n", options.skeletons);
+		for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+			const BuildShape &shape = shapes[s];
+			Atlas *atlas = SkeletonGenerator::createAtlas(shape.pages, 16);
+			SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape.shape);
+			if (!skeletonData) {
+				delete atlas;
+				return false;
+			}
+			Animation *animation = skeletonData->findAnimation("idle");
+			Vector<Skeleton *> skeletons;
+			Vector<float> times;
+			for (int i = 0; i < options.skeletons; i++) {
+				skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+				times.add(randomFloat(0, animation->getDuration()));
+			}
+
+			RenderCommandBuilder builder;
+			builder.setDarkColors(true);
+			RenderBuffer buffer;
+			double buildMs = 0;
+			size_t batches = 0, vertices = 0, indices = 0;
+			for (int frame = 0; frame < options.frames; frame++) {
+				for (size_t i = 0; i < skeletons.size(); i++) {
+					times[i] += 1 / 60.f;
+					animation->apply(*skeletons[i], 0, times[i], true, NULL, 1, MixBlend_Setup, MixDirection_In);
+					skeletons[i]->updateWorldTransform();
+				}
+				Clock::time_point start = Clock::now();
+				for (size_t i = 0; i < skeletons.size(); i++) {
+					buffer.clear();
+					builder.build(*skeletons[i], buffer);
+					batches += buffer.batches.size();
+					vertices += buffer.colors.size();
+					indices += buffer.indices.size();
+				}
+				buildMs += elapsedMs(start);
+			}
+
+			double builds = (double) options.frames * options.skeletons;
+			printf("  %-6s bones %2d, slots %3d, pages %d: %8.2f us per build, %5.1f batches, %6.0f vertices, %6.0f indices\n",
+				   shape.name, shape.shape.bones, shape.shape.slots, shape.pages, buildMs * 1000 / builds, batches / builds,
+				   vertices / builds, indices / builds);
+
+			for (size_t i = 0; i < skeletons.size(); i++)
+				delete skeletons[i];
+			delete skeletonData;
+			delete atlas;
+		}
+		return true;
+	}
+
+	/* Laid out as axmol's V3F_C4B_C4B_T2F. */
+	struct TwoColorVertex {
+		float x, y, z;
+		unsigned int color, color2;
+		float u, v;
+	};
+
+	/* The CPU side of drawing a crowd of skeletons in a SkeletonBatchGroup, both needing axmol: writing each batch's vertices
+	 * transformed by its node as SkeletonRenderer::draw() does, and appending the commands of each merged run to one
+	 * staging buffer as SkeletonTwoColorBatch::append() does, before flush() uploads it. Returns the milliseconds of each. */
+	void measureAppend(RenderBuffer &buffer, int crowd, int frames, int maxRun, double &writeMs, double &appendMs) {
+		int vertexCount = (int) buffer.colors.size();
+		Vector<TwoColorVertex> vertices, staging;
+		vertices.setSize((size_t) vertexCount * crowd, TwoColorVertex());
+		staging.setSize(maxRun, TwoColorVertex());
+		Vector<unsigned short> stagingIndices;
+		stagingIndices.setSize(maxRun, 0);
+		writeMs = appendMs = 0;
+		for (int frame = 0; frame < frames; frame++) {
+			Clock::time_point start = Clock::now();
+			for (int i = 0; i < crowd; i++) {
+				// A translation, as most nodes have.
+				float m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, (float) (i % 40) * 50, (float) (i / 40) * 50, 0, 1};
+				TwoColorVertex *vertex = vertices.buffer() + (size_t) vertexCount * i;
+				for (int v = 0; v < vertexCount; ++v, ++vertex) {
+					const float x = buffer.positions[v * 2], y = buffer.positions[v * 2 + 1];
+					vertex->x = m[0] * x + m[4] * y + m[12];
+					vertex->y = m[1] * x + m[5] * y + m[13];
+					vertex->z = m[2] * x + m[6] * y + m[14];
+					vertex->u = buffer.uvs[v * 2];
+					vertex->v = buffer.uvs[v * 2 + 1];
+					vertex->color = buffer.colors[v];
+					vertex->color2 = buffer.darkColors[v];
+				}
+			}
+			writeMs += elapsedMs(start);
+
+			// A run's first command is appended when a second one joins it, a run of one is uploaded from its own vertices.
+			start = Clock::now();
+			void *runTexture = NULL;
+			BlendMode runBlendMode = BlendMode_Normal;
+			int runVertices = 0, runIndices = 0, stagedVertices = 0, stagedIndices = 0;
+			const RenderBatch *runFirst = NULL;
+			const TwoColorVertex *runFirstVertices = NULL;
+			for (int i = 0; i < crowd; i++) {
+				for (size_t b = 0; b < buffer.batches.size(); b++) {
+					const RenderBatch &batch = buffer.batches[b];
+					const TwoColorVertex *batchVertices = vertices.buffer() + (size_t) vertexCount * i + batch.vertexStart;
+					if (runTexture != batch.texture || runBlendMode != batch.blendMode ||
+						runVertices + batch.vertexCount >= maxRun || runIndices + batch.indexCount >= maxRun) {
+						runTexture = batch.texture;
+						runBlendMode = batch.blendMode;
+						stagedVertices = stagedIndices = 0;
+						runFirst = &batch;
+						runFirstVertices = batchVertices;
+						runVertices = batch.vertexCount;
+						runIndices = batch.indexCount;
+						continue;
+					}
+					for (int append = runFirst ? 0 : 1; append < 2; append++) {
+						const RenderBatch &appended = append ? batch : *runFirst;
+						memcpy(staging.buffer() + stagedVertices, append ? batchVertices : runFirstVertices,
+							   sizeof(TwoColorVertex) * appended.vertexCount);
+						const unsigned short *indices = buffer.indices.buffer() + appended.indexStart;
+						for (int ii = 0, j = stagedIndices; ii < appended.indexCount; ii++, j++)
+							stagingIndices[j] = (unsigned short) (indices[ii] + stagedVertices);
+						stagedVertices += appended.vertexCount;
+						stagedIndices += appended.indexCount;
+					}
+					runFirst = NULL;
+					runVertices += batch.vertexCount;
+					runIndices += batch.indexCount;
+				}
+			}
+			appendMs += elapsedMs(start);
+		}
+		writeMs /= frames;
+		appendMs /= frames;
+	}
+
+	/* Counts the commands SkeletonTwoColorBatch submits for a crowd of two color skeletons: one per batch of each skeleton
+	 * when drawn on their own, and one per run of equal texture and blend mode when drawn in a SkeletonBatchGroup. The
+	 * merge rules are those of SkeletonTwoColorBatch::addCommand(), which needs axmol, for skeletons with the same global z
+	 * order and no program state of their own. */
+	bool runDrawCalls(const Options &options) {
+		const int maxRun = 64000;
+		static const BuildShape shapes[] = {
+				{"1 page", 1, {10, 20, 0, 0}},
+				{"2 pages", 2, {30, 40, 4, 0}},
+		};
+		printf("drawcalls: %d two color skeletons\n", options.crowd);
+		for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+			const BuildShape &shape = shapes[s];
+			Atlas *atlas = SkeletonGenerator::createAtlas(shape.pages, 16);
+			SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape.shape);
+			if (!skeletonData) {
+				delete atlas;
+				return false;
+			}
+			Skeleton skeleton(skeletonData);
+			skeleton.updateWorldTransform();
+			RenderCommandBuilder builder;
+			builder.setDarkColors(true);
+			builder.setMaxBatchSize(maxRun - 1, maxRun - 1);
+			RenderBuffer buffer;
+
+			size_t separate = 0, merged = 0;
+			void *runTexture = NULL;
+			BlendMode runBlendMode = BlendMode_Normal;
+			int runVertices = 0, runIndices = 0;
+			for (int i = 0; i < options.crowd; i++) {
+				buffer.clear();
+				builder.build(skeleton, buffer);
+				separate += buffer.batches.size();
+				for (size_t b = 0; b < buffer.batches.size(); b++) {
+					RenderBatch &batch = buffer.batches[b];
+					if (runTexture == batch.texture && runBlendMode == batch.blendMode &&
+						runVertices + batch.vertexCount < maxRun && runIndices + batch.indexCount < maxRun) {
+						runVertices += batch.vertexCount;
+						runIndices += batch.indexCount;
+						continue;
+					}
+					merged++;
+					runTexture = batch.texture;
+					runBlendMode = batch.blendMode;
+					runVertices = batch.vertexCount;
+					runIndices = batch.indexCount;
+				}
+			}
+			double writeMs, appendMs;
+			measureAppend(buffer, options.crowd, options.frames, maxRun, writeMs, appendMs);
+			printf("  %-7s slots %2d, %2d vertices each: %6zu commands on their own, %4zu in a SkeletonBatchGroup\n",
+				   shape.name, shape.shape.slots, (int) buffer.colors.size(), separate, merged);
+			printf("          per frame: %.3f ms writing transformed vertices, %.3f ms appending runs\n", writeMs, appendMs);
+
+			delete skeletonData;
+			delete atlas;
+		}
+		return true;
+	}
+
+	/* Animations deforming every mesh of a skeleton, with the DeformTimeline frames as loaded, compacted and compacted with
+	 * quantization. Reports the vertex bytes and apply time of each, and fails if compacting changes the applied deform or
+	 * quantizing changes it by more than the reported error. */
+	bool runDeform(const Options &options) {
+		const int frames = 30;
+		Atlas *atlas = SkeletonGenerator::createAtlas(1, 16);
+		SkeletonGenerator::Shape shape = {30, 100, 1, 0, 0, 0};
+		SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape);
+		if (!skeletonData) {
+			delete atlas;
+			return false;
+		}
+
+		// The same keys for each storage. As in most rigs, a frame moves only part of the mesh.
+		Vector<float> keys;
+		Vector<SlotData *> &slotDatas = skeletonData->getSlots();
+		for (size_t i = 0; i < slotDatas.size(); i++)
+			for (int frame = 0; frame < frames; frame++)
+				for (int v = 0; v < 18; v++)
+					keys.add(v < 6 || frame == 0 ? 0 : randomFloat(-8, 8));
+		Animation *animations[3];
+		static const char *names[] = {"full", "compact", "quantized"};
+		size_t bytes[3] = {0, 0, 0};
+		float quantizationError = 0;
+		for (int storage = 0; storage < 3; storage++) {
+			Vector<Timeline *> timelines;
+			for (size_t i = 0, k = 0; i < slotDatas.size(); i++) {
+				Attachment *attachment = skeletonData->getDefaultSkin()->getAttachment(i, slotDatas[i]->getAttachmentName());
+				DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(
+						frames, 0, (int) i, static_cast<VertexAttachment *>(attachment));
+				Vector<float> vertices;
+				for (int frame = 0; frame < frames; frame++, k += 18) {
+					vertices.clear();
+					for (int v = 0; v < 18; v++)
+						vertices.add(keys[k + v]);
+					timeline->setFrame(frame, frame / 30.f, vertices);
+				}
+				if (storage) timeline->compact(storage == 2);
+				quantizationError = MathUtil::max(quantizationError, timeline->getQuantizationError());
+				bytes[storage] += timeline->getVerticesMemory();
+				timelines.add(timeline);
+			}
+			animations[storage] = new (__FILE__, __LINE__) Animation(names[storage], timelines, (frames - 1) / 30.f);
+		}
+
+		Skeleton skeleton(skeletonData);
+		Vector<float> expected;
+		float compactError = 0, quantizedError = 0;
+		printf("deform: %zu meshes, %d frames of 18 values each, %d skeletons posed per frame\n", slotDatas.size(), frames,
+			   options.skeletons);
+		for (int storage = 0; storage < 3; storage++) {
+			Animation &animation = *animations[storage];
+			float duration = animation.getDuration();
+			Vector<Slot *> &slots = skeleton.getSlots();
+			Clock::time_point start = Clock::now();
+			for (int i = 0, n = options.frames * options.skeletons; i < n; i++)
+				animation.apply(skeleton, 0, duration * i / n, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			double ms = elapsedMs(start);
+
+			// Compare the deform at a time between keys.
+			animation.apply(skeleton, 0, duration * 0.37f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			for (size_t i = 0, k = 0; i < slots.size(); i++) {
+				Vector<float> &deform = slots[i]->getDeform();
+				for (size_t v = 0; v < deform.size(); v++, k++) {
+					if (storage == 0) expected.add(deform[v]);
+					float &error = storage == 1 ? compactError : quantizedError;
+					if (storage) error = MathUtil::max(error, MathUtil::abs(deform[v] - expected[k]));
+				}
+			}
+			printf("  %-9s %8zu bytes, %7.2f us per apply\n", names[storage], bytes[storage],
+				   ms * 1000 / (options.frames * options.skeletons));
+		}
+		printf("  quantization error %g, applied %g\n", quantizationError, quantizedError);
+
+		for (int storage = 0; storage < 3; storage++)
+			delete animations[storage];
+		delete skeletonData;
+		delete atlas;
+		// Blending two quantized frames can add their errors.
+		if (compactError != 0 || quantizedError > quantizationError * 2) {
+			fprintf(stderr, "Compacted deform differs by %g, quantized by %g\n", compactError, quantizedError);
+			return false;
+		}
+		return true;
+	}
+
+	/* A large rig where an animation moves a few leaf bones, as when a character only blinks or breathes. Compares computing
+	 * the world vertices of every slot each frame with recomputing only the slots whose bones, deform or attachment changed,
+	 * keyed as in SkeletonRenderer::updateWorldCoords(), which needs axmol. Fails if the two give different vertices. */
+	bool runRig(const Options &options) {
+		const int animatedBones = 12;
+		Atlas *atlas = SkeletonGenerator::createAtlas(4, 16);
+		SkeletonGenerator::Shape shape = {60, 400, 3, 0, 0, 0, 0};
+		SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape);
+		if (!skeletonData) {
+			delete atlas;
+			return false;
+		}
+		// The last bones are leaves, each moving its slots only.
+		Vector<Timeline *> timelines;
+		for (int i = 0; i < animatedBones; i++) {
+			RotateTimeline *timeline = new (__FILE__, __LINE__) RotateTimeline(3, 0, shape.bones - 1 - i);
+			timeline->setFrame(0, 0, 0);
+			timeline->setFrame(1, 0.5f, 20);
+			timeline->setFrame(2, 1, 0);
+			timelines.add(timeline);
+		}
+		Animation animation("breathe", timelines, 1);
+
+		Skeleton skeleton(skeletonData);
+		Vector<Slot *> &slots = skeleton.getSlots();
+		Vector<int> offsets;
+		int coordCount = 0;
+		for (size_t i = 0; i < slots.size(); i++) {
+			Attachment *attachment = slots[i]->getAttachment();
+			offsets.add(coordCount);
+			coordCount += attachment->getRTTI().isExactly(RegionAttachment::rtti)
+								  ? 8
+								  : (int) static_cast<MeshAttachment *>(attachment)->getWorldVerticesLength();
+		}
+		Vector<float> all, keyed;
+		all.setSize(coordCount, 0);
+		keyed.setSize(coordCount, 0);
+		Vector<Attachment *> keyAttachments;
+		Vector<unsigned int> keyBones, keyDeforms;
+		keyAttachments.setSize(slots.size(), NULL);
+		keyBones.setSize(slots.size(), 0);
+		keyDeforms.setSize(slots.size(), 0);
+
+		double allMs = 0, keyedMs = 0;
+		size_t recomputed = 0;
+		bool identical = true;
+		int frames = options.frames * 10;
+		for (int frame = 0; frame < frames; frame++) {
+			animation.apply(skeleton, 0, frame / 60.f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			skeleton.updateWorldTransform();
+			for (int path = 0; path < 2; path++) {
+				Vector<float> &coords = path ? keyed : all;
+				Clock::time_point start = Clock::now();
+				for (size_t i = 0; i < slots.size(); i++) {
+					Slot &slot = *slots[i];
+					Attachment *attachment = slot.getAttachment();
+					bool region = attachment->getRTTI().isExactly(RegionAttachment::rtti);
+					if (path) {
+						unsigned int bonesVersion = region ? slot.getBone().getWorldVersion()
+														   : static_cast<MeshAttachment *>(attachment)->getBonesVersion(slot);
+						if (keyAttachments[i] == attachment && keyBones[i] == bonesVersion &&
+							keyDeforms[i] == slot.getDeformVersion())
+							continue;
+						keyAttachments[i] = attachment;
+						keyBones[i] = bonesVersion;
+						keyDeforms[i] = slot.getDeformVersion();
+						recomputed++;
+					}
+					if (region)
+						static_cast<RegionAttachment *>(attachment)->computeWorldVertices(slot, coords.buffer() + offsets[i], 0, 2);
+					else {
+						MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+						mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), coords.buffer() + offsets[i], 0, 2);
+					}
+				}
+				(path ? keyedMs : allMs) += elapsedMs(start);
+			}
+			if (memcmp(all.buffer(), keyed.buffer(), coordCount * sizeof(float))) identical = false;
+		}
+
+		printf("rig: %d bones, %d slots, %d leaf bones animated, %d frames\n", shape.bones, shape.slots, animatedBones, frames);
+		printf("  every slot:           %7.2f us per frame\n", allMs * 1000 / frames);
+		printf("  changed slots only:   %7.2f us per frame, %.1f slots recomputed\n", keyedMs * 1000 / frames,
+			   (double) recomputed / frames);
+
+		delete skeletonData;
+		delete atlas;
+		if (!identical) {
+			fprintf(stderr, "Recomputing only changed slots gave different world vertices\n");
+			return false;
+		}
+		return true;
+	}
+
+	/* Weighted meshes through VertexAttachment::computeWorldVertices(): all vertices at once, which takes the vectorized
+	 * path, versus two halves, which take the scalar one. Fails unless both give bit identical vertices, with and without
+	 * deform. */
+	bool runSkinning(const Options &options) {
+		Atlas *atlas = SkeletonGenerator::createAtlas(1, 16);
+		Vector<float> vectorized, scalar;
+		bool identical = true;
+		printf("skinning: %d skeletons of 60 bones and 100 weighted meshes\n", options.skeletons);
+		for (int weights = 1; weights <= 4; weights *= 2) {
+			SkeletonGenerator::Shape shape = {60, 100, 1, 0, weights, 0};
+			SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape);
+			if (!skeletonData) {
+				delete atlas;
+				return false;
+			}
+			Skeleton skeleton(skeletonData);
+			skeletonData->findAnimation("idle")->apply(skeleton, 0, 0.6f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			skeleton.updateWorldTransform();
+			Vector<Slot *> &slots = skeleton.getSlots();
+
+			for (int deformed = 0; deformed < 2; deformed++) {
+				for (size_t i = 0; i < slots.size(); i++) {
+					Vector<float> &deform = slots[i]->getDeform();
+					deform.clear();
+					if (!deformed) continue;
+					MeshAttachment *mesh = static_cast<MeshAttachment *>(slots[i]->getAttachment());
+					for (size_t ii = 0, n = mesh->getVertices().size() / 3 * 2; ii < n; ii++)
+						deform.add(randomFloat(-2, 2));
+				}
+				double times[2] = {0, 0};
+				for (int path = 0; path < 2; path++) {
+					Vector<float> &out = path ? scalar : vectorized;
+					Clock::time_point start = Clock::now();
+					for (int k = 0; k < options.skeletons; k++) {
+						out.clear();
+						for (size_t i = 0; i < slots.size(); i++) {
+							MeshAttachment *mesh = static_cast<MeshAttachment *>(slots[i]->getAttachment());
+							size_t length = mesh->getWorldVerticesLength(), offset = out.size();
+							out.setSize(offset + length, 0);
+							if (path == 0)
+								mesh->computeWorldVertices(*slots[i], 0, length, out, offset);
+							else {
+								size_t half = length / 4 * 2;
+								mesh->computeWorldVertices(*slots[i], 0, half, out, offset);
+								mesh->computeWorldVertices(*slots[i], half, length - half, out, offset + half);
+							}
+						}
+					}
+					times[path] = elapsedMs(start);
+				}
+				if (memcmp(vectorized.buffer(), scalar.buffer(), vectorized.size() * sizeof(float))) identical = false;
+				printf("  %d bone%s per vertex%s: vectorized %7.2f us, scalar %7.2f us per skeleton\n", weights,
+					   weights > 1 ? "s" : " ", deformed ? ", deformed" : "          ", times[0] * 1000 / options.skeletons,
+					   times[1] * 1000 / options.skeletons);
+			}
+			delete skeletonData;
+		}
+		delete atlas;
+		if (!identical) {
+			fprintf(stderr, "The vectorized and scalar world vertices differ\n");
+			return false;
+		}
+		return true;
+	}
+
+	/* What a SkeletonAnimation made from a prototype owns besides its node. */
+	struct Spawned {
+		Skeleton *skeleton;
+		AnimationState *state;
+		RenderCommandBuilder *builder;
+	};
+
+	/* Spawns and despawns per millisecond: creating what SkeletonAnimation::createWithPrototype() creates and deleting it,
+	 * versus reusing it as SkeletonAnimationPool does, resetting it with Skeleton::copyFrom() and clearing the tracks. The
+	 * nodes themselves need axmol and are left out. */
+	void measurePool(Skeleton &prototype, AnimationStateData &stateData, Animation *animation, int count, double &created,
+					 double &pooled) {
+		Vector<Spawned> spawned, free;
+		spawned.ensureCapacity(count);
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < count; i++) {
+			Spawned actor = {prototype.copy(), new (__FILE__, __LINE__) AnimationState(&stateData),
+							 new (__FILE__, __LINE__) RenderCommandBuilder()};
+			actor.state->setAnimation(0, animation, true);
+			spawned.add(actor);
+		}
+		for (size_t i = 0; i < spawned.size(); i++) {
+			delete spawned[i].skeleton;
+			delete spawned[i].state;
+			delete spawned[i].builder;
+		}
+		created = count / elapsedMs(start);
+
+		// Filled as SkeletonAnimationPool::reserve() would, outside the measurement.
+		for (int i = 0; i < count; i++) {
+			Spawned actor = {prototype.copy(), new (__FILE__, __LINE__) AnimationState(&stateData),
+							 new (__FILE__, __LINE__) RenderCommandBuilder()};
+			free.add(actor);
+		}
+		spawned.clear();
+		start = Clock::now();
+		for (int i = 0; i < count; i++) {
+			Spawned actor = free[free.size() - 1];
+			free.removeAt(free.size() - 1);
+			actor.skeleton->copyFrom(prototype);
+			actor.state->clearTracks();
+			actor.state->setAnimation(0, animation, true);
+			spawned.add(actor);
+		}
+		for (size_t i = spawned.size(); i > 0; i--)
+			free.add(spawned[i - 1]);
+		pooled = count / elapsedMs(start);
+		for (size_t i = 0; i < free.size(); i++) {
+			delete free[i].skeleton;
+			delete free[i].state;
+			delete free[i].builder;
+		}
+	}
+
+	/* Creating, updating and destroying a crowd of skeletons. Skeleton constructs its bones, constraints and slots in one
+	 * block, bones in data order with each constraint type after them. Also reports how often the update cache steps to a
+	 * later object in that block, which is how close data order comes to update order, and spawns from a pool. */
+	bool runSpawn(const Options &options) {
+		Atlas *atlas = SkeletonGenerator::createAtlas(1, 16);
+		printf("spawn: %d skeletons\n", options.crowd);
+		static const BuildShape shapes[] = {
+				{"no ik", 1, {40, 40, 0, 0, 0, 0, 0}},
+				{"8 ik", 1, {40, 40, 0, 0, 0, 8, 0}},
+		};
+		for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+			const BuildShape &shape = shapes[s];
+			SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape.shape);
+			if (!skeletonData) {
+				delete atlas;
+				return false;
+			}
+			Skeleton prototype(skeletonData);
+			AnimationStateData stateData(skeletonData);
+			Animation *animation = skeletonData->findAnimation("idle");
+			// The first round warms up the allocator.
+			for (int round = 0; round < 2; round++) {
+				Vector<Skeleton *> skeletons;
+				skeletons.ensureCapacity(options.crowd);
+				Clock::time_point start = Clock::now();
+				for (int i = 0; i < options.crowd; i++)
+					skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+				double createMs = elapsedMs(start);
+
+				start = Clock::now();
+				for (int frame = 0; frame < options.frames; frame++)
+					for (size_t i = 0; i < skeletons.size(); i++)
+						skeletons[i]->updateWorldTransform();
+				double updateMs = elapsedMs(start);
+
+				Vector<Updatable *> &updateCache = skeletons[0]->getUpdateCacheList();
+				size_t forward = 0, steps = updateCache.size() - 1;
+				for (size_t i = 1; i <= steps; i++)
+					if ((char *) updateCache[i] > (char *) updateCache[i - 1]) forward++;
+
+				start = Clock::now();
+				for (size_t i = 0; i < skeletons.size(); i++)
+					delete skeletons[i];
+				double destroyMs = elapsedMs(start);
+
+				double created, pooled;
+				measurePool(prototype, stateData, animation, options.crowd, created, pooled);
+
+				if (round == 0) continue;
+				printf("  %-5s bones %d: %6.1f created per ms, %5.2f us per update, %6.1f destroyed per ms, %zu of %zu update "
+					   "steps forward\n",
+					   shape.name, shape.shape.bones, options.crowd / createMs,
+					   updateMs * 1000 / (options.frames * options.crowd), options.crowd / destroyMs, forward, steps);
+				printf("        spawned and despawned per ms: %6.1f created from the prototype, %6.1f from a pool\n", created,
+					   pooled);
+			}
+			delete skeletonData;
+		}
+		delete atlas;
+		return true;
+	}
+
+	/* Skeleton::setSkin() reusing what it keeps in the skin, versus finding the attachments again as it must after
+	 * Skin::markChanged(). Also checks that changing a slot's setup attachment name is seen by the next setSkin(). */
+	bool runSkins(const Options &options) {
+		Atlas *atlas = SkeletonGenerator::createAtlas(2, 16);
+		SkeletonGenerator::Shape shape = {30, 100, 4, 0, 0, 0, 4};
+		SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape);
+		if (!skeletonData) {
+			delete atlas;
+			return false;
+		}
+		Vector<Skin *> &skins = skeletonData->getSkins();
+		Vector<Skeleton *> skeletons;
+		for (int i = 0; i < options.skeletons; i++)
+			skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+
+		double kept = 0, changed = 0;
+		for (int pass = 0; pass < 2; pass++) {
+			Clock::time_point start = Clock::now();
+			for (int frame = 0; frame < options.frames; frame++) {
+				for (size_t i = 0; i < skeletons.size(); i++) {
+					// Cycle through the skins other than the default.
+					Skin *skin = skins[1 + (frame + i) % (skins.size() - 1)];
+					if (pass) skin->markChanged();
+					skeletons[i]->setSkin(skin);
+					skeletons[i]->updateCache();
+				}
+			}
+			(pass ? changed : kept) = elapsedMs(start);
+		}
+		double swaps = (double) options.frames * options.skeletons;
+		printf("skins: %d skeletons, %d slots, %d skins, swapped every frame\n", options.skeletons, shape.slots, shape.skins);
+		printf("  setSkin() with what the skin keeps: %8.2f us per swap\n", kept * 1000 / swaps);
+		printf("  setSkin() after Skin::markChanged(): %7.2f us per swap\n", changed * 1000 / swaps);
+
+		// A new skeleton setting a skin gets the skin's attachment for the setup attachment name, as changed now.
+		bool valid = true;
+		SlotData &slotData = *skeletonData->getSlots()[0];
+		String name = slotData.getAttachmentName();
+		for (int pass = 0; pass < 2; pass++) {
+			slotData.setAttachmentName(pass ? name : String(""));
+			Skeleton skeleton(skeletonData);
+			skeleton.setSkin(skins[1]);
+			Attachment *expected = pass ? skins[1]->getAttachment(0, name) : NULL;
+			if (skeleton.getSlots()[0]->getAttachment() != expected) valid = false;
+		}
+
+		for (size_t i = 0; i < skeletons.size(); i++)
+			delete skeletons[i];
+		delete skeletonData;
+		delete atlas;
+		if (!valid) {
+			fprintf(stderr, "Skeleton::setSkin() used a setup attachment name that was changed\n");
+			return false;
+		}
+		return true;
+	}
+
+	bool runBroadphase(const Options &options) {
+		Atlas *atlas = SkeletonGenerator::createAtlas(1, 8);
+		SkeletonGenerator::Shape shape = {30, 30, 0, 3};
+		SkeletonData *skeletonData = SkeletonGenerator::createSkeletonData(*atlas, shape);
+		if (!skeletonData) {
+			delete atlas;
+			return false;
+		}
+		Animation *animation = skeletonData->findAnimation("idle");
+		float duration = animation->getDuration();
+
+		// About one skeleton per 150x150 square, so a point is inside a few bounding boxes at most.
+		float worldSize = sqrtf((float) options.actors) * 150;
+		SkeletonBroadphase broadphase;
+		Vector<Actor *> actors;
+		for (int i = 0; i < options.actors; i++) {
+			Actor *actor = new Actor();
+			actor->skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+			actor->skeleton->setX(randomFloat(0, worldSize));
+			actor->skeleton->setY(randomFloat(0, worldSize));
+			actor->time = randomFloat(0, duration);
+			actor->proxy = broadphase.add(actor->skeleton, actor);
+			actors.add(actor);
+		}
+
+		Vector<float> points;
+		Vector<int> found;
+		double bruteMs = 0, updateMs = 0, queryMs = 0;
+		size_t bruteHits = 0, indexHits = 0;
+		for (int frame = 0; frame < options.frames; frame++) {
+			for (size_t i = 0; i < actors.size(); i++) {
+				Skeleton &skeleton = *actors[i]->skeleton;
+				actors[i]->time += 1 / 60.f;
+				animation->apply(skeleton, 0, actors[i]->time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.setX(skeleton.getX() + randomFloat(-2, 2));
+				skeleton.setY(skeleton.getY() + randomFloat(-2, 2));
+				skeleton.updateWorldTransform();
+			}
+			// Half the points near a skeleton, so queries find something.
+			points.clear();
+			for (int i = 0; i < options.queries; i++) {
+				if (i & 1) {
+					Skeleton &skeleton = *actors[(size_t) randomFloat(0, (float) actors.size() - 1)]->skeleton;
+					points.add(skeleton.getX() + randomFloat(-60, 60));
+					points.add(skeleton.getY() + randomFloat(-60, 60));
+				} else {
+					points.add(randomFloat(0, worldSize));
+					points.add(randomFloat(0, worldSize));
+				}
+			}
+
+			Clock::time_point start = Clock::now();
+			for (size_t i = 0; i < actors.size(); i++)
+				actors[i]->bounds.update(*actors[i]->skeleton, true);
+			for (size_t i = 0; i < points.size(); i += 2) {
+				float x = points[i], y = points[i + 1];
+				for (size_t ii = 0; ii < actors.size(); ii++) {
+					SkeletonBounds &bounds = actors[ii]->bounds;
+					if (bounds.aabbcontainsPoint(x, y) && bounds.containsPoint(x, y)) bruteHits++;
+				}
+			}
+			bruteMs += elapsedMs(start);
+
+			start = Clock::now();
+			broadphase.updateAll();
+			updateMs += elapsedMs(start);
+			start = Clock::now();
+			for (size_t i = 0; i < points.size(); i += 2)
+				indexHits += broadphase.containsPoint(points[i], points[i + 1], found);
+			queryMs += elapsedMs(start);
+		}
+
+		printf("broadphase: %d skeletons, %d bounding boxes each, %d queries per frame, tree height %d\n", options.actors,
+			   (shape.bones + shape.boundingBoxEvery - 1) / shape.boundingBoxEvery, options.queries, broadphase.getHeight());
+		printf("  SkeletonBounds per skeleton:  %8.3f ms per frame, %zu hits\n", bruteMs / options.frames, bruteHits);
+		printf("  SkeletonBroadphase:           %8.3f ms per frame (update %.3f ms, queries %.3f ms), %zu hits\n",
+			   (updateMs + queryMs) / options.frames, updateMs / options.frames, queryMs / options.frames, indexHits);
+
+		for (size_t i = 0; i < actors.size(); i++) {
+			broadphase.remove(actors[i]->proxy);
+			delete actors[i]->skeleton;
+			delete actors[i];
+		}
+		delete skeletonData;
+		delete atlas;
+		if (bruteHits != indexHits) {
+			fprintf(stderr, "SkeletonBroadphase found %zu hits, expected %zu\n", indexHits, bruteHits);
+			return false;
+		}
+		return true;
+	}
+
+	struct Benchmark {
+		const char *name;
+		const char *description;
+		bool (*run)(const Options &options);
+	};
+
+	const Benchmark benchmarks[] = {
+			{"build", "RenderCommandBuilder::build() on skeletons of three sizes.", runBuild},
+			{"drawcalls", "Two color commands for a crowd, on their own and in a SkeletonBatchGroup.", runDrawCalls},
+			{"deform", "DeformTimeline memory and apply time, as loaded versus compacted.", runDeform},
+			{"rig", "A partially animated large rig, every slot versus changed slots only.", runRig},
+			{"skinning", "Weighted mesh vertices, vectorized versus scalar, checked bit identical.", runSkinning},
+			{"spawn", "Skeletons created, updated and destroyed, and their update order in memory.", runSpawn},
+			{"skins", "Skeleton::setSkin() swaps, kept in the skin versus computed again.", runSkins},
+			{"broadphase", "Point queries against many skeletons, SkeletonBounds versus SkeletonBroadphase.", runBroadphase},
+	};
+	const size_t benchmarkCount = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+	void printUsage() {
+		printf("Usage: spine-benchmark [options] [benchmark...]\n"
+			   "\n"
+			   "Measures the runtime on generated skeletons, without files or a renderer. Runs every benchmark unless some\n"
+			   "are named.\n"
+			   "\n");
+		for (size_t i = 0; i < benchmarkCount; i++)
+			printf("  %-12s %s\n", benchmarks[i].name, benchmarks[i].description);
+		printf("\n"
+			   "Options:\n"
+			   "  --skeletons <count> Skeletons of each size built per frame in the build benchmark, posed in the deform and\n"
+			   "                      skinning benchmarks and swapping skins in the skins benchmark. Default 100.\n"
+			   "  --crowd <count>     Skeletons drawn in the drawcalls benchmark and spawned in the spawn benchmark. Default 1000.\n"
+			   "  --actors <count>    Skeletons in the broadphase benchmark. Default 2000.\n"
+			   "  --queries <count>   Point queries per frame in the broadphase benchmark. Default 2000.\n"
+			   "  --frames <count>    Frames posed and measured. Default 10.\n");
+	}
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	bool selected[benchmarkCount] = {};
+	bool all = true;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "--help")) {
+			printUsage();
+			return 0;
+		} else if (!strcmp(arg, "--actors") && hasValue)
+			options.actors = atoi(argv[++i]);
+		else if (!strcmp(arg, "--queries") && hasValue)
+			options.queries = atoi(argv[++i]);
+		else if (!strcmp(arg, "--frames") && hasValue)
+			options.frames = atoi(argv[++i]);
+		else if (!strcmp(arg, "--skeletons") && hasValue)
+			options.skeletons = atoi(argv[++i]);
+		else if (!strcmp(arg, "--crowd") && hasValue)
+			options.crowd = atoi(argv[++i]);
+		else {
+			size_t b = 0;
+			while (b < benchmarkCount && strcmp(arg, benchmarks[b].name)) b++;
+			if (b == benchmarkCount) {
+				fprintf(stderr, "Unknown argument or missing value: %s\n", arg);
+				return 1;
+			}
+			selected[b] = true;
+			all = false;
+		}
+	}
+	if (options.actors < 1 || options.queries < 0 || options.frames < 1 || options.skeletons < 1 || options.crowd < 1) {
+		printUsage();
+		return 1;
+	}
+
+	int result = 0;
+	for (size_t i = 0; i < benchmarkCount; i++)
+		if ((all || selected[i]) && !benchmarks[i].run(options)) result = 1;
+	return result;
+}
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "SkeletonConverter.h"
+
+#include <spine/SequenceTimeline.h>
+
+using namespace spine;
+
+namespace {
+	bool isAttachmentTimeline(Timeline *timeline, Attachment *&attachment) {
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			attachment = static_cast<DeformTimeline *>(timeline)->getAttachment();
+			return true;
+		}
+		if (timeline->getRTTI().isExactly(SequenceTimeline::rtti)) {
+			attachment = static_cast<SequenceTimeline *>(timeline)->getAttachment();
+			return true;
+		}
+		return false;
+	}
+
+	bool skinContains(Skin *skin, Attachment *attachment) {
+		Skin::AttachmentMap::Entries entries = skin->getAttachments();
+		while (entries.hasNext())
+			if (entries.next()._attachment == attachment) return true;
+		return false;
+	}
+
+	void pose(Skeleton &skeleton, Animation &animation, float time) {
+		skeleton.setToSetupPose();
+		animation.apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+	}
+
+	float colorDifference(Color &a, Color &b) {
+		return MathUtil::max(MathUtil::max(MathUtil::abs(a.r - b.r), MathUtil::abs(a.g - b.g)),
+							 MathUtil::max(MathUtil::abs(a.b - b.b), MathUtil::abs(a.a - b.a)));
+	}
+
+	size_t searchSteps(size_t frameCount) {
+		size_t steps = 1;
+		while (frameCount > 1) {
+			frameCount >>= 1;
+			steps++;
+		}
+		return steps;
+	}
+}
+
+void SkeletonConverter::removeAttachmentTimelines(SkeletonData &skeletonData, Vector<Attachment *> &attachments) {
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0; i < animations.size(); ++i) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size();) {
+			Attachment *attachment;
+			if (isAttachmentTimeline(timelines[ii], attachment) && attachments.contains(attachment)) {
+				delete timelines[ii];
+				timelines.removeAt(ii);
+			} else
+				ii++;
+		}
+	}
+}
+
+size_t SkeletonConverter::stripSkins(SkeletonData &skeletonData, Vector<String> &keepSkins) {
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	Vector<Skin *> keep;
+	for (size_t i = 0; i < skins.size(); ++i)
+		if (skins[i] == skeletonData.getDefaultSkin() || keepSkins.contains(skins[i]->getName())) keep.add(skins[i]);
+
+	// Linked meshes need their parent, which may live in another skin.
+	for (size_t i = 0; i < keep.size(); ++i) {
+		Skin::AttachmentMap::Entries entries = keep[i]->getAttachments();
+		while (entries.hasNext()) {
+			Attachment *attachment = entries.next()._attachment;
+			if (!attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *parent = static_cast<MeshAttachment *>(attachment)->getParentMesh();
+			if (!parent) continue;
+			for (size_t ii = 0; ii < skins.size(); ++ii)
+				if (!keep.contains(skins[ii]) && skinContains(skins[ii], parent)) keep.add(skins[ii]);
+		}
+	}
+
+	Vector<Attachment *> removed;
+	for (size_t i = 0; i < skins.size(); ++i) {
+		if (keep.contains(skins[i])) continue;
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext())
+			removed.add(entries.next()._attachment);
+	}
+	removeAttachmentTimelines(skeletonData, removed);
+
+	size_t count = 0;
+	for (size_t i = 0; i < skins.size();) {
+		if (keep.contains(skins[i])) {
+			i++;
+			continue;
+		}
+		delete skins[i];
+		skins.removeAt(i);
+		count++;
+	}
+	return count;
+}
+
+size_t SkeletonConverter::stripUnusedAttachments(SkeletonData &skeletonData) {
+	size_t slotCount = skeletonData.getSlots().size();
+	Vector<Vector<String> > used;
+	used.setSize(slotCount, Vector<String>());
+	for (size_t i = 0; i < slotCount; ++i) {
+		SlotData *slot = skeletonData.getSlots()[i];
+		if (!slot->getAttachmentName().isEmpty()) used[i].add(slot->getAttachmentName());
+	}
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0; i < animations.size(); ++i) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ++ii) {
+			if (!timelines[ii]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+			AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[ii]);
+			Vector<String> &names = timeline->getAttachmentNames();
+			Vector<String> &slotUsed = used[timeline->getSlotIndex()];
+			for (size_t iii = 0; iii < names.size(); ++iii)
+				if (!names[iii].isEmpty() && !slotUsed.contains(names[iii])) slotUsed.add(names[iii]);
+		}
+	}
+
+	// Parents of used linked meshes are kept even if never shown themselves.
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	Vector<Attachment *> parents;
+	for (size_t i = 0; i < skins.size(); ++i) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (!used[entry._slotIndex].contains(entry._name)) continue;
+			if (!entry._attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *parent = static_cast<MeshAttachment *>(entry._attachment)->getParentMesh();
+			if (parent) parents.add(parent);
+		}
+	}
+
+	Vector<Attachment *> removed;
+	Vector<size_t> removedSkins;
+	Vector<size_t> removedSlots;
+	Vector<String> removedNames;
+	for (size_t i = 0; i < skins.size(); ++i) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (used[entry._slotIndex].contains(entry._name) || parents.contains(entry._attachment)) continue;
+			removed.add(entry._attachment);
+			removedSkins.add(i);
+			removedSlots.add(entry._slotIndex);
+			removedNames.add(entry._name);
+		}
+	}
+	removeAttachmentTimelines(skeletonData, removed);
+	for (size_t i = 0; i < removed.size(); ++i)
+		skins[removedSkins[i]]->removeAttachment(removedSlots[i], removedNames[i]);
+	return removed.size();
+}
+
+size_t SkeletonConverter::sparsifyDeform(SkeletonData &skeletonData, float epsilon) {
+	size_t count = 0;
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0; i < animations.size(); ++i) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ++ii) {
+			if (!timelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *timeline = static_cast<DeformTimeline *>(timelines[ii]);
+			VertexAttachment *attachment = timeline->getAttachment();
+			bool weighted = attachment->getBones().size() > 0;
+			Vector<float> &setupVertices = attachment->getVertices();
+			Vector<Vector<float> > &frames = timeline->getVertices();
+			for (size_t frame = 0; frame < frames.size(); ++frame) {
+				Vector<float> &vertices = frames[frame];
+				for (size_t v = 0; v < vertices.size(); ++v) {
+					float setup = weighted ? 0 : setupVertices[v];
+					if (vertices[v] != setup && MathUtil::abs(vertices[v] - setup) < epsilon) {
+						vertices[v] = setup;
+						count++;
+					}
+				}
+			}
+		}
+	}
+	return count;
+}
+
+void SkeletonConverter::comparePoses(SkeletonData &expected, SkeletonData &actual, float fps, PoseDifference &difference) {
+	difference.poses = 0;
+	difference.position = 0;
+	difference.transform = 0;
+	difference.color = 0;
+	difference.mismatches = 0;
+	if (expected.getBones().size() != actual.getBones().size() || expected.getSlots().size() != actual.getSlots().size()) {
+		difference.mismatches++;
+		return;
+	}
+
+	Skeleton a(&expected), b(&actual);
+	Vector<Bone *> &bonesA = a.getBones(), &bonesB = b.getBones();
+	Vector<Slot *> &slotsA = a.getSlots(), &slotsB = b.getSlots();
+	Vector<Animation *> &animations = expected.getAnimations();
+	for (size_t i = 0; i < animations.size(); ++i) {
+		Animation *animation = animations[i];
+		Animation *other = actual.findAnimation(animation->getName());
+		if (!other) {
+			difference.mismatches++;
+			continue;
+		}
+		float duration = animation->getDuration();
+		size_t samples = (size_t) (duration * fps) + 1;
+		for (size_t sample = 0; sample <= samples; ++sample) {
+			float time = MathUtil::min(sample / fps, duration);
+			pose(a, *animation, time);
+			pose(b, *other, time);
+			difference.poses++;
+
+			for (size_t ii = 0; ii < bonesA.size(); ++ii) {
+				Bone &boneA = *bonesA[ii], &boneB = *bonesB[ii];
+				difference.position = MathUtil::max(difference.position,
+													MathUtil::max(MathUtil::abs(boneA.getWorldX() - boneB.getWorldX()),
+																  MathUtil::abs(boneA.getWorldY() - boneB.getWorldY())));
+				float transform = MathUtil::max(MathUtil::max(MathUtil::abs(boneA.getA() - boneB.getA()),
+															  MathUtil::abs(boneA.getB() - boneB.getB())),
+												MathUtil::max(MathUtil::abs(boneA.getC() - boneB.getC()),
+															  MathUtil::abs(boneA.getD() - boneB.getD())));
+				difference.transform = MathUtil::max(difference.transform, transform);
+			}
+
+			bool mismatch = false;
+			for (size_t ii = 0; ii < slotsA.size(); ++ii) {
+				Slot &slotA = *slotsA[ii], &slotB = *slotsB[ii];
+				float color = colorDifference(slotA.getColor(), slotB.getColor());
+				if (slotA.hasDarkColor()) color = MathUtil::max(color, colorDifference(slotA.getDarkColor(), slotB.getDarkColor()));
+				difference.color = MathUtil::max(difference.color, color);
+				Attachment *attachmentA = slotA.getAttachment(), *attachmentB = slotB.getAttachment();
+				if ((attachmentA == NULL) != (attachmentB == NULL) ||
+					(attachmentA && attachmentA->getName() != attachmentB->getName()))
+					mismatch = true;
+				if (a.getDrawOrder()[ii]->getData().getIndex() != b.getDrawOrder()[ii]->getData().getIndex()) mismatch = true;
+			}
+			if (mismatch) difference.mismatches++;
+		}
+	}
+}
+
+void SkeletonConverter::report(SkeletonData &skeletonData, Vector<AnimationReport> &reports) {
+	size_t slotCount = skeletonData.getSlots().size();
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	reports.setSize(animations.size(), AnimationReport());
+	for (size_t i = 0; i < animations.size(); ++i) {
+		Animation *animation = animations[i];
+		AnimationReport &report = reports[i];
+		report.name = animation->getName();
+		report.duration = animation->getDuration();
+		report.timelines = animation->getTimelines().size();
+		report.keys = 0;
+		report.bytes = 0;
+		report.applyCost = 0;
+		Vector<Timeline *> &timelines = animation->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ++ii) {
+			Timeline *timeline = timelines[ii];
+			size_t frameCount = timeline->getFrameCount();
+			report.keys += frameCount;
+			report.bytes += timeline->getFrames().size() * sizeof(float);
+			size_t values;
+			if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+				DeformTimeline *deform = static_cast<DeformTimeline *>(timeline);
+				values = deform->getVertexCount();
+				report.bytes += deform->getCurves().size() * sizeof(float) + deform->getVerticesMemory();
+			} else if (timeline->getRTTI().instanceOf(CurveTimeline::rtti)) {
+				values = timeline->getFrameEntries() - 1;
+				report.bytes += static_cast<CurveTimeline *>(timeline)->getCurves().size() * sizeof(float);
+			} else if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))
+				values = slotCount;
+			else
+				values = 1;
+			report.applyCost += searchSteps(frameCount) + values;
+		}
+	}
+}
+
+void SkeletonConverter::printReport(FILE *file, Vector<AnimationReport> &before, Vector<AnimationReport> &after) {
+	fprintf(file, "%-24s %8s %9s %15s %19s %15s\n", "animation", "duration", "timelines", "keys", "bytes", "apply cost");
+	for (size_t i = 0; i < after.size(); ++i) {
+		AnimationReport &report = after[i];
+		AnimationReport *original = NULL;
+		for (size_t ii = 0; ii < before.size(); ++ii)
+			if (before[ii].name == report.name) original = &before[ii];
+		if (!original) original = &report;
+		fprintf(file, "%-24s %8.3f %4zu/%-4zu %7zu/%-7zu %9zu/%-9zu %7zu/%-7zu\n", report.name.buffer(), report.duration,
+				original->timelines, report.timelines, original->keys, report.keys, original->bytes, report.bytes,
+				original->applyCost, report.applyCost);
+	}
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef SPINE_SKELETONCONVERTER_H_
+#define SPINE_SKELETONCONVERTER_H_
+
+#include <spine/spine.h>
+#include <cstdio>
+
+namespace spine {
+
+	/* Offline passes run on loaded skeleton data before it is written out again. The passes remove timelines directly from
+	 * the animations, so the data is meant to be written and reloaded rather than used for playback afterwards. */
+	class SkeletonConverter {
+	public:
+		struct AnimationReport {
+			String name;
+			float duration;
+			size_t timelines;
+			size_t keys;
+			size_t bytes;
+			/* Estimated work per apply: binary search steps plus values written, summed over all timelines. */
+			size_t applyCost;
+		};
+
+		/* Removes all skins not in the list. The default skin and skins holding parents of linked meshes in kept skins are
+		 * always kept. Returns the number of skins removed. */
+		static size_t stripSkins(SkeletonData &skeletonData, Vector<String> &keepSkins);
+
+		/* Removes attachments that are neither a slot's setup attachment nor keyed by any attachment timeline, along with
+		 * their deform and sequence timelines. Attachments set from code at runtime are removed too. Returns the number of
+		 * attachments removed. */
+		static size_t stripUnusedAttachments(SkeletonData &skeletonData);
+
+		/* Snaps deform offsets smaller than epsilon to zero, so the binary writer can store shorter ranges per frame. Returns
+		 * the number of values changed. */
+		static size_t sparsifyDeform(SkeletonData &skeletonData, float epsilon);
+
+		struct PoseDifference {
+			size_t poses;
+			/* Largest difference of a bone's world position, in skeleton units. */
+			float position;
+			/* Largest difference of an entry of a bone's world transform matrix. */
+			float transform;
+			/* Largest difference of a slot color channel, light or dark. */
+			float color;
+			/* Poses where a slot showed another attachment or the draw order differed, plus missing animations. */
+			size_t mismatches;
+		};
+
+		/* Applies every animation of expected and the animation of the same name in actual from the setup pose, fps times a
+		 * second and at the end, and compares the bones and slots of the two poses. Bones and slots are matched by index, so
+		 * actual must be expected after the passes above and a round trip through the writer. Vertices are not compared. */
+		static void comparePoses(SkeletonData &expected, SkeletonData &actual, float fps, PoseDifference &difference);
+
+		static void report(SkeletonData &skeletonData, Vector<AnimationReport> &reports);
+
+		static void printReport(FILE *file, Vector<AnimationReport> &before, Vector<AnimationReport> &after);
+
+	private:
+		static void removeAttachmentTimelines(SkeletonData &skeletonData, Vector<Attachment *> &attachments);
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONCONVERTER_H_ */
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "SkeletonConverter.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace spine;
+
+spine::SpineExtension *spine::getDefaultExtension() {
+	return new DefaultSpineExtension();
+}
+
+namespace {
+	/* Creates attachments without texture regions, nothing is rendered by the converter. */
+	class ConverterAttachmentLoader : public AttachmentLoader {
+	public:
+		RegionAttachment *newRegionAttachment(Skin &, const String &name, const String &, Sequence *) override {
+			return new (__FILE__, __LINE__) RegionAttachment(name);
+		}
+
+		MeshAttachment *newMeshAttachment(Skin &, const String &name, const String &, Sequence *) override {
+			return new (__FILE__, __LINE__) MeshAttachment(name);
+		}
+
+		BoundingBoxAttachment *newBoundingBoxAttachment(Skin &, const String &name) override {
+			return new (__FILE__, __LINE__) BoundingBoxAttachment(name);
+		}
+
+		PathAttachment *newPathAttachment(Skin &, const String &name) override {
+			return new (__FILE__, __LINE__) PathAttachment(name);
+		}
+
+		PointAttachment *newPointAttachment(Skin &, const String &name) override {
+			return new (__FILE__, __LINE__) PointAttachment(name);
+		}
+
+		ClippingAttachment *newClippingAttachment(Skin &, const String &name) override {
+			return new (__FILE__, __LINE__) ClippingAttachment(name);
+		}
+
+		void configureAttachment(Attachment *) override {
+		}
+	};
+
+	void printUsage() {
+		printf("Usage: spine-converter [options] <input.json|input.skel> [output.skel]\n"
+			   "\n"
+			   "Loads a skeleton exported by the editor, optionally optimizes it and writes it in the binary format.\n"
+			   "\n"
+			   "Options:\n"
+			   "  --scale <value>           Scale applied when loading. Default 1.\n"
+			   "  --optimize                Remove redundant keys and collapse constant timelines.\n"
+			   "  --tolerance <factor>      Multiplies all key reduction tolerances. Default 1.\n"
+			   "  --remove-setup-pose       Remove timelines that only key the setup pose.\n"
+			   "  --skins <a,b,...>         Keep only the listed skins. The default skin is always kept.\n"
+			   "  --strip-unused            Remove attachments never shown by the setup pose or an animation.\n"
+			   "  --deform-epsilon <value>  Snap deform offsets smaller than the value to zero.\n"
+			   "  --max-bones <count>       Keep at most this many bone influences per mesh vertex.\n"
+			   "  --min-weight <value>      Remove mesh bone influences with a smaller weight.\n"
+			   "  --precision <step>        Round key values and deform offsets to multiples of the step.\n"
+			   "  --strip-nonessential      Omit data only used by the editor.\n"
+			   "  --report                  Print size and estimated apply cost per animation.\n"
+			   "  --verify <max error>      Compare the poses of every animation before and after conversion and fail if a\n"
+			   "                            bone moved more than the value or a slot shows another attachment.\n");
+	}
+
+	bool endsWith(const char *value, const char *suffix) {
+		size_t length = strlen(value), suffixLength = strlen(suffix);
+		return length >= suffixLength && strcmp(value + length - suffixLength, suffix) == 0;
+	}
+
+	void splitNames(const char *names, Vector<String> &result) {
+		const char *start = names;
+		for (const char *c = names;; c++) {
+			if (*c != ',' && *c != '\0') continue;
+			if (c > start) {
+				char *name = SpineExtension::calloc<char>(c - start + 1, __FILE__, __LINE__);
+				memcpy(name, start, c - start);
+				result.add(String(name, true));
+			}
+			if (*c == '\0') break;
+			start = c + 1;
+		}
+	}
+
+	SkeletonData *readSkeletonData(const char *path, float scale, AttachmentLoader &attachmentLoader) {
+		SkeletonData *skeletonData;
+		if (endsWith(path, ".json")) {
+			SkeletonJson json(&attachmentLoader, false);
+			json.setScale(scale);
+			skeletonData = json.readSkeletonDataFile(path);
+			if (!skeletonData) fprintf(stderr, "Error reading %s: %s\n", path, json.getError().buffer());
+		} else {
+			SkeletonBinary binary(&attachmentLoader, false);
+			binary.setScale(scale);
+			skeletonData = binary.readSkeletonDataFile(path);
+			if (!skeletonData) fprintf(stderr, "Error reading %s: %s\n", path, binary.getError().buffer());
+		}
+		return skeletonData;
+	}
+
+	size_t fileSize(const char *path) {
+		FILE *file = fopen(path, "rb");
+		if (!file) return 0;
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fclose(file);
+		return size < 0 ? 0 : (size_t) size;
+	}
+}
+
+int main(int argc, char **argv) {
+	const char *inputPath = NULL, *outputPath = NULL;
+	float scale = 1, tolerance = 1, deformEpsilon = 0, minWeight = 0, verifyError = -1, precision = 0;
+	int maxBones = 0;
+	bool optimize = false, removeSetupPose = false, stripUnused = false, nonessential = true, printReport = false;
+	Vector<String> keepSkins;
+	bool filterSkins = false;
+
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (!strcmp(arg, "-h") || !strcmp(arg, "--help")) {
+			printUsage();
+			return 0;
+		} else if (!strcmp(arg, "--scale") && hasValue)
+			scale = (float) atof(argv[++i]);
+		else if (!strcmp(arg, "--optimize"))
+			optimize = true;
+		else if (!strcmp(arg, "--tolerance") && hasValue)
+			tolerance = (float) atof(argv[++i]);
+		else if (!strcmp(arg, "--remove-setup-pose"))
+			removeSetupPose = true;
+		else if (!strcmp(arg, "--skins") && hasValue) {
+			splitNames(argv[++i], keepSkins);
+			filterSkins = true;
+		} else if (!strcmp(arg, "--strip-unused"))
+			stripUnused = true;
+		else if (!strcmp(arg, "--deform-epsilon") && hasValue)
+			deformEpsilon = (float) atof(argv[++i]);
+		else if (!strcmp(arg, "--max-bones") && hasValue)
+			maxBones = atoi(argv[++i]);
+		else if (!strcmp(arg, "--min-weight") && hasValue)
+			minWeight = (float) atof(argv[++i]);
+		else if (!strcmp(arg, "--precision") && hasValue)
+			precision = (float) atof(argv[++i]);
+		else if (!strcmp(arg, "--strip-nonessential"))
+			nonessential = false;
+		else if (!strcmp(arg, "--report"))
+			printReport = true;
+		else if (!strcmp(arg, "--verify") && hasValue)
+			verifyError = (float) atof(argv[++i]);
+		else if (arg[0] == '-') {
+			fprintf(stderr, "Unknown option or missing value: %s\n", arg);
+			return 1;
+		} else if (!inputPath)
+			inputPath = arg;
+		else if (!outputPath)
+			outputPath = arg;
+		else {
+			fprintf(stderr, "Unexpected argument: %s\n", arg);
+			return 1;
+		}
+	}
+	if (!inputPath || (!outputPath && !printReport)) {
+		printUsage();
+		return 1;
+	}
+
+	ConverterAttachmentLoader attachmentLoader;
+	SkeletonData *skeletonData = readSkeletonData(inputPath, scale, attachmentLoader);
+	if (!skeletonData) return 1;
+	// The passes below change the data in place, so the poses are compared against a second, untouched copy.
+	SkeletonData *original = NULL;
+	if (verifyError >= 0) {
+		original = readSkeletonData(inputPath, scale, attachmentLoader);
+		if (!original) {
+			delete skeletonData;
+			return 1;
+		}
+	}
+
+	Vector<SkeletonConverter::AnimationReport> before;
+	SkeletonConverter::report(*skeletonData, before);
+
+	if (filterSkins) printf("Skins removed: %zu\n", SkeletonConverter::stripSkins(*skeletonData, keepSkins));
+	if (stripUnused) printf("Attachments removed: %zu\n", SkeletonConverter::stripUnusedAttachments(*skeletonData));
+	if (maxBones > 0 || minWeight > 0) {
+		MeshOptimizer optimizer;
+		optimizer.setMaxBones(maxBones);
+		optimizer.setMinWeight(minWeight);
+		optimizer.optimize(*skeletonData);
+		printf("Mesh influences: %zu -> %zu, largest weight removed: %g, largest setup pose error: %g\n",
+			   optimizer.getInfluencesBefore(), optimizer.getInfluencesAfter(), optimizer.getMaxWeightRemoved(),
+			   optimizer.getMaxPruneError());
+	}
+	if (optimize) {
+		AnimationOptimizer optimizer;
+		optimizer.setRotateTolerance(optimizer.getRotateTolerance() * tolerance);
+		optimizer.setTranslateTolerance(optimizer.getTranslateTolerance() * tolerance);
+		optimizer.setScaleTolerance(optimizer.getScaleTolerance() * tolerance);
+		optimizer.setShearTolerance(optimizer.getShearTolerance() * tolerance);
+		optimizer.setColorTolerance(optimizer.getColorTolerance() * tolerance);
+		optimizer.setMixTolerance(optimizer.getMixTolerance() * tolerance);
+		optimizer.setRemoveSetupPoseTimelines(removeSetupPose);
+		optimizer.optimize(*skeletonData);
+		printf("Keys removed: %zu, timelines collapsed: %zu, timelines removed: %zu\n", optimizer.getFramesRemoved(),
+			   optimizer.getTimelinesCollapsed(), optimizer.getTimelinesRemoved());
+		printf("Timelines restored by validation: %zu, largest error: %.2f of the tolerance\n",
+			   optimizer.getTimelinesRestored(), optimizer.getMaxError());
+	}
+	if (deformEpsilon > 0) printf("Deform values snapped: %zu\n", SkeletonConverter::sparsifyDeform(*skeletonData, deformEpsilon));
+
+	int result = 0;
+	SkeletonData *written = NULL;
+	if (outputPath) {
+		SkeletonBinaryWriter writer;
+		writer.setNonessential(nonessential);
+		writer.setPrecision(precision);
+		Vector<unsigned char> output;
+		if (!writer.writeSkeletonData(*skeletonData, output)) {
+			fprintf(stderr, "Error writing %s: %s\n", outputPath, writer.getError().buffer());
+			result = 1;
+		} else {
+			// Read the output back, so a file the runtime can not load is never reported as converted.
+			SkeletonBinary binary(&attachmentLoader, false);
+			written = binary.readSkeletonData(output.buffer(), (int) output.size());
+			FILE *file = written ? fopen(outputPath, "wb") : NULL;
+			if (!written) {
+				fprintf(stderr, "Error verifying output: %s\n", binary.getError().buffer());
+				result = 1;
+			} else if (!file || fwrite(output.buffer(), 1, output.size(), file) != output.size()) {
+				fprintf(stderr, "Error writing %s\n", outputPath);
+				result = 1;
+			} else
+				printf("Wrote %s: %zu bytes, input %zu bytes\n", outputPath, output.size(), fileSize(inputPath));
+			if (file) fclose(file);
+		}
+	}
+
+	if (original) {
+		// Without an output file, the converted data is compared as it is in memory.
+		SkeletonConverter::PoseDifference difference;
+		SkeletonConverter::comparePoses(*original, written ? *written : *skeletonData, 30, difference);
+		printf("Poses compared: %zu, largest bone position error: %g, transform error: %g, color error: %g, mismatches: %zu\n",
+			   difference.poses, difference.position, difference.transform, difference.color, difference.mismatches);
+		if (difference.position > verifyError || difference.mismatches > 0) {
+			fprintf(stderr, "Verification failed\n");
+			result = 1;
+		}
+		delete original;
+	}
+	delete written;
+
+	if (printReport) {
+		Vector<SkeletonConverter::AnimationReport> after;
+		SkeletonConverter::report(*skeletonData, after);
+		SkeletonConverter::printReport(stdout, before, after);
+	}
+
+	delete skeletonData;
+	return result;
+}